@@ -1,41 +1,53 @@
 #pragma once
 
 #include <blaze/MMIO.hpp>
+#include <blaze/SPC700.hpp>
 
-#include <array>
+#include <cstdint>
+#include <vector>
 
 namespace Blaze {
+	/**
+	 * The CPU's side of the APU: the four ports at $2140-$2143 (mirrored up to $217F), backed by an SPC700.
+	 *
+	 * The SPC700 runs in catch-up mode: it only executes (up to the CPU's current time) when the CPU touches one of
+	 * the ports or when a frame ends.
+	 */
 	class APU: public MMIODevice {
 	private:
-		enum class State: Byte {
-			// waiting for $CC on port 0
-			WaitForSignal,
-
-			// read port 1 to determine whether to execute code or begin transferring data
-			Begin,
-
-			// wait for port 0 to read 0
-			TransferLoop,
+		Bus* _bus = nullptr;
+		SPC700 _spc;
 
-			// wait until port 0 reads greater than or equal to the internal counter
-			WaitForCounter,
+		// the CPU cycle counter at the last catch-up
+		uint64_t _lastCPUCycle = 0;
 
-			// execute code
-			Execute,
-		};
-
-		Bus* _bus = nullptr;
-		std::array<Byte, 4> _portsFromCPU;
-		std::array<Byte, 4> _portsToCPU;
-		State _state = State::WaitForSignal;
-		Word _address = 0;
-		Byte _counter = 0;
+		// master clock cycles elapsed since reset
+		uint64_t _masterClock = 0;
 
 	public:
+		// NTSC master clock rate
+		static constexpr uint64_t MASTER_CLOCK_RATE = 21477272;
+
 		Byte registerSize(Address offset, Byte attemptedAccessSize) override;
 		Address read(Address offset, Byte bitSize) override;
 		void write(Address offset, Byte bitSize, Address value) override;
 
 		void reset(Bus* bus) override;
+		std::unique_ptr<MMIODevice> fork(Bus* bus) override;
+
+		// runs the SPC700 until it reaches the CPU's current time
+		void catchUp();
+
+		// lets the SPC700 run to the end of the frame even when the CPU hasn't talked to it
+		void endFrame();
+
+		// moves the audio generated so far into `samples` (appending to it)
+		inline void takeSamples(std::vector<DSP::Sample>& samples) {
+			_spc.dsp.takeSamples(samples);
+		};
+
+		inline SPC700& spc700() {
+			return _spc;
+		};
 	};
 };
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <blaze/AudioRing.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Blaze {
+	/**
+	 * Pulls samples out of an `AudioRing` and resamples them to the output device's rate (with linear interpolation).
+	 *
+	 * The producer and the device never run at exactly the rates they claim to, so the resampling ratio gets nudged
+	 * (by at most `MAX_RATE_ADJUSTMENT`) to keep the ring half full: a fuller ring gets drained a little faster and an
+	 * emptier one a little slower. The adjustment is far too small to hear, but it keeps the ring from ever running dry
+	 * or overflowing.
+	 */
+	class AudioResampler {
+	public:
+		using Sample = AudioRing::Sample;
+
+		static constexpr double MAX_RATE_ADJUSTMENT = 0.005;
+
+	private:
+		AudioRing& _ring;
+		unsigned _inputRate;
+		double _baseStep;
+		double _position = 0;
+		Sample _previous;
+		Sample _current;
+
+		// samples popped from the ring but not consumed yet
+		std::array<Sample, 256> _staged;
+		size_t _stagedCount = 0;
+		size_t _stagedIndex = 0;
+
+		std::atomic<size_t> _underruns {0};
+
+		bool nextInput(Sample& sample);
+
+	public:
+		AudioResampler(AudioRing& ring, unsigned inputRate, unsigned outputRate);
+
+		// not safe to call while `render` might be running
+		void setOutputRate(unsigned outputRate);
+
+		// consumer only: fills `output` with `count` samples at the output rate
+		void render(Sample* output, size_t count);
+
+		// the number of times the ring ran dry in the middle of `render` (the last sample gets repeated instead)
+		inline size_t underrunCount() const {
+			return _underruns.load(std::memory_order_relaxed);
+		};
+	};
+} // namespace Blaze
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <blaze/DSP.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Blaze {
+	/**
+	 * A lock-free single-producer/single-consumer ring of stereo samples.
+	 *
+	 * One thread may push and one (other) thread may pop at the same time; neither side ever blocks or allocates.
+	 */
+	class AudioRing {
+	public:
+		using Sample = DSP::Sample;
+
+	private:
+		std::vector<Sample> _buffer;
+		size_t _mask;
+
+		// these only ever increase (and wrap around); the difference between them is the number of queued samples.
+		// they're kept on separate cache lines so the two threads don't fight over them.
+		alignas(64) std::atomic<size_t> _readIndex {0};
+		alignas(64) std::atomic<size_t> _writeIndex {0};
+
+	public:
+		// the capacity gets rounded up to a power of 2
+		explicit AudioRing(size_t capacity);
+
+		inline size_t capacity() const {
+			return _buffer.size();
+		};
+
+		// the number of queued samples (only a snapshot if called while the other side is active)
+		size_t size() const;
+
+		// producer only: queues up as many of the samples as fit, returning how many did
+		size_t push(const Sample* samples, size_t count);
+
+		// consumer only: dequeues up to `count` samples, returning how many there were
+		size_t pop(Sample* samples, size_t count);
+	};
+} // namespace Blaze
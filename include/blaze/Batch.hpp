@@ -0,0 +1,39 @@
+#pragma once
+
+#include <blaze/Bus.hpp>
+#include <blaze/Scheduler.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Blaze {
+	/**
+	 * Runs many copies of one machine side by side, one instruction per machine per step.
+	 *
+	 * All machines start out as copies of a common snapshot, sharing its ROM image and RAM pages
+	 * until they write to them. Each machine has its own beam position and takes its own interrupts, the same way
+	 * the GUI runs a single machine, so their inputs (`setButtons`) are all that's needed to make them diverge.
+	 *
+	 * Every machine still runs the regular (scalar) CPU; what this saves is memory and setup time, not execution time.
+	 */
+	class Batch {
+		std::vector<std::unique_ptr<Bus>> _machines;
+		std::vector<Scheduler> _schedulers;
+
+	public:
+		Batch(const Bus& snapshot, size_t count);
+
+		size_t size() const;
+		Bus& operator[](size_t index);
+		const Bus& operator[](size_t index) const;
+
+		Scheduler& scheduler(size_t index);
+
+		// the buttons held on `port` of machine `index` (a combination of `Joypads::Buttons`)
+		void setButtons(size_t index, size_t port, Word buttons);
+
+		// takes pending interrupts and executes a single instruction on every machine that isn't stopped or waiting
+		// for an interrupt, then moves each machine's beam along by however long that took
+		void step();
+	};
+} // namespace Blaze
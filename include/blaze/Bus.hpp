@@ -7,21 +7,15 @@
 #include <blaze/DMA.hpp>
 #include <blaze/SRAM.hpp>
 #include <blaze/MulDiv.hpp>
+#include <blaze/InterruptController.hpp>
+#include <blaze/Joypads.hpp>
+
+#include <array>
+#include <memory>
 
 namespace Blaze
 {
-	struct BusInterface {
-		~BusInterface() = default;
-
-		virtual void write(Address addr, Byte data) = 0; 	// write8
-		virtual void write(Address addr, Word data) = 0; 	// write16
-		virtual void write(Address addr, Address data) = 0; // write 24
-		virtual Byte read8(Address addr) = 0;
-		virtual Word read16(Address addr) = 0;
-		virtual Address read24(Address addr) = 0;
-	};
-
-	struct Bus: public BusInterface
+	struct Bus
 	{
 		//=== Devices connected to the bus ===
 		CPU cpu;
@@ -30,33 +24,249 @@ namespace Blaze
 		DMA dma;
 		SRAM sram;
 		MulDiv mulDiv;
+		InterruptController interrupts;
+		Joypads joypads;
 
 		//=== Devices connected to the bus but not owned by the bus ===
 		//
 		// these devices are typically devices that require GUI integration (e.g. graphics, controllers, audio, etc.).
 		// we simply keep pointers to these devices (so we can access them) but we do not own them.
+		//
+		// `updatePageTable` has to be called after connecting or disconnecting one of these.
 		MMIODevice* ppu = nullptr;
 		MMIODevice* apu = nullptr;
 
-		//=== Bus access hooks ===
-		std::function<void(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting)> invalidAccess = nullptr;
+		//=== Page table ===
+		//
+		// the 24-bit address space is split into 4 KiB pages. pages that map linearly onto a memory device
+		// (RAM, ROM, or SRAM) are resolved once, here, down to the memory itself; everything else
+		// (e.g. MMIO registers) is resolved on each access.
+		static constexpr Address PAGE_SHIFT = 12;
+		static constexpr Address PAGE_MASK = (1 << PAGE_SHIFT) - 1;
+		static constexpr Address PAGE_COUNT = 1 << (24 - PAGE_SHIFT);
+
+		//=== Access speeds ===
+		//
+		// how many master clock cycles a single byte access takes, depending on the region being accessed
+		struct AccessSpeed {
+			enum IgnoreMe: Byte {
+				Fast = 6, // MMIO (other than the joypad serial registers), and ROM in banks $80 and up with FastROM enabled
+				Slow = 8, // RAM, SRAM, and ROM (everywhere else)
+				ExtraSlow = 12, // the joypad serial registers ($4000 through $41FF)
+			};
+		};
+
+		// MEMSEL ($420D); bit 0 enables FastROM
+		static constexpr Address MEMSEL = 0x0d; // offset from $4200
+		static constexpr Byte MEMSEL_FASTROM = 1 << 0;
+
+		// the bus reports to the same instrumentation policy as the CPU (see `Instrumentation.hpp`)
+		using Instrumentation = CPU::Instrumentation;
 
 		//=== Constructor & Destructor ===
 		Bus();
 
 		//=== Bus Functionality ===
-		void write(Address addr, Byte data) override;
-		void write(Address addr, Word data) override;
-		void write(Address addr, Address data) override;
-		Byte read8(Address addr) override;
-		Word read16(Address addr) override;
-		Address read24(Address addr) override;
+		//
+		// these are what the CPU calls (see `BasicCPU`), so the common case (a byte in RAM, ROM, or SRAM) is handled right here,
+		// without going through the memory device
+		inline void write(Address addr, Byte data) {
+			const auto& mapping = _pageTable[(addr & 0xffffff) >> PAGE_SHIFT];
+
+			if (writeMemory(mapping, addr, data)) {
+				cpu.cycleCounter += mapping.speed;
+				return;
+			}
+
+			if (mapping.device != nullptr) {
+				cpu.cycleCounter += mapping.speed;
+				mapping.device->write(mapping.offset + (addr & PAGE_MASK), 8, data);
+				return;
+			}
+
+			cpu.cycleCounter += accessSpeed(addr);
+			write(addr, 8, data);
+		};
+
+		void write(Address addr, Word data);
+		void write(Address addr, Address data);
+
+		inline Byte read8(Address addr) {
+			const auto& mapping = _pageTable[(addr & 0xffffff) >> PAGE_SHIFT];
+			Byte value;
+
+			if (readMemory(mapping, addr, value)) {
+				cpu.cycleCounter += mapping.speed;
+				return value;
+			}
+
+			if (mapping.device != nullptr) {
+				cpu.cycleCounter += mapping.speed;
+				return mapping.device->read(mapping.offset + (addr & PAGE_MASK), 8);
+			}
+
+			cpu.cycleCounter += accessSpeed(addr);
+			return read(addr, 8);
+		};
+
+		Word read16(Address addr);
+		Address read24(Address addr);
 
 		void reset();
 
+		/**
+		 * Reads a byte without any side effects (and without counting any cycles).
+		 *
+		 * This only works for addresses that map onto memory (RAM, ROM, or SRAM); for everything else
+		 * (e.g. MMIO registers, where reading could change something), this returns `false` instead.
+		 */
+		bool peek8(Address address, Byte& value);
+
+		/**
+		 * Makes this bus a copy of the machine state in `other`.
+		 *
+		 * The ROM image and all RAM pages are shared with `other` (RAM pages are copied on first write),
+		 * so this is cheap enough to do for a large number of machines. Devices that are not owned by the
+		 * bus (e.g. the PPU and APU) are not copied.
+		 */
+		void copyStateFrom(const Bus& other);
+
+		/**
+		 * Creates a new machine that starts out with this machine's state.
+		 *
+		 * The child shares RAM, SRAM, VRAM and ROM pages with this machine; a page is only copied
+		 * when one of the two machines writes to it. The child owns forks of the PPU and APU (if they can be forked).
+		 */
+		std::unique_ptr<Bus> fork();
+
+		// rebuilds the page table and the register tables. this needs to be called whenever the memory map changes
+		// (e.g. when a ROM is loaded).
+		void updatePageTable();
+
+		// how many master clock cycles it takes the CPU to access the byte at `address`
+		inline Byte accessSpeed(Address address) const {
+			const auto& mapping = _pageTable[(address & 0xffffff) >> PAGE_SHIFT];
+
+			// the only page with more than one speed in it is the one with the joypad serial registers
+			if (mapping.mixedSpeed && (address & 0xffff) < JOYPAD_SERIAL_END) {
+				return AccessSpeed::ExtraSlow;
+			}
+
+			return mapping.speed;
+		};
+
+		// the same, for an access of `byteCount` bytes (which wraps around within the bank, just like the access itself)
+		inline Byte accessSpeed(Address address, Byte byteCount) const {
+			Byte speed = 0;
+
+			for (Byte i = 0; i < byteCount; ++i) {
+				speed += accessSpeed(addressInBank(address, i));
+			}
+
+			return speed;
+		};
+
+		// the address `offset` bytes after `address`, wrapping around within its bank
+		static constexpr Address addressInBank(Address address, Address offset) {
+			return (address & 0xff0000) | ((address + offset) & 0xffff);
+		};
+
+		inline bool fastROM() const {
+			return _fastROM;
+		};
+
 	private:
+		struct PageMapping {
+			// `nullptr` if this page can't be resolved ahead of time
+			MMIODevice* device = nullptr;
+			// the device offset for the first address in this page
+			Address offset = 0;
+			// for ROM pages: the page's bytes, which are read directly rather than through `device`
+			const Byte* data = nullptr;
+			// for RAM and SRAM pages: the memory that `offset` is in, which is read and written directly rather than
+			// through `device`. writes still go through `PagedMemory::write` (so shared pages are copied first)
+			// and get marked in `dirty`, just like the device does it.
+			PagedMemory<Byte, MemRam::PAGE_SIZE>* memory = nullptr;
+			DirtyBitmap* dirty = nullptr;
+			// master clock cycles per byte accessed in this page
+			Byte speed = AccessSpeed::Slow;
+			// whether part of this page is the joypad serial registers (which are slower than the rest of the page)
+			bool mixedSpeed = false;
+		};
+
+		// MEMSEL ($420D) is write-only, and all it does is change the access speed of part of the page table
+		struct MemorySelect: public MMIODevice {
+			Address read(Address offset, Byte bitSize) override;
+			void write(Address offset, Byte bitSize, Address value) override;
+			void reset(Bus* bus) override;
+
+		private:
+			Bus* _bus = nullptr;
+		};
+
+		struct RegisterMapping {
+			// `nullptr` if there's no register at this address
+			MMIODevice* device = nullptr;
+			Address offset = 0;
+		};
+
+		// a byte in a page that maps directly onto memory (see `PageMapping`); these return `false` for any other page
+		static inline bool readMemory(const PageMapping& mapping, Address address, Byte& value) {
+			if (mapping.data != nullptr) {
+				value = mapping.data[address & PAGE_MASK];
+				return true;
+			}
+
+			if (mapping.memory != nullptr) {
+				value = mapping.memory->read(mapping.offset + (address & PAGE_MASK));
+				return true;
+			}
+
+			return false;
+		};
+
+		static inline bool writeMemory(const PageMapping& mapping, Address address, Byte value) {
+			if (mapping.memory == nullptr) {
+				return false;
+			}
+
+			auto offset = mapping.offset + (address & PAGE_MASK);
+
+			mapping.memory->write(offset, value);
+			mapping.dirty->mark(offset);
+			return true;
+		};
+
+		static constexpr Word JOYPAD_SERIAL_END = 0x4200;
+
+		static constexpr Word B_BUS_REGISTERS_START = 0x2100;
+		static constexpr Word CPU_REGISTERS_START = 0x4200;
+
+		std::array<PageMapping, PAGE_COUNT> _pageTable;
+
+		// all MMIO registers are in two regions of banks $00-$3F (and their mirrors in $80-$BF): the B bus registers
+		// ($2100 through $21FF; i.e. the PPU and the APU) and the CPU's own registers ($4200 through $43FF).
+		// every address in these regions gets its device and register offset looked up ahead of time, when the page table is built.
+		std::array<RegisterMapping, 0x100> _bBusRegisters;
+		std::array<RegisterMapping, 0x200> _cpuRegisters;
+		bool _fastROM = false;
+		MemorySelect _memorySelect;
+
+		std::unique_ptr<MMIODevice> _ownedPPU;
+		std::unique_ptr<MMIODevice> _ownedAPU;
+
+		bool mapAddress(Address address, MMIODevice*& outDevice, Address& outOffset);
+		bool mapRegister(Address address, MMIODevice*& outDevice, Address& outOffset) const;
+		void updateRegisterTables();
+		void mapMemory(PageMapping& mapping);
 		Address read(Address address, Byte bitSize);
 		void write(Address address, Byte bitSize, Address data);
 		void findDeviceAndOffset(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting, MMIODevice*& outDevice, Address& outOffset);
+
+		Byte pageSpeed(Address page) const;
+		void setFastROM(bool fastROM);
 	};
+
+	// instantiated in `src/core/CPU.cpp`
+	extern template struct BasicCPU<Bus>;
 }
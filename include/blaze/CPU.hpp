@@ -2,6 +2,7 @@
 
 #include <blaze/MemTypes.hpp>
 #include <blaze/MemRam.hpp>
+#include <blaze/Instrumentation.hpp>
 #include <limits>
 #include <array>
 #include <unordered_map>
@@ -13,12 +14,14 @@ namespace Blaze {
 	using ClockTicks = uint32_t;
 	using Cycles = uint32_t;
 
-	// Avoid circular inclusions by declaring BusInterface and Bus
-	struct BusInterface;
+	// Avoid circular inclusions by declaring Bus
 	struct Bus;
 
-	struct CPU {
-		// TODO: Link to the system bus
+	/**
+	 * Everything about the 65C816 that doesn't depend on the bus it's connected to: the instruction set, the decoder,
+	 * and the register types. `BasicCPU` builds on this, so all of it is also available as e.g. `CPU::Opcode`.
+	 */
+	struct CPUBase {
 
 		//
 		// The various addressing modes support by the 65C816.
@@ -571,6 +574,25 @@ namespace Blaze {
 			Word sp;
 		};
 
+		// internal operation cycles (the ones that don't access the bus) always take 6 master clock cycles.
+		// bus accesses take 6, 8, or 12 depending on the region being accessed; the bus adds those itself.
+		static constexpr uint64_t MASTER_CLOCKS_PER_IO_CYCLE = 6;
+
+		// decodes the current instruction based on the given opcode, returning the decoded instruction information
+		static Instruction decodeInstruction(Byte inst0, bool memoryAndAccumulatorAre8Bit, bool indexRegistersAre8Bit);
+		static std::vector<DisassembledInstruction> disassemble(Bus& bus, Address address, size_t instructionCount, bool memoryAndAccumulatorAre8BitOnStart, bool indexRegistersAre8BitOnStart, bool usingEmulationModeOnStart, bool carryOnStart);
+	};
+
+	/**
+	 * The 65C816 itself, connected to a bus of type `BusType`.
+	 *
+	 * The CPU calls straight into its bus (`read8`, `read16`, `read24`, and `write`) without any virtual calls in between,
+	 * so the bus' fast paths get inlined into every instruction. The machine uses `CPU` (i.e. `BasicCPU<Bus>`), while the tests
+	 * connect it to a mock bus instead. The member functions are defined in `CPUImpl.hpp`, which only has to be included
+	 * where a `BasicCPU` is instantiated.
+	 */
+	template<typename BusType>
+	struct BasicCPU: public CPUBase {
 		mutable std::recursive_mutex stateMutex;
 
 		// this is not essential for CPU functionality; this is just used for debugging.
@@ -594,10 +616,13 @@ namespace Blaze {
 		Address executingPC = 0;
 
 		// System Bus
-		BusInterface *bus = nullptr;
+		BusType* bus = nullptr;
 
-		std::function<void(char)> putCharacterHook = nullptr;
+		// the hooks for debuggers, tracers, and profilers (see `Instrumentation.hpp`); these compile to nothing in builds without instrumentation
+		using Instrumentation = Blaze::Instrumentation::Active;
+		Instrumentation instrumentation;
 
+		// how many master clock cycles the CPU has spent so far
 		uint64_t cycleCounter = 0;
 
 		Byte load8(Address address);
@@ -623,10 +648,6 @@ namespace Blaze {
 		// a memory operand, you should use `decodeAddress` + `load16` instead.
 		Word loadOperand(AddressingMode addressingMode, bool use8BitOperand);
 
-		// decodes the current instruction based on the given opcode, returning the decoded instruction information
-		static Instruction decodeInstruction(Byte inst0, bool memoryAndAccumulatorAre8Bit, bool indexRegistersAre8Bit);
-		static std::vector<DisassembledInstruction> disassemble(Bus& bus, Address address, size_t instructionCount, bool memoryAndAccumulatorAre8BitOnStart, bool indexRegistersAre8BitOnStart, bool usingEmulationModeOnStart, bool carryOnStart);
-
 		// executes the current (pre-decoded) instruction with the given information
 		Cycles executeInstruction(const Instruction& info);
 
@@ -719,14 +740,17 @@ namespace Blaze {
 
 		Cycles executeBRA(ConditionCode condition, bool passConditionIfBitSet);
 
-		CPU():
+		BasicCPU():
 			A(P, flags::m),
 			X(P, flags::x),
 			Y(P, flags::x)
 			{};
 
-		void reset(BusInterface* theBus);      		// Reset CPU internal state
+		void reset(BusType* theBus);      		// Reset CPU internal state
 		void execute(); 		// Execute the current instruction
+
+		// copies the complete register and execution state of another CPU (but not its bus or hooks)
+		void copyStateFrom(const BasicCPU& other);
 		void clock();                    		// CPU driver
 		Byte read(Address addr);				// Read from the Bus
 		void write(Address addr, Byte data);	// Write to the Bus
@@ -764,4 +788,6 @@ namespace Blaze {
 			return e != 0;
 		};
 	};
+
+	using CPU = BasicCPU<Bus>;
 } // namespace Blaze
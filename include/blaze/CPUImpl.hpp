@@ -0,0 +1,1593 @@
+#pragma once
+
+// the member function definitions for `BasicCPU`.
+//
+// only include this where a `BasicCPU` gets instantiated: `src/core/CPU.cpp` for the machine's `CPU`, and the tests for their mock bus.
+// everything else just includes `CPU.hpp` (the machine's `CPU` is explicitly instantiated once, in `src/core/CPU.cpp`).
+
+#include <blaze/CPU.hpp>
+#include <blaze/util.hpp>
+#include <blaze/debug.hpp>
+#include <cassert>
+
+#ifndef BLAZE_PRINT_SUBROUTINES
+	#define BLAZE_PRINT_SUBROUTINES 0
+#endif
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::reset(BusType* theBus) {
+	std::unique_lock lock(stateMutex);
+
+	bus = theBus;
+
+	if (theBus != nullptr) {
+		PC = load16(ExceptionVectorAddress::EmulatedRESET); // need to load w/contents of reset vector
+	}
+	DBR = PBR = 0x00;
+	DR = 0;
+	A.reset();
+	X.reset();
+	Y.reset();
+	SP = 0x0100;
+	P = 0;
+	cycleCounter = 0;
+
+	setFlag(flags::d, false);
+
+	setFlag(flags::m, true);
+	setFlag(flags::x, true);
+	setFlag(flags::i, true);
+	setFlag(flags::c, true);
+
+	// the processor starts out in emulation mode
+	e = 1;
+}
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::irq() {
+	std::unique_lock lock(stateMutex);
+
+	// If the interrupt is not masked
+	if (!getFlag(flags::i))
+	{
+		_interruptStack.push_back(InterruptInfo {
+			concat24(PBR, PC),
+			P,
+			SP,
+		});
+
+		if (_interruptStack.size() > 1) {
+			Blaze::printLine("cpu", "Entering an interrupt within another interrupt! Nested within " + std::to_string(_interruptStack.size()) + " interrupts.");
+		}
+
+		if (!usingEmulationMode()) {
+			// in native mode: push the PBR
+			store8(SP, PBR);
+			SP--;
+		}
+
+		// Push the value of pc onto the stack
+		store16(SP - 1, PC);
+		SP -= 2;
+
+		Byte processorStatus = P;
+
+		// if we're in emulation mode, then bit 4 of the processor status is actually the break bit instead of the index register size bit.
+		// let's clear it to indicate this is an external interrupt and not a BRK interrupt.
+		if (usingEmulationMode()) {
+			processorStatus &= ~flags::b;
+		}
+
+		// disable further interrupts
+		setFlag(flags::i, true);
+		// disable decimal mode
+		setFlag(flags::d, false);
+
+		// push the status register onto the stack
+		store8(SP, P);
+		SP--;
+
+		// the PBR is forced to 0
+		PBR = 0;
+
+		// Read the interrupt program address from the interrupt table
+		PC = load16(usingEmulationMode() ? ExceptionVectorAddress::EmulatedIRQ : ExceptionVectorAddress::NativeIRQ);
+	}
+
+	// we just received an interrupt, so we're no longer waiting for one
+	waitingForInterrupt = false;
+}
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::nmi() {
+	std::unique_lock lock(stateMutex);
+
+	_interruptStack.push_back(InterruptInfo {
+		concat24(PBR, PC),
+		P,
+		SP,
+	});
+
+	if (_interruptStack.size() > 1) {
+		Blaze::printLine("cpu", "Entering an interrupt within another interrupt! Nested within " + std::to_string(_interruptStack.size()) + " interrupts.");
+	}
+
+	if (!usingEmulationMode()) {
+		// in native mode: push the PBR
+		store8(SP, PBR);
+		SP--;
+	}
+
+	store16(SP - 1, PC);
+	SP -= 2;
+
+	Byte processorStatus = P;
+
+	// see irq() for why we do this
+	if (usingEmulationMode()) {
+		processorStatus &= ~flags::b;
+	}
+
+	// disable interrupts
+	setFlag(flags::i, true);
+	// disable decimal mode
+	setFlag(flags::d, false);
+
+	// store the processor status
+	store8(SP, processorStatus);
+	SP--;
+
+	// the PBR is forced to 0
+	PBR = 0;
+
+	PC = load16(usingEmulationMode() ? ExceptionVectorAddress::EmulatedNMI : ExceptionVectorAddress::NativeNMI);
+
+	// we just received an interrupt, so we're no longer waiting for one
+	waitingForInterrupt = false;
+}
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::abort() {
+	std::unique_lock lock(stateMutex);
+
+	_interruptStack.push_back(InterruptInfo {
+		concat24(PBR, PC),
+		P,
+		SP,
+	});
+
+	if (_interruptStack.size() > 1) {
+		Blaze::printLine("cpu", "Entering an interrupt within another interrupt! Nested within " + std::to_string(_interruptStack.size()) + " interrupts.");
+	}
+
+	if (!usingEmulationMode()) {
+		store8(SP, PBR);
+		SP--;
+	}
+
+	store16(SP - 1, PC);
+	SP -= 2;
+
+	Byte processorStatus = P;
+
+	// see irq() for why we do this
+	if (usingEmulationMode()) {
+		processorStatus &= ~flags::b;
+	}
+
+	store8(SP, processorStatus);
+	SP--;
+
+	setFlag(flags::i, true);
+	setFlag(flags::d, false);
+
+	PBR = 0x00;
+
+	PC = load16(usingEmulationMode() ? ExceptionVectorAddress::EmulatedABORT : ExceptionVectorAddress::NativeABORT);
+
+	// we just received an interrupt, so we're no longer waiting for one
+	waitingForInterrupt = false;
+}
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::setZeroNegFlags(const Register& reg) {
+	setFlag(flags::n, reg.mostSignificantBit());
+	setFlag(flags::z, reg.load() == 0);
+}
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::setOverflowFlag(Word leftOperand, Word rightOperand, Word result) {
+	bool msb8Bit = memoryAndAccumulatorAre8Bit();
+	bool leftSign = msb(leftOperand, msb8Bit);
+	bool rightSign = msb(rightOperand, msb8Bit);
+	bool resultSign = msb(result, msb8Bit);
+	// if the signs of the inputs are equal to each other but not the sign of the result,
+	// then signed overflow/underflow occurred.
+	setFlag(flags::v, (leftSign == rightSign) && (leftSign != resultSign));
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::execute() {
+	std::unique_lock lock(stateMutex);
+
+	if (stopped || waitingForInterrupt) {
+		// if the processor is stopped or waiting for an interrupt, there's nothing for us to do
+		return;
+	}
+
+	// update `executingPC` to point to the instruction we're about to execute
+	executingPC = concat24(PBR, PC);
+	instrumentation.beforeExecute(executingPC);
+
+	// decode instruction and get info (e.g. # of cycles to run, instruction size)
+	auto info = decodeInstruction(load8(executingPC), memoryAndAccumulatorAre8Bit(), indexRegistersAre8Bit());
+
+	// Check for invalid instruction
+	if(info.opcode == Opcode::INVALID)
+	{
+		invalidInstruction();
+		return;
+	}
+
+	// the PC is always incremented to the next instruction before the current instruction starts executing
+	PC += info.size;
+
+	// execute instruction with the info
+	info.cycles = executeInstruction(info);
+	cycleCounter += info.cycles * MASTER_CLOCKS_PER_IO_CYCLE;
+}
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::copyStateFrom(const BasicCPU& other) {
+	std::scoped_lock lock(stateMutex, other.stateMutex);
+
+	_interruptStack = other._interruptStack;
+	e = other.e;
+	A.forceStoreFull(other.A.forceLoadFull());
+	DR = other.DR;
+	PC = other.PC;
+	X.forceStoreFull(other.X.forceLoadFull());
+	Y.forceStoreFull(other.Y.forceLoadFull());
+	SP = other.SP;
+	DBR = other.DBR;
+	PBR = other.PBR;
+	P = other.P;
+	executingPC = other.executingPC;
+	cycleCounter = other.cycleCounter;
+	waitingForInterrupt = other.waitingForInterrupt;
+	stopped = other.stopped;
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::setFlag(Byte flag, bool s) {
+	std::unique_lock lock(stateMutex);
+	if (s) {
+		P |= flag; // set flag
+	} else {
+		P &= ~flag; // clear flag
+	}
+}
+
+template<typename BusType>
+bool Blaze::BasicCPU<BusType>::getFlag(Byte f) const {
+	std::unique_lock lock(stateMutex);
+	return (P & f) != 0;
+};
+
+template<typename BusType>
+Blaze::Byte Blaze::BasicCPU<BusType>::load8(Address address) {
+	instrumentation.onRead(address, 8);
+	return bus->read8(address);
+};
+
+template<typename BusType>
+Blaze::Word Blaze::BasicCPU<BusType>::load16(Address address) {
+	instrumentation.onRead(address, 16);
+	return bus->read16(address);
+};
+
+template<typename BusType>
+Blaze::Address Blaze::BasicCPU<BusType>::load24(Address address) {
+	instrumentation.onRead(address, 24);
+	return bus->read24(address);
+};
+
+template<typename BusType>
+Blaze::Byte Blaze::BasicCPU<BusType>::load8(Byte bank, Word addressLow) {
+	return load8(concat24(bank, addressLow));
+};
+
+template<typename BusType>
+Blaze::Word Blaze::BasicCPU<BusType>::load16(Byte bank, Word addressLow) {
+	return load16(concat24(bank, addressLow));
+};
+
+template<typename BusType>
+Blaze::Address Blaze::BasicCPU<BusType>::load24(Byte bank, Word addressLow) {
+	return load24(concat24(bank, addressLow));
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::store8(Address address, Byte value) {
+	instrumentation.onWrite(address, 8, value);
+	// Write address and value to bus
+	bus->write(address, value);
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::store16(Address address, Word value) {
+	instrumentation.onWrite(address, 16, value);
+	// Write 16-bit value to address through bus
+	bus->write(address, value);
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::store24(Address address, Address value) {
+	instrumentation.onWrite(address, 24, value);
+	// Write 24-bit value to address through bus
+	bus->write(address, value);
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::store8(Byte bank, Word addressLow, Byte value) {
+	return store8(concat24(bank, addressLow), value);
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::store16(Byte bank, Word addressLow, Word value) {
+	return store16(concat24(bank, addressLow), value);
+};
+
+template<typename BusType>
+void Blaze::BasicCPU<BusType>::store24(Byte bank, Word addressLow, Address value) {
+	return store24(concat24(bank, addressLow), value);
+};
+
+template<typename BusType>
+Blaze::Address Blaze::BasicCPU<BusType>::decodeAddress(AddressingMode mode) {
+	Address addressStart = executingPC + 1;
+
+	switch (mode) {
+		case AddressingMode::Absolute:
+			return concat24(DBR, load16(addressStart));
+		case AddressingMode::AbsoluteIndexedIndirect:
+			return load16(0, load16(addressStart) + X.load());
+		case AddressingMode::AbsoluteIndexedX:
+			return concat24(DBR, load16(addressStart) + X.load());
+		case AddressingMode::AbsoluteIndexedY:
+			return concat24(DBR, load16(addressStart) + Y.load());
+
+		case AddressingMode::AbsoluteIndirect: {
+			auto base = load16(addressStart);
+			if (load8(executingPC) == /* JML */ 0xdc) {
+				return load24(0, base);
+			} else {
+				return load16(0, base);
+			}
+		} break;
+
+		case AddressingMode::AbsoluteLongIndexedX:
+			return load24(addressStart) + X.load();
+		case AddressingMode::AbsoluteLong:
+			return load24(addressStart);
+		case AddressingMode::DirectIndexedIndirect:
+			return concat24(DBR, load16(0, DR + X.load() + load8(addressStart)));
+		case AddressingMode::DirectIndexedX:
+			return concat24(0, DR + X.load() + load8(addressStart));
+		case AddressingMode::DirectIndexedY:
+			return concat24(0, DR + Y.load() + load8(addressStart));
+		case AddressingMode::DirectIndirectIndexed:
+			return concat24(DBR, load16(0, DR + load8(addressStart))) + Y.load();
+		case AddressingMode::DirectIndirectLongIndexed:
+			return load24(0, DR + load8(addressStart)) + Y.load();
+		case AddressingMode::DirectIndirectLong:
+			return load24(0, DR + load8(addressStart));
+		case AddressingMode::DirectIndirect:
+			return concat24(DBR, load16(0, DR + load8(addressStart)));
+		case AddressingMode::Direct:
+			return concat24(0, DR + load8(addressStart));
+		case AddressingMode::ProgramCounterRelativeLong:
+			return static_cast<uint16_t>(static_cast<int16_t>(PC) + static_cast<int16_t>(load16(addressStart)));
+		case AddressingMode::ProgramCounterRelative:
+			return static_cast<uint16_t>(static_cast<int16_t>(PC) + static_cast<int8_t>(load8(addressStart)));
+		case AddressingMode::StackRelative:
+			return concat24(0, SP + load8(addressStart));
+		case AddressingMode::StackRelativeIndirectIndexed:
+			return concat24(DBR, load16(0, SP + load8(addressStart))) + Y.load();
+
+		case AddressingMode::Accumulator:
+		case AddressingMode::BlockMove:
+		case AddressingMode::Immediate:
+		case AddressingMode::Implied:
+		case AddressingMode::Stack:
+		default:
+			return 0;
+	}
+};
+
+template<typename BusType>
+Blaze::Word Blaze::BasicCPU<BusType>::loadOperand(AddressingMode addressingMode, bool use8BitOperand) {
+	Address operand = decodeAddress(addressingMode);
+	if (addressingMode == AddressingMode::Immediate) {
+		operand = use8BitOperand ? load8(executingPC + 1) : load16(executingPC + 1);
+	} else {
+		operand = use8BitOperand ? load8(operand) : load16(operand);
+	}
+
+	// make sure the operand is actually 16 bits wide and not 24 bits
+	assert((operand & 0xffff) == operand);
+
+	return operand;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeInstruction(const Instruction& info) {
+	switch (info.opcode) {
+		case Opcode::BRK: return executeBRK();
+		case Opcode::BRL: return executeBRL();
+		case Opcode::CLC: return executeCLC();
+		case Opcode::CLD: return executeCLD();
+		case Opcode::CLI: return executeCLI();
+		case Opcode::CLV: return executeCLV();
+		case Opcode::COP: return executeCOP();
+		case Opcode::DEX: return executeDEX();
+		case Opcode::DEY: return executeDEY();
+		case Opcode::INX: return executeINX();
+		case Opcode::INY: return executeINY();
+		case Opcode::JML: return executeJML();
+		case Opcode::JSL: return executeJSL();
+		case Opcode::MVN: return executeMVN();
+		case Opcode::MVP: return executeMVP();
+		case Opcode::NOP: return executeNOP();
+		case Opcode::PEA: return executePEA();
+		case Opcode::PEI: return executePEI();
+		case Opcode::PER: return executePER();
+		case Opcode::PHA: return executePHA();
+		case Opcode::PHB: return executePHB();
+		case Opcode::PHD: return executePHD();
+		case Opcode::PHK: return executePHK();
+		case Opcode::PHP: return executePHP();
+		case Opcode::PHX: return executePHX();
+		case Opcode::PHY: return executePHY();
+		case Opcode::PLA: return executePLA();
+		case Opcode::PLB: return executePLB();
+		case Opcode::PLD: return executePLD();
+		case Opcode::PLP: return executePLP();
+		case Opcode::PLX: return executePLX();
+		case Opcode::PLY: return executePLY();
+		case Opcode::REP: return executeREP();
+		case Opcode::RTI: return executeRTI();
+		case Opcode::RTL: return executeRTL();
+		case Opcode::RTS: return executeRTS();
+		case Opcode::SEC: return executeSEC();
+		case Opcode::SED: return executeSED();
+		case Opcode::SEI: return executeSEI();
+		case Opcode::SEP: return executeSEP();
+		case Opcode::STP: return executeSTP();
+		case Opcode::TAX: return executeTAX();
+		case Opcode::TAY: return executeTAY();
+		case Opcode::TCD: return executeTCD();
+		case Opcode::TCS: return executeTCS();
+		case Opcode::TDC: return executeTDC();
+		case Opcode::TSC: return executeTSC();
+		case Opcode::TSX: return executeTSX();
+		case Opcode::TXA: return executeTXA();
+		case Opcode::TXS: return executeTXS();
+		case Opcode::TXY: return executeTXY();
+		case Opcode::TYA: return executeTYA();
+		case Opcode::TYX: return executeTYX();
+		case Opcode::WAI: return executeWAI();
+		case Opcode::WDM: return executeWDM();
+		case Opcode::XBA: return executeXBA();
+		case Opcode::XCE: return executeXCE();
+
+		case Opcode::ADC: return executeADC(info.addressingMode);
+		case Opcode::AND: return executeAND(info.addressingMode);
+		case Opcode::ASL: return executeASL(info.addressingMode);
+		case Opcode::BIT: return executeBIT(info.addressingMode);
+		case Opcode::CMP: return executeCMP(info.addressingMode);
+		case Opcode::CPX: return executeCPX(info.addressingMode);
+		case Opcode::CPY: return executeCPY(info.addressingMode);
+		case Opcode::DEC: return executeDEC(info.addressingMode);
+		case Opcode::EOR: return executeEOR(info.addressingMode);
+		case Opcode::INC: return executeINC(info.addressingMode);
+		case Opcode::JMP: return executeJMP(info.addressingMode);
+		case Opcode::JSR: return executeJSR(info.addressingMode);
+		case Opcode::LDA: return executeLDA(info.addressingMode);
+		case Opcode::LDX: return executeLDX(info.addressingMode);
+		case Opcode::LDY: return executeLDY(info.addressingMode);
+		case Opcode::LSR: return executeLSR(info.addressingMode);
+		case Opcode::ORA: return executeORA(info.addressingMode);
+		case Opcode::ROL: return executeROL(info.addressingMode);
+		case Opcode::ROR: return executeROR(info.addressingMode);
+		case Opcode::SBC: return executeSBC(info.addressingMode);
+		case Opcode::STA: return executeSTA(info.addressingMode);
+		case Opcode::STX: return executeSTX(info.addressingMode);
+		case Opcode::STY: return executeSTY(info.addressingMode);
+		case Opcode::STZ: return executeSTZ(info.addressingMode);
+		case Opcode::TRB: return executeTRB(info.addressingMode);
+		case Opcode::TSB: return executeTSB(info.addressingMode);
+
+		case Opcode::BRA: return executeBRA(info.condition, info.passConditionIfBitSet);
+
+		default:
+			return invalidInstruction();
+	}
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::invalidInstruction() {
+	// Instruction is invalid -> initiate hardware interrupt: ABORT
+	abort();
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeBRK() {
+	_interruptStack.push_back(InterruptInfo {
+		concat24(PBR, PC),
+		P,
+		SP,
+	});
+
+	if (_interruptStack.size() > 1) {
+		Blaze::printLine("cpu", "Entering an interrupt within another interrupt! Nested within " + std::to_string(_interruptStack.size()) + " interrupts.");
+	}
+
+	auto param = loadOperand(AddressingMode::Immediate, true);
+
+	if (!usingEmulationMode()) {
+		// in native mode: push the PBR
+		store8(SP, PBR);
+		SP--;
+	}
+
+	// Push the next PC onto the stack
+	store16(SP - 1, PC);
+	SP -= 2;
+
+	// Push processor status onto the stack
+	// if we're using emulation mode, we have to have the break flag set
+	store8(SP, P | (usingEmulationMode() ? flags::b : 0));
+	SP--;
+
+	// Disable further interrupts
+	setFlag(flags::i, true);
+	// disable decimal mode
+	setFlag(flags::d, false);
+
+	// Fetch the interrupt vector for IRQ
+	// BRK uses the IRQ vector in emulation mode
+	PBR = 0;
+	PC = load16(usingEmulationMode() ? ExceptionVectorAddress::EmulatedIRQ : ExceptionVectorAddress::NativeBRK);
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeBRL() {
+	PC = decodeAddress(AddressingMode::ProgramCounterRelativeLong);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCLC() {
+	setFlag(flags::c, false);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCLD() {
+	setFlag(flags::d, false);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCLI() {
+	setFlag(flags::i, false);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCLV() {
+	setFlag(flags::v, false);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCOP() {
+	Byte coprocessorInstruction = loadOperand(AddressingMode::Immediate, true);
+
+	// this instruction is used to give commands to coprocessors located on the cartridge along with the game in the ROM.
+	// for now, we don't support this, so just ignore it.
+
+	return 5 + (usingEmulationMode() ? 0 : 1);
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeDEX() {
+	X--;
+	setZeroNegFlags(X);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeDEY() {
+	Y--;
+	setZeroNegFlags(Y);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeINX() {
+	X++;
+	setZeroNegFlags(X);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeINY() {
+	Y++;
+	setZeroNegFlags(Y);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeJML() {
+	Address addr = decodeAddress(AddressingMode::AbsoluteIndirect);
+	split24(addr, PBR, PC);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeJSL() {
+	Address newPC = decodeAddress(AddressingMode::AbsoluteLong);
+	// subtract 1 because it's required
+	Address pcToStore = concat24(PBR, PC - 1);
+
+#if BLAZE_PRINT_SUBROUTINES
+	Blaze::printLine("cpu", "Jumping to subroutine at " + valueToHexString(newPC, 6, "$"));
+#endif
+
+	SP -= 2;
+	store24(SP, pcToStore);
+	--SP;
+
+	split24(newPC, PBR, PC);
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeMVN() {
+	auto dstBank = load8(executingPC + 1);
+	auto srcBank = load8(executingPC + 2);
+
+	DBR = dstBank;
+
+	do {
+		auto srcVal = load8(srcBank, X.load());
+		store8(dstBank, Y.load(), srcVal);
+
+		X += 1;
+		Y += 1;
+		A.forceStoreFull(A.forceLoadFull() - 1);
+
+		// each byte transferred takes 7 cycles;
+		// subtract the ones from the load and store above and you get 5
+		cycleCounter += 5 * MASTER_CLOCKS_PER_IO_CYCLE;
+	} while (A.forceLoadFull() != 0xffff);
+
+	return 0;
+};
+
+// exactly the same as MVN, except we decrement X and Y instead of incrementing
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeMVP() {
+	auto dstBank = load8(executingPC + 1);
+	auto srcBank = load8(executingPC + 2);
+
+	DBR = dstBank;
+
+	do {
+		auto srcVal = load8(srcBank, X.load());
+		store8(dstBank, Y.load(), srcVal);
+
+		X -= 1;
+		Y -= 1;
+		A.forceStoreFull(A.forceLoadFull() - 1);
+
+		// each byte transferred takes 7 cycles;
+		// subtract the ones from the load and store above and you get 5
+		cycleCounter += 5 * MASTER_CLOCKS_PER_IO_CYCLE;
+	} while (A.forceLoadFull() != 0xffff);
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeNOP() {
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePEA() {
+	Word address = load16(PC + 1);
+	SP -= 2;
+	store16(0, SP + 1, address);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePEI() {
+	Word effectiveAddress = decodeAddress(AddressingMode::DirectIndirect);
+	SP -= 2;
+	store16(0, SP + 1, effectiveAddress);
+	//SP -= 2;
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePER() {
+	Word relativeAddr = decodeAddress(AddressingMode::ProgramCounterRelativeLong);
+	SP -= 2;
+	store16(0, SP + 1, relativeAddr);
+	//SP -= 2;
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHA() {
+	if (memoryAndAccumulatorAre8Bit()) {
+		store8(SP, A.load());
+	}
+	else {
+		SP--;
+		store16(SP, A.forceLoadFull());
+	}
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHB() {
+	store8(SP, DBR);
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHD() {
+	if (usingEmulationMode()) {
+		store8(SP, DR);
+	} else {
+		SP--;
+		store16(SP, DR);
+	}
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHK() {
+	store8(SP, PBR);
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHP() {
+	store8(SP, P);
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHX() {
+	if (indexRegistersAre8Bit()) {
+		store8(SP, X.load());
+	}
+	else {
+		SP--;
+		store16(SP, X.forceLoadFull());
+	}
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePHY() {
+	if (indexRegistersAre8Bit()) {
+		store8(SP, Y.load());
+	}
+	else {
+		SP--;
+		store16(SP, Y.forceLoadFull());
+	}
+	SP--;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePLA() {
+	SP++;
+	if (memoryAndAccumulatorAre8Bit()) {
+		A = load8(SP);
+	}
+	else {
+		A = load16(SP);
+		SP++;
+	}
+	setZeroNegFlags(A);
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePLB() {
+	SP++;
+	DBR = load8(SP);
+	setFlag(flags::n, msb8(DBR));
+	setFlag(flags::z, (DBR == 0));
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePLD() {
+	SP++;
+	if (usingEmulationMode()) {
+		DR = load8(SP);
+		setFlag(flags::n, msb8(DR));
+	} else {
+		DR = load16(SP);
+		SP++;
+		setFlag(flags::n, msb16(DR));
+	}
+	setFlag(flags::z, (DR == 0));
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePLP() {
+	SP++;
+	P = load8(SP);
+	if (usingEmulationMode()) {
+		setFlag(flags::x, true);
+		setFlag(flags::m, true);
+	}
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePLX() {
+	SP++;
+	if (indexRegistersAre8Bit()) {
+		X = load8(SP);
+	}
+	else {
+		X = load16(SP);
+		SP++;
+	}
+	setZeroNegFlags(X);
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executePLY() {
+	SP++;
+	if (indexRegistersAre8Bit()) {
+		Y = load8(SP);
+	}
+	else {
+		Y = load16(SP);
+		SP++;
+	}
+	setZeroNegFlags(Y);
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeREP() {
+	Word val = loadOperand(AddressingMode::Immediate, true);
+	P &= ~val;
+	if (usingEmulationMode()) {
+		setFlag(flags::x, true);
+		setFlag(flags::m, true);
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeRTI() {
+	SP++;
+	P = load8(SP);
+	// Pop the program counter from the stack
+	PC = load16(SP + 1);
+	SP += 2;
+	if (usingEmulationMode()) {
+		// ensure the x and m bits are set
+		setFlag(flags::x, true);
+		setFlag(flags::m, true);
+	} else {
+		// pop the PBR from the stack
+		SP++;
+		PBR = load8(SP);
+	}
+
+	if (!_interruptStack.empty()) {
+		_interruptStack.erase(_interruptStack.end() - 1);
+	}
+
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeRTL() {
+	++SP;
+	Address newPC = load24(SP);
+	SP += 2;
+
+	split24(newPC, PBR, PC);
+	++PC; // add 1 to account for the `- 1` when storing the PC (it's required)
+
+#if BLAZE_PRINT_SUBROUTINES
+	Blaze::printLine("cpu", "Returning from subroutine to " + valueToHexString(PC, 6, "$"));
+#endif
+
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeRTS() {
+	++SP;
+	Address newPC = load16(SP);
+	++SP;
+
+	// add 1 to account for the `- 1` when storing the PC (it's required)
+	PC = newPC + 1;
+
+#if BLAZE_PRINT_SUBROUTINES
+	Blaze::printLine("cpu", "Returning from subroutine to " + valueToHexString(PC, 6, "$"));
+#endif
+
+	return 3;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSEC() {
+	setFlag(flags::c, true);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSED() {
+	setFlag(flags::d, true);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSEI() {
+	setFlag(flags::i, true);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSEP() {
+	Word val = loadOperand(AddressingMode::Immediate, true);
+	P |= val;
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSTP() {
+	stopped = true;
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTAX() {
+	X = A.forceLoadFull();
+	setZeroNegFlags(X);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTAY() {
+	Y = A.forceLoadFull();
+	setZeroNegFlags(Y);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTCD() {
+	DR = A.forceLoadFull();
+	if (usingEmulationMode()) {
+		setFlag(flags::n, msb8(DR));
+	} else {
+		setFlag(flags::n, msb16(DR));
+	}
+	setFlag(flags::z, (DR == 0));
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTCS() {
+	SP = A.forceLoadFull();
+	if (SP == 0x4200) {
+		throw std::runtime_error("invalid stack address");
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTDC() {
+	A.forceStoreFull(DR);
+	setZeroNegFlags(A);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTSC() {
+	A.forceStoreFull(SP);
+	setZeroNegFlags(A);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTSX() {
+	X = SP;
+	setZeroNegFlags(X);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTXA() {
+	A = X.load();
+	setZeroNegFlags(A);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTXS() {
+	if (usingEmulationMode()) {
+		SP = 0x0100 | lo8(X.load());
+	} else {
+		SP = X.load();
+		if (SP == 0x4200) {
+			throw std::runtime_error("invalid stack address");
+		}
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTXY() {
+	Y = X.load();
+	setZeroNegFlags(Y);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTYA() {
+	A = Y.load();
+	setZeroNegFlags(A);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTYX() {
+	X = Y.load();
+	setZeroNegFlags(X);
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeWAI() {
+	waitingForInterrupt = true;
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeWDM() {
+	Byte operand = loadOperand(AddressingMode::Immediate, true);
+
+	switch (operand) {
+		case CustomWDMOpcodes::PutChararacter: {
+			instrumentation.onPutCharacter(static_cast<char>(lo8(A.load())));
+			return 0;
+		} break;
+
+		default:
+			return invalidInstruction();
+	}
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeXBA() {
+	// get high and low bytes
+	Word highMask = hi8(A.forceLoadFull(), false);
+	Word lowMask = lo8(A.forceLoadFull());
+
+	// Swap
+	highMask = (highMask >> 8);
+	lowMask = (lowMask << 8);
+
+	// Store in A
+	A.forceStoreFull(lowMask | highMask);
+
+	return 2;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeXCE() {
+	// Swap values of e and c flags
+	Byte tempC = getFlag(flags::c) ? 1 : 0;
+	setFlag(flags::c, usingEmulationMode());
+	e = tempC;
+
+	// If switched to emulation mode
+	if(usingEmulationMode())
+	{
+		// Force m and x to 1
+		setFlag(flags::m, true);
+		setFlag(flags::x, true);
+
+		// XH and YH are forced to $00
+		X = lo8(X.load());
+		Y = lo8(Y.load());
+
+		// SH is forced to $01
+		SP = lo8(SP) | 0x0100;
+	}
+
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeADC(AddressingMode mode) {
+	// use `Address` instead of `Word` so that we have extra bits to properly compute the carry
+	Address left = A.load();
+	Address right = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+	Address result = left + right + getCarry();
+	Address wordMask = (memoryAndAccumulatorAre8Bit() ? 0xff : 0xffff);
+	Word wordResult = result & wordMask;
+
+	A = wordResult;
+
+	setZeroNegFlags(A);
+	setOverflowFlag(left, right, wordResult);
+	setFlag(flags::c, (result & ~wordMask) != 0);
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeAND(AddressingMode mode) {
+	Word val = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+	A &= val;
+	setZeroNegFlags(A);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeASL(AddressingMode mode) {
+	// Get byte to shift
+	Address addr = decodeAddress(mode);
+
+	Word val;
+
+	if (mode == AddressingMode::Accumulator) {
+		val = A.load();
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		val = load8(addr);
+	} else {
+		val = load16(addr);
+	}
+
+	// Set carry flag if current left bit is 1
+	setFlag(flags::c, msb(val, memoryAndAccumulatorAre8Bit()));
+
+	// Shift
+	val <<= 1;
+
+	if (mode == AddressingMode::Accumulator) {
+		A.store(val);
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		store8(addr, val);
+	} else {
+		store16(addr, val);
+	}
+
+	setFlag(flags::z, val == 0);
+	setFlag(flags::n, msb(val, memoryAndAccumulatorAre8Bit()));
+
+	return (mode == AddressingMode::DirectIndexedX || mode == AddressingMode::AbsoluteIndexedX) ? 2 : 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeBIT(AddressingMode mode) {
+	Word val = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+	setFlag(flags::z, (A & val) == 0);
+	setFlag(flags::n, msb(val, memoryAndAccumulatorAre8Bit()));
+	if (memoryAndAccumulatorAre8Bit()) {
+		setFlag(flags::v, ((val & (1u << 6)) != 0));
+	}
+	else {
+		setFlag(flags::v, ((val & (1u << 14)) != 0));
+	}
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCMP(AddressingMode mode) {
+	Word val = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+
+	Word temp = A.load() - val;
+	setFlag(flags::z, (A == val));
+	setFlag(flags::c, (A >= val));
+	setFlag(flags::n, msb(temp, memoryAndAccumulatorAre8Bit()));
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCPX(AddressingMode mode) {
+	Word val = loadOperand(mode, indexRegistersAre8Bit());
+	Word temp = X - val;
+	setFlag(flags::z, (X == val));
+	setFlag(flags::c, (X >= val));
+	setFlag(flags::n, msb(temp, indexRegistersAre8Bit()));
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeCPY(AddressingMode mode) {
+	Word val = loadOperand(mode, indexRegistersAre8Bit());
+	Word temp = Y - val;
+	setFlag(flags::z, (Y == val));
+	setFlag(flags::c, (Y >= val));
+	setFlag(flags::n, msb(temp, indexRegistersAre8Bit()));
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeDEC(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word val;
+	if (mode == AddressingMode::Accumulator) {
+		val = A.load();
+		val--;
+		A.store(val);
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		val = load8(addr);
+		val--;
+		store8(addr, lo8(val));
+	} else {
+		val = load16(addr);
+		val--;
+		store16(addr, val);
+	}
+	setFlag(flags::n, msb(val, memoryAndAccumulatorAre8Bit()));
+	setFlag(flags::z, (val == 0));
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeEOR(AddressingMode mode) {
+	Word val = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+	A ^= val;
+	setZeroNegFlags(A);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeINC(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word val;
+	if (mode == AddressingMode::Accumulator) {
+		val = A.load();
+		val++;
+		A.store(val);
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		val = load8(addr);
+		val++;
+		store8(addr, lo8(val));
+	} else {
+		val = load16(addr);
+		val++;
+		store16(addr, val);
+	}
+	setFlag(flags::n, msb(val, memoryAndAccumulatorAre8Bit()));
+	setFlag(flags::z, (val == 0));
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeJMP(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	PC = addr;
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeJSR(AddressingMode mode) {
+	Address newPC = decodeAddress(mode);
+	// subtract 1 because it's required
+	Word pcToStore = PC - 1;
+
+#if BLAZE_PRINT_SUBROUTINES
+	Blaze::printLine("cpu", "Jumping to subroutine at " + valueToHexString(newPC, 6, "$"));
+#endif
+
+	--SP;
+	store16(SP, pcToStore);
+	--SP;
+
+	PC = newPC;
+
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeLDA(AddressingMode mode) {
+	Word val = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+	A = val;
+	setZeroNegFlags(A);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeLDX(AddressingMode mode) {
+	Word val = loadOperand(mode, indexRegistersAre8Bit());
+	X = val;
+	setZeroNegFlags(X);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeLDY(AddressingMode mode) {
+	Word val = loadOperand(mode, indexRegistersAre8Bit());
+	Y = val;
+	setZeroNegFlags(Y);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeLSR(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word data;
+
+	if (mode == AddressingMode::Accumulator) {
+		data = A.load();
+	} else {
+		data = memoryAndAccumulatorAre8Bit() ? load8(addr) : load16(addr);
+	}
+
+	setFlag(flags::c, (data & 0x01) != 0);
+
+	data >>= 1;
+
+	if (mode == AddressingMode::Accumulator) {
+		A.store(data);
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		store8(addr, data);
+	} else {
+		store16(addr, data);
+	}
+
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeORA(AddressingMode mode) {
+	Word val = loadOperand(mode, memoryAndAccumulatorAre8Bit());
+	A |= val;
+	setZeroNegFlags(A);
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeROL(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word data;
+	Byte carry = getCarry();
+
+	if (mode == AddressingMode::Accumulator) {
+		data = A.load();
+	} else {
+		data = memoryAndAccumulatorAre8Bit() ? load8(addr) : load16(addr);
+	}
+
+	//set c to most significant bit of data
+	setFlag(flags::c, msb(data, memoryAndAccumulatorAre8Bit()));
+
+	data = (data << 1) | carry; // shift carry to least significant bit of 'data'
+
+	if (mode == AddressingMode::Accumulator) {
+		A.store(data);
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		store8(addr, data);
+	} else {
+		store16(addr, data);
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeROR(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word data;
+	Byte carry = getCarry();
+
+	if (mode == AddressingMode::Accumulator) {
+		data = A.load();
+	} else {
+		data = memoryAndAccumulatorAre8Bit() ? load8(addr) : load16(addr);
+	}
+
+	setFlag(flags::c, (data & 0x01) != 0);
+
+	data = (data >> 1) | carry;
+
+	if (mode == AddressingMode::Accumulator) {
+		A.store(data);
+	} else if (memoryAndAccumulatorAre8Bit()) {
+		store8(addr, data);
+	} else {
+		store16(addr, data);
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSBC(AddressingMode mode) {
+	// Fetch initial accumulator
+	Address left = A.load();
+
+	// Get and (bitwise) negate the operand
+	Address operand = ~(loadOperand(mode, memoryAndAccumulatorAre8Bit()));
+
+	// Compute
+	Address result = left + operand + getCarry();
+
+	// Handle different widths
+	Address wordMask = (memoryAndAccumulatorAre8Bit() ? 0xff : 0xffff);
+	Word wordResult = result & wordMask;
+
+	// Update accumulator
+	A = wordResult;
+
+	// Set flags
+	setZeroNegFlags(A);
+	setOverflowFlag(left, operand, wordResult);
+	setFlag(flags::c, (result & ~wordMask) != 0);
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSTA(AddressingMode mode) {
+	Address address = decodeAddress(mode);
+	if (memoryAndAccumulatorAre8Bit()) {
+		store8(address, A.load());
+	} else {
+		store16(address, A.load());
+	}
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSTX(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+
+	// Store the X register's value at the determined address.
+	if (indexRegistersAre8Bit()) {
+		store8(addr, static_cast<Byte>(X.load()));  // Storing only lower 8 bits of X register
+	} else {
+		store16(addr, X.forceLoadFull()); // Storing full 16 bits of X register
+	}
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSTY(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+
+	// Store the Y register's value at the determined address.
+	if (indexRegistersAre8Bit()) {
+		store8(addr, static_cast<Byte>(Y.load()));  // Storing only lower 8 bits of Y register
+	} else {
+		store16(addr, Y.forceLoadFull()); // Storing full 16 bits of Y register
+	}
+
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeSTZ(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+
+	if (memoryAndAccumulatorAre8Bit()) {
+		store8(addr, 0);
+	}
+	else {
+		store16(addr, 0);
+	}
+	return 0;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTRB(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word val;
+	if (memoryAndAccumulatorAre8Bit()) {
+		val = load8(addr);
+		setFlag(flags::z, (val & A.load()) == 0);
+		val &= ~A.load();
+		store8(addr, lo8(val));
+	}
+	else {
+		val = load16(addr);
+		setFlag(flags::z, (val & A.load()) == 0);
+		val &= ~A.load();
+		store16(addr, val);
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeTSB(AddressingMode mode) {
+	Address addr = decodeAddress(mode);
+	Word val;
+	if (memoryAndAccumulatorAre8Bit()) {
+		val = load8(addr);
+		setFlag(flags::z, (val & A.load()) == 0);
+		val |= A.load();
+		store8(addr, lo8(val));
+	}
+	else {
+		val = load16(addr);
+		setFlag(flags::z, (val & A.load()) == 0);
+		val |= A.load();
+		store16(addr, val);
+	}
+	return 1;
+};
+
+template<typename BusType>
+Blaze::Cycles Blaze::BasicCPU<BusType>::executeBRA(ConditionCode condition, bool passConditionIfBitSet) {
+	// Get the new PC if condition and bit are met
+	Word newPC = decodeAddress(AddressingMode::ProgramCounterRelative);
+	bool bitIsSet = false;
+
+
+	// No condition passed or condition == NONE -> BRA
+	if (condition == ConditionCode::NONE) {
+		// update PC
+		PC = newPC;
+		cycleCounter += MASTER_CLOCKS_PER_IO_CYCLE;
+	} else {
+		// Check the correct bit based on 
+		switch (condition) {
+			case ConditionCode::Carry:    bitIsSet = getFlag(flags::c); break; // BCS/BCC
+			case ConditionCode::Zero:     bitIsSet = getFlag(flags::z); break; // BEQ/BNQ
+			case ConditionCode::Negative: bitIsSet = getFlag(flags::n); break; // BMI/BPL
+			case ConditionCode::Overflow: bitIsSet = getFlag(flags::v); break; // BVS/BVC
+
+			default:
+				// this should be impossible
+				abort();
+		}
+
+		// if the bit is set and we want to pass the condition if it's set (i.e. BCS, BEQ, BMI, BVS), OR
+		// the bit is NOT set and we want to pass the condition if it's NOT set (i.e. BCC, BNQ, BPL, BVC),
+		// then we go ahead with the branch and update the PC
+		if ((bitIsSet && passConditionIfBitSet) || (!bitIsSet && !passConditionIfBitSet)) {
+			// update PC
+			PC = newPC;
+			cycleCounter += MASTER_CLOCKS_PER_IO_CYCLE;
+		}
+	}
+
+	// no, this is not a typo; for some reason, this instruction group takes longer under emulation mode
+	return usingEmulationMode() ? 1 : 0;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Blaze {
+	/**
+	 * SNES color math on lines of RGBA8888 pixels.
+	 *
+	 * The per-pixel masks are either 0 (off) or 0xffffffff (on). Pixels with `enable` off are left as-is;
+	 * the others are replaced with `main + addend` (or `main - addend` when subtracting), saturated,
+	 * and halved if `half` is on. The alpha of every output pixel is forced to 0xff.
+	 */
+	namespace ColorMath {
+		void apply(uint32_t* main, const uint32_t* addend, const uint32_t* enable, const uint32_t* half, size_t count, bool subtract);
+
+		// the plain (non-vectorized) implementation; `apply` uses it for any leftover pixels
+		void applyScalar(uint32_t* main, const uint32_t* addend, const uint32_t* enable, const uint32_t* half, size_t count, bool subtract);
+
+		// scales the color components of every pixel by `brightness` (0-15), the same way `ColorTable` does it
+		void applyBrightness(uint32_t* pixels, size_t count, uint8_t brightness);
+	};
+};
@@ -8,13 +8,20 @@
 namespace Blaze {
 	struct Bus;
 
-	// these are special offsets that have nothing to do with their actual addresses
-	// because these two registers don't lie within the memory region used for all the
-	// other DMA registers.
-	static constexpr Address DMA_SPECIAL_OFFSET_MDMAEN = 0xffff00;
-	static constexpr Address DMA_SPECIAL_OFFSET_HDMAEN = 0xffff80;
-
 	class DMA: public MMIODevice {
+	public:
+		// offsets from $4200
+		struct Registers {
+			enum IgnoreMe: Address {
+				MDMAEN = 0x0b,
+				HDMAEN = 0x0c,
+
+				// the per-channel registers ($4300 through $437F), 16 for each channel
+				CHANNELS     = 0x100,
+				CHANNELS_END = 0x17f,
+			};
+		};
+
 	private:
 		enum class TransferPattern: Byte {
 			SingleByte = 0,
@@ -101,5 +108,8 @@ namespace Blaze {
 		void write(Address offset, Byte bitSize, Address value) override;
 
 		void reset(Bus* bus) override;
+
+		// copies the channel configuration of another DMA controller (but not its bus)
+		void copyStateFrom(const DMA& other);
 	};
 };
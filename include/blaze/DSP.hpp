@@ -0,0 +1,157 @@
+#pragma once
+
+#include <blaze/MemTypes.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Blaze {
+	/**
+	 * The S-DSP: generates 32 kHz stereo audio from the BRR samples in ARAM using 8 voices, each with their own
+	 * envelope (ADSR or GAIN), pitch, and volume, plus a noise generator and an echo unit with an 8-tap FIR filter.
+	 *
+	 * This produces one sample at a time rather than emulating the DSP's internal cycle-by-cycle schedule.
+	 */
+	class DSP {
+	public:
+		static constexpr size_t VOICE_COUNT = 8;
+		static constexpr size_t REGISTER_COUNT = 128;
+		static constexpr size_t FIR_TAPS = 8;
+
+		// a sample is generated every 32 SPC700 cycles
+		static constexpr unsigned CYCLES_PER_SAMPLE = 32;
+		static constexpr unsigned SAMPLE_RATE = 32000;
+
+		// samples stop being buffered once this many are waiting to be taken
+		static constexpr size_t MAX_BUFFERED_SAMPLES = SAMPLE_RATE;
+
+		struct Sample {
+			int16_t left = 0;
+			int16_t right = 0;
+		};
+
+		using ARAM = std::array<Byte, 64 * 1024>;
+
+		DSP();
+
+		void reset();
+
+		Byte readRegister(Byte address) const;
+		void writeRegister(Byte address, Byte value);
+
+		// must be called for every write to ARAM (including the DSP's own echo writes) to keep the BRR cache coherent
+		inline void aramWritten(Word address) {
+			++_pageGenerations[address >> 8];
+		};
+
+		// generates the next sample, reading samples from (and writing echo to) the given ARAM
+		void generateSample(ARAM& aram);
+
+		// moves the generated samples into `samples` (appending to it)
+		void takeSamples(std::vector<Sample>& samples);
+
+		inline size_t bufferedSamples() const {
+			return _output.size();
+		};
+
+		/**
+		 * The echo FIR filter: `history` holds the last 8 echo samples (oldest first) and `coefficients` the FIR
+		 * coefficients (as signed values), both padded to 16 bits. Returns the clamped output.
+		 *
+		 * The first seven taps are summed with 16-bit wrap-around before the last one is added, just like on the real DSP.
+		 */
+		static int fir(const int16_t* history, const int16_t* coefficients);
+		static int firScalar(const int16_t* history, const int16_t* coefficients);
+
+		/**
+		 * Mixes the outputs of the voices whose bits are set in `enabled`, each scaled by its volume.
+		 *
+		 * The DSP clamps the running total after each voice, so overflowing sums can depend on the order of the voices;
+		 * the vector version only takes a shortcut when it can prove no intermediate total overflows.
+		 */
+		static int mix(const int16_t* outputs, const int16_t* volumes, Byte enabled);
+		static int mixScalar(const int16_t* outputs, const int16_t* volumes, Byte enabled);
+
+	private:
+		enum class EnvelopeMode: Byte {
+			Release,
+			Attack,
+			Decay,
+			Sustain,
+		};
+
+		struct Voice {
+			// the last 3 samples of the previous block followed by the current block's 16 samples
+			std::array<int16_t, 19> samples {};
+
+			// the ARAM address of the current BRR block and its header
+			Word blockAddress = 0;
+			Byte blockHeader = 0;
+
+			// the position within the current block, in 1/4096ths of a sample
+			unsigned position = 0;
+
+			int envelope = 0;
+
+			// the envelope value before it's gated by the rate counter (used by the two-slope GAIN mode)
+			int hiddenEnvelope = 0;
+
+			EnvelopeMode envelopeMode = EnvelopeMode::Release;
+
+			// samples left until a newly keyed on voice starts playing
+			Byte keyOnDelay = 0;
+		};
+
+		// a decoded BRR block; decoding depends on the two samples before the block, so they're part of the key
+		struct CachedBlock {
+			Word address = 0;
+			int16_t previous1 = 0;
+			int16_t previous2 = 0;
+			bool valid = false;
+			std::array<uint32_t, 2> generations {};
+			std::array<int16_t, 16> samples {};
+		};
+
+		static constexpr size_t BRR_CACHE_SIZE = 4096;
+		static constexpr size_t BRR_BLOCK_SIZE = 9;
+
+		std::array<Byte, REGISTER_COUNT> _registers {};
+		std::array<Voice, VOICE_COUNT> _voices;
+
+		// copies of the voice volumes (left, then right) and FIR coefficients, sign-extended for the vector kernels
+		std::array<std::array<int16_t, VOICE_COUNT>, 2> _volumes {};
+		std::array<int16_t, FIR_TAPS> _firCoefficients {};
+
+		// bumped for every write to each 256-byte page of ARAM; cached blocks are only valid while these match
+		std::array<uint32_t, 256> _pageGenerations {};
+		std::vector<CachedBlock> _brrCache;
+
+		// voices keyed on since the last time KON was processed
+		Byte _pendingKeyOn = 0;
+		bool _everyOtherSample = true;
+
+		// counts down for the envelope and noise rates
+		int _counter = 0;
+
+		int _noise = 0x4000;
+
+		// the echo history is stored twice in a row so that the last 8 samples are always contiguous
+		std::array<std::array<int16_t, FIR_TAPS * 2>, 2> _echoHistory {};
+		size_t _echoHistoryPosition = 0;
+		unsigned _echoOffset = 0;
+		unsigned _echoLength = 0;
+
+		std::vector<Sample> _output;
+
+		bool counterFires(unsigned rate) const;
+		void keyOn(Voice& voice, size_t index, const ARAM& aram);
+		void loadBlock(Voice& voice, const ARAM& aram);
+		const CachedBlock& decodeBlock(Word address, int16_t previous1, int16_t previous2, const ARAM& aram);
+		void advanceBlock(Voice& voice, size_t index, const ARAM& aram);
+		void runEnvelope(Voice& voice, size_t index);
+		int interpolate(const Voice& voice) const;
+		Word sampleDirectoryEntry(size_t index, Word offset, const ARAM& aram) const;
+	};
+} // namespace Blaze
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Blaze {
+	/**
+	 * Tracks which fixed-size blocks of a memory have been written to.
+	 *
+	 * Devices mark blocks as they're written; consumers (e.g. save states, tile caches, memory viewers)
+	 * can then only process the blocks that changed and clear the bitmap once they're done.
+	 */
+	class DirtyBitmap {
+		std::vector<uint64_t> _words;
+		size_t _blockCount = 0;
+		uint8_t _blockShift = 0;
+
+	public:
+		// `blockShift` is the base-2 logarithm of the block size (e.g. 8 for 256-byte blocks)
+		DirtyBitmap(size_t byteSize, uint8_t blockShift):
+			_blockShift(blockShift)
+		{
+			resize(byteSize);
+		};
+
+		void resize(size_t byteSize) {
+			_blockCount = (byteSize + blockSize() - 1) >> _blockShift;
+			_words.assign((_blockCount + 63) / 64, 0);
+		};
+
+		inline size_t blockSize() const {
+			return static_cast<size_t>(1) << _blockShift;
+		};
+
+		inline size_t blockCount() const {
+			return _blockCount;
+		};
+
+		// marks the block containing the given byte offset as dirty
+		inline void mark(size_t byteOffset) {
+			size_t block = byteOffset >> _blockShift;
+			_words[block / 64] |= static_cast<uint64_t>(1) << (block % 64);
+		};
+
+		inline bool test(size_t block) const {
+			return (_words[block / 64] & (static_cast<uint64_t>(1) << (block % 64))) != 0;
+		};
+
+		bool any() const {
+			for (auto word: _words) {
+				if (word != 0) {
+					return true;
+				}
+			}
+			return false;
+		};
+
+		void clear() {
+			std::fill(_words.begin(), _words.end(), 0);
+		};
+
+		inline void clear(size_t block) {
+			_words[block / 64] &= ~(static_cast<uint64_t>(1) << (block % 64));
+		};
+
+		// calls `callback(blockIndex)` for each dirty block, in ascending order
+		template<typename Callback>
+		void forEachDirty(Callback&& callback) const {
+			for (size_t wordIndex = 0; wordIndex < _words.size(); ++wordIndex) {
+				for (auto word = _words[wordIndex]; word != 0; word &= word - 1) {
+					size_t bit = 0;
+					while ((word & (static_cast<uint64_t>(1) << bit)) == 0) {
+						++bit;
+					}
+					callback((wordIndex * 64) + bit);
+				}
+			}
+		};
+	};
+} // namespace Blaze
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <blaze/MemTypes.hpp>
+
+#include <cstddef>
+
+namespace Blaze {
+	struct Bus;
+
+	/**
+	 * Spots when the CPU can't do anything useful until the next event (e.g. vblank or an interrupt):
+	 * when it's stopped, waiting for an interrupt (WAI), or spinning in a short polling loop.
+	 *
+	 * A polling loop is a short stretch of code that ends in a branch back to its start and only reads from memory
+	 * (which nothing but the CPU writes to) and from the interrupt status registers (RDNMI and HVBJOY), without
+	 * writing anything. Once two consecutive trips around such a loop leave the CPU in exactly the same state, every
+	 * trip after that will too, at least until an event changes what those reads return. Up to that point, the
+	 * loop can be skipped without changing anything the game could observe (other than how many times it ran).
+	 */
+	class IdleLoopDetector {
+	public:
+		// the longest loop (from its first byte to its final branch) that is checked for polling
+		static constexpr Address MAX_LOOP_SIZE = 16;
+
+		/**
+		 * Must be called after every instruction the CPU executes on `bus`.
+		 *
+		 * @returns `true` if the CPU is idle until the next event (in which case it's fine to skip ahead to it)
+		 */
+		bool check(Bus& bus);
+
+		void reset();
+
+	private:
+		struct CPUState {
+			Word A = 0;
+			Word X = 0;
+			Word Y = 0;
+			Word DR = 0;
+			Byte DBR = 0;
+			Byte P = 0;
+			Byte e = 0;
+
+			bool operator==(const CPUState& other) const;
+		};
+
+		static constexpr Address NO_LOOP = 0xffffffff;
+
+		// the loop the CPU was last seen going around (from its first byte to its final branch)
+		Address _loopStart = NO_LOOP;
+		Address _loopEnd = NO_LOOP;
+		CPUState _loopState;
+
+		// the last loop body that was decoded (and whether it turned out to be a polling loop)
+		Address _decodedStart = NO_LOOP;
+		Address _decodedEnd = NO_LOOP;
+		Byte _decodedFlags = 0;
+		bool _decodedIsPolling = false;
+
+		static CPUState captureState(const Bus& bus);
+		static bool isPollingLoop(Bus& bus, Address start, Address end);
+		static bool isStableSource(Bus& bus, Address address);
+	};
+} // namespace Blaze
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <blaze/MemTypes.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Instrumentation policies for the CPU and the bus.
+ *
+ * The CPU and the bus call a fixed set of hooks on their policy (`cpu.instrumentation`) as they run. Since the policy is a
+ * type and not a set of callbacks, the hooks of `None` compile to nothing at all, while the hooks of the other policies are
+ * inlined right into the CPU and the bus.
+ *
+ * The policy is picked when the core is built, by defining one of `BLAZE_INSTRUMENTATION_CONSOLE`, `BLAZE_INSTRUMENTATION_PROFILER`,
+ * `BLAZE_INSTRUMENTATION_TRACER`, or `BLAZE_INSTRUMENTATION_DEBUGGER` (or none of them, for no instrumentation at all).
+ */
+namespace Blaze::Instrumentation {
+	/**
+	 * No instrumentation at all.
+	 *
+	 * This is also the base of the other policies, so each of them only has to define the hooks it actually uses.
+	 */
+	struct None {
+		static constexpr Address NO_BREAKPOINT = UINT32_MAX;
+
+		// called right before the CPU executes the instruction at `address`
+		inline void beforeExecute(Address address) {};
+
+		// called for every access the CPU makes (but not for DMA)
+		inline void onRead(Address address, Byte bitSize) {};
+		inline void onWrite(Address address, Byte bitSize, Address value) {};
+
+		// called by the bus for any access to an address that isn't mapped to anything
+		inline void onInvalidAccess(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting) {};
+
+		// called for `WDM #$80` (see `CPU::CustomWDMOpcodes`)
+		inline void onPutCharacter(char character) {};
+
+		// whether whoever is running the CPU should pause before executing the instruction at `address`
+		inline bool atBreakpoint(Address address) const {
+			return false;
+		};
+
+		// only the debugger has a breakpoint; every other policy ignores this
+		inline void setBreakpoint(Address address) {};
+	};
+
+	/**
+	 * Only reports the things that rarely happen: invalid accesses and character output.
+	 *
+	 * None of these hooks are called for ordinary instructions or accesses, so this costs next to nothing. This is what
+	 * the GUI uses by default, and every other policy (except `None`) is based on it.
+	 */
+	struct Console: None {
+		std::function<void(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting)> invalidAccess = nullptr;
+		std::function<void(char character)> putCharacter = nullptr;
+
+		inline void onInvalidAccess(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting) {
+			if (invalidAccess) {
+				invalidAccess(address, bitSize, forWrite, valueWhenWriting);
+			}
+		};
+
+		inline void onPutCharacter(char character) {
+			if (putCharacter) {
+				putCharacter(character);
+			}
+		};
+	};
+
+	/**
+	 * Counts executed instructions and the accesses the CPU makes.
+	 */
+	struct Profiler: Console {
+		uint64_t instructions = 0;
+		uint64_t reads = 0;
+		uint64_t writes = 0;
+		uint64_t invalidAccesses = 0;
+
+		inline void beforeExecute(Address address) {
+			++instructions;
+		};
+
+		inline void onRead(Address address, Byte bitSize) {
+			++reads;
+		};
+
+		inline void onWrite(Address address, Byte bitSize, Address value) {
+			++writes;
+		};
+
+		inline void onInvalidAccess(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting) {
+			++invalidAccesses;
+			Console::onInvalidAccess(address, bitSize, forWrite, valueWhenWriting);
+		};
+	};
+
+	/**
+	 * Keeps the addresses of the last few instructions executed (e.g. to find out how the CPU ended up somewhere it shouldn't be).
+	 */
+	struct Tracer: Console {
+		static constexpr size_t HISTORY_SIZE = 256;
+
+		std::array<Address, HISTORY_SIZE> history {};
+
+		// how many instructions have been executed in total (only the last `HISTORY_SIZE` are kept in `history`)
+		uint64_t executed = 0;
+
+		inline void beforeExecute(Address address) {
+			history[executed % HISTORY_SIZE] = address;
+			++executed;
+		};
+
+		// the address of the `age`th most recent instruction (where 0 is the last one executed)
+		inline Address recent(size_t age) const {
+			return history[(executed - 1 - age) % HISTORY_SIZE];
+		};
+	};
+
+	/**
+	 * What the debugger needs: a breakpoint and watchpoints (on top of the console's hooks).
+	 */
+	struct Debugger: Console {
+		struct Watchpoint {
+			// inclusive on both ends
+			Address start = 0;
+			Address end = 0;
+			bool onRead = false;
+			bool onWrite = false;
+		};
+
+		Address breakpoint = NO_BREAKPOINT;
+		std::vector<Watchpoint> watchpoints;
+
+		std::function<void(Address address, bool forWrite, Address valueWhenWriting)> watchpointHit = nullptr;
+
+		inline void onRead(Address address, Byte bitSize) {
+			checkWatchpoints(address, bitSize, false, 0);
+		};
+
+		inline void onWrite(Address address, Byte bitSize, Address value) {
+			checkWatchpoints(address, bitSize, true, value);
+		};
+
+		inline bool atBreakpoint(Address address) const {
+			return address == breakpoint;
+		};
+
+		inline void setBreakpoint(Address address) {
+			breakpoint = address;
+		};
+
+	private:
+		inline void checkWatchpoints(Address address, Byte bitSize, bool forWrite, Address valueWhenWriting) {
+			Address last = address + (bitSize / 8) - 1;
+
+			for (const auto& watchpoint: watchpoints) {
+				if ((forWrite ? watchpoint.onWrite : watchpoint.onRead) && address <= watchpoint.end && last >= watchpoint.start && watchpointHit) {
+					watchpointHit(address, forWrite, valueWhenWriting);
+				}
+			}
+		};
+	};
+
+#if defined(BLAZE_INSTRUMENTATION_DEBUGGER)
+	using Active = Debugger;
+#elif defined(BLAZE_INSTRUMENTATION_TRACER)
+	using Active = Tracer;
+#elif defined(BLAZE_INSTRUMENTATION_PROFILER)
+	using Active = Profiler;
+#elif defined(BLAZE_INSTRUMENTATION_CONSOLE)
+	using Active = Console;
+#else
+	using Active = None;
+#endif
+} // namespace Blaze::Instrumentation
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <blaze/CPU.hpp>
+#include <blaze/MMIO.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Blaze {
+	/**
+	 * The CPU's interrupt logic: NMITIMEN ($4200), the H/V timer (HTIME and VTIME, $4207-$420A),
+	 * and the status registers RDNMI, TIMEUP, and HVBJOY ($4210-$4212).
+	 *
+	 * The scheduler drives this with the beam position (`beginScanline`, `advance`, and the vblank edges)
+	 * and the timer IRQ is scheduled ahead of time, so the scheduler only has to call `advance` once it reaches
+	 * `nextEvent`. NMI and IRQ are kept as line state here and only handed to the CPU by `service`,
+	 * which the scheduler calls between instructions; nothing calls into the CPU directly.
+	 */
+	class InterruptController: public MMIODevice {
+	public:
+		// offsets from $4200
+		struct Registers {
+			enum IgnoreMe: Address {
+				NMITIMEN = 0x00,
+				HTIMEL   = 0x07,
+				HTIMEH   = 0x08,
+				VTIMEL   = 0x09,
+				VTIMEH   = 0x0a,
+				RDNMI    = 0x10,
+				TIMEUP   = 0x11,
+				HVBJOY   = 0x12,
+			};
+		};
+
+		struct NMITIMENFlags {
+			enum IgnoreMe: Byte {
+				AUTO_JOYPAD = 1 << 0,
+				H_IRQ       = 1 << 4,
+				V_IRQ       = 1 << 5,
+				NMI         = 1 << 7,
+			};
+		};
+
+		// each dot (i.e. each H position) takes 4 master clock cycles
+		static constexpr uint64_t MASTER_CLOCKS_PER_DOT = 4;
+
+		// hblank starts at dot 274
+		static constexpr uint64_t HBLANK_START = 274 * MASTER_CLOCKS_PER_DOT;
+
+		static constexpr uint64_t NO_EVENT = UINT64_MAX;
+
+		// the automatic joypad read takes a little over 3 scanlines (4224 master clock cycles)
+		static constexpr uint16_t AUTO_JOYPAD_READ_SCANLINES = 3;
+
+		InterruptController() = default;
+
+		Address read(Address offset, Byte bitSize) override;
+		void write(Address offset, Byte bitSize, Address value) override;
+
+		void reset(Bus* bus) override;
+
+		void copyStateFrom(const InterruptController& other);
+
+		// called by the scheduler at the start of every scanline
+		void beginScanline(uint16_t scanline);
+
+		void beginVBlank();
+		void endVBlank();
+
+		// the PPU keeps the vblank flag set for as long as forced blanking is on
+		void setForcedBlanking(bool forcedBlanking);
+
+		/**
+		 * The position (in master clock cycles since the start of the current scanline) at which the next timer
+		 * event happens, or `NO_EVENT` if there aren't any more events on this scanline.
+		 */
+		inline uint64_t nextEvent() const {
+			return _nextEvent;
+		};
+
+		// moves the position within the current scanline forward (in master clock cycles), firing any events it passes
+		inline void advance(uint64_t position) {
+			_position = position;
+
+			if (_position >= _nextEvent) {
+				fireTimer();
+			}
+		};
+
+		// whether the joypads should be read automatically at the start of vblank
+		inline bool autoJoypadRead() const {
+			return (_nmitimen & NMITIMENFlags::AUTO_JOYPAD) != 0;
+		};
+
+		// called by the scheduler when the automatic joypad read starts; HVBJOY shows it as busy for the next few scanlines
+		void beginAutoJoypadRead();
+
+		inline bool nmiPending() const {
+			return _nmiPending.load(std::memory_order_acquire);
+		};
+
+		inline bool irqAsserted() const {
+			return _irqLine.load(std::memory_order_acquire);
+		};
+
+		// hands pending interrupts to the CPU. NMIs are edge-triggered (they're delivered once), while IRQs are
+		// level-triggered (they're delivered for as long as the line is asserted and the CPU doesn't mask them).
+		void service(CPU& cpu);
+
+	private:
+		Byte _nmitimen = 0;
+		Word _htime = 0x1ff;
+		Word _vtime = 0x1ff;
+		bool _vblank = false;
+		bool _vblankFlag = false;
+		bool _forcedBlanking = false;
+
+		uint16_t _scanline = 0;
+		uint64_t _position = 0;
+		uint64_t _nextEvent = NO_EVENT;
+		bool _timerFired = false;
+
+		// how many more scanlines (including the current one) the automatic joypad read is busy for
+		uint16_t _autoJoypadReadScanlines = 0;
+
+		std::atomic<bool> _nmiPending {false};
+
+		// this doubles as the TIMEUP flag
+		std::atomic<bool> _irqLine {false};
+
+		void raiseVBlankFlag();
+		void scheduleTimer();
+		void fireTimer();
+	};
+} // namespace Blaze
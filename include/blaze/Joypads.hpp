@@ -0,0 +1,73 @@
+#pragma once
+
+#include <blaze/MMIO.hpp>
+
+#include <array>
+
+namespace Blaze {
+	/**
+	 * The results of the automatic joypad read: JOY1L through JOY4H ($4218-$421F).
+	 *
+	 * Whoever drives the machine sets which buttons are held on each port (`setButtons`); the registers only
+	 * pick that up when the automatic read happens at the start of vblank (see `Scheduler`), like on the real hardware.
+	 */
+	class Joypads: public MMIODevice {
+	public:
+		static constexpr size_t PORT_COUNT = 4;
+
+		// offsets from $4200
+		struct Registers {
+			enum IgnoreMe: Address {
+				JOY1L = 0x18,
+				JOY1H = 0x19,
+				JOY2L = 0x1a,
+				JOY2H = 0x1b,
+				JOY3L = 0x1c,
+				JOY3H = 0x1d,
+				JOY4L = 0x1e,
+				JOY4H = 0x1f,
+			};
+		};
+
+		// the bits of a standard controller, as they show up in JOYxL (low byte) and JOYxH (high byte)
+		struct Buttons {
+			enum IgnoreMe: Word {
+				R      = 1 << 4,
+				L      = 1 << 5,
+				X      = 1 << 6,
+				A      = 1 << 7,
+				RIGHT  = 1 << 8,
+				LEFT   = 1 << 9,
+				DOWN   = 1 << 10,
+				UP     = 1 << 11,
+				START  = 1 << 12,
+				SELECT = 1 << 13,
+				Y      = 1 << 14,
+				B      = 1 << 15,
+			};
+		};
+
+	private:
+		std::array<Word, PORT_COUNT> _buttons {};
+		std::array<Word, PORT_COUNT> _latched {};
+
+	public:
+		Byte registerSize(Address offset, Byte attemptedAccessSize) override;
+		Address read(Address offset, Byte bitSize) override;
+		void write(Address offset, Byte bitSize, Address value) override;
+
+		void reset(Bus* bus) override;
+
+		// the buttons currently held on `port` (a combination of `Buttons`)
+		inline void setButtons(size_t port, Word buttons) {
+			_buttons[port] = buttons;
+		};
+
+		inline Word buttons(size_t port) const {
+			return _buttons[port];
+		};
+
+		// the automatic joypad read: copies the buttons that are held right now into the registers
+		void autoRead();
+	};
+} // namespace Blaze
@@ -2,6 +2,8 @@
 
 #include <blaze/MemTypes.hpp>
 
+#include <memory>
+
 namespace Blaze {
 	struct Bus;
 
@@ -16,5 +18,9 @@ namespace Blaze {
 		virtual void write(Address offset, Byte bitSize, Address value) = 0;
 
 		virtual void reset(Bus* bus) = 0;
+
+		// creates a copy of this device (attached to the given bus) for a forked machine.
+		// devices that can't be forked return `nullptr`, which leaves them disconnected in the fork.
+		virtual std::unique_ptr<MMIODevice> fork(Bus* bus);
 	};
 } // namespace Blaze
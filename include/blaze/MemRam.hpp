@@ -2,13 +2,25 @@
 
 #include <blaze/MemTypes.hpp>
 #include <blaze/MMIO.hpp>
-#include <array>
+#include <blaze/PagedMemory.hpp>
+#include <blaze/DirtyBitmap.hpp>
 
 namespace Blaze {
 	class MemRam: public MMIODevice {
+	public:
 		static constexpr uint32_t MEM_SIZE = 1024 * 128;
 
-		std::array<Byte, MEM_SIZE> data;
+		// RAM is stored as a set of fixed-size pages so that multiple machines can share
+		// the pages they haven't written to yet (copy-on-write).
+		static constexpr uint32_t PAGE_SIZE = 1024 * 4;
+		static constexpr uint32_t PAGE_COUNT = MEM_SIZE / PAGE_SIZE;
+
+		// writes are tracked in 256-byte blocks
+		static constexpr uint8_t DIRTY_BLOCK_SHIFT = 8;
+
+	private:
+		PagedMemory<Byte, PAGE_SIZE> _data = PagedMemory<Byte, PAGE_SIZE>(MEM_SIZE);
+		DirtyBitmap _dirty = DirtyBitmap(MEM_SIZE, DIRTY_BLOCK_SHIFT);
 
 	public:
 		MemRam();
@@ -18,5 +30,31 @@ namespace Blaze {
 		void write(Address offset, Byte bitSize, Address value) override;
 
 		void reset(Bus* bus) override;
+
+		/**
+		 * Makes this RAM share all of its pages with `other`.
+		 *
+		 * No data is copied here; a page is only copied once either RAM writes to it.
+		 */
+		void shareFrom(const MemRam& other);
+
+		// the number of pages that are currently shared with at least one other RAM
+		uint32_t sharedPageCount() const;
+
+		inline const PagedMemory<Byte, PAGE_SIZE>& memory() const {
+			return _data;
+		};
+		// for the bus's direct accesses; anything written through this has to be marked in `dirtyBlocks`, too
+		inline PagedMemory<Byte, PAGE_SIZE>& memory() {
+			return _data;
+		};
+
+		// the blocks that have been written to since the bitmap was last cleared
+		inline DirtyBitmap& dirtyBlocks() {
+			return _dirty;
+		};
+		inline const DirtyBitmap& dirtyBlocks() const {
+			return _dirty;
+		};
 	};
 } // namespace Blaze
@@ -3,14 +3,24 @@
 #include <blaze/MMIO.hpp>
 
 namespace Blaze {
-	static constexpr Address MULDIV_BLOCK1_START = 0x4202;
-	static constexpr Address MULDIV_BLOCK1_END = 0x4206;
-	static constexpr Address MULDIV_BLOCK1_OFFSET_BEGIN = 0;
-	static constexpr Address MULDIV_BLOCK2_START = 0x4214;
-	static constexpr Address MULDIV_BLOCK2_END = 0x4217;
-	static constexpr Address MULDIV_BLOCK2_OFFSET_BEGIN = 5;
-
 	class MulDiv: public MMIODevice {
+	public:
+		// offsets from $4200
+		struct Registers {
+			enum IgnoreMe: Address {
+				WRMPYA = 0x02,
+				WRMPYB = 0x03,
+				WRDIVL = 0x04,
+				WRDIVH = 0x05,
+				WRDIVB = 0x06,
+				RDDIVL = 0x14,
+				RDDIVH = 0x15,
+				RDMPYL = 0x16,
+				RDMPYH = 0x17,
+			};
+		};
+
+	private:
 		Byte _mulA = 0xff;
 		Byte _mulB = 0xff;
 		Word _dividend = 0xffff;
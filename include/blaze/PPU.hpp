@@ -3,24 +3,98 @@
 #include <blaze/MMIO.hpp>
 #include <blaze/util.hpp>
 #include <blaze/color.hpp>
+#include <blaze/PagedMemory.hpp>
+#include <blaze/DirtyBitmap.hpp>
+#include <blaze/WindowMask.hpp>
+#include <blaze/ThreadPool.hpp>
 
 #include <mutex>
 #include <array>
+#include <atomic>
+#include <vector>
 #include <functional>
-
-// forward declarations
-struct SDL_Renderer;
-struct SDL_Surface;
+#include <thread>
+#include <condition_variable>
 
 namespace Blaze {
 	struct Bus;
 
-	static constexpr Address PPU_SPECIAL_OFFSET_NMITIMEN = 0xffff00;
-	static constexpr Address PPU_SPECIAL_OFFSET_RDNMI = 0xffff80;
+	/**
+	 * The PPU's register state (everything except the backgrounds' registers and the memories).
+	 *
+	 * This is kept separate from the PPU so that forking can copy it all at once.
+	 */
+	struct PPURegisterState {
+		Byte _inidisp = 0;
+		Byte _objsel = 0;
+		Word _oamByteAddress = 0;
+		Byte _oamLatch = 0;
+		Byte _bgmode = 0;
+		Byte _mosaic = 0;
+		Byte _vmain = 0;
+		Word _vramWordAddress = 0;
+		Word _vramLatch = 0;
+		Byte _cgramWordAddress = 0;
+		Byte _cgramLatch = 0;
+		Byte _window1Left = 0;
+		Byte _window1Right = 0;
+		Byte _window2Left = 0;
+		Byte _window2Right = 0;
+		WindowMask::Logic _spriteWindowMaskLogic = WindowMask::Logic::OR;
+		WindowMask::Logic _colorWindowMaskLogic = WindowMask::Logic::OR;
+		Byte _cgwsel = 0;
+		Byte _fixedBlue = 0;
+		Byte _fixedGreen = 0;
+		Byte _fixedRed = 0;
+		Byte _setini = 0;
+		Byte _bgScrollLatch = 0;
+		Byte _bgHorizontalScrollLatch = 0;
+
+		// mode 7 registers; the matrix is 1.7.8 fixed point, the rest are 13-bit signed values
+		Byte _mode7Settings = 0;
+		Byte _mode7Latch = 0;
+		Word _mode7A = 0;
+		Word _mode7B = 0;
+		Word _mode7C = 0;
+		Word _mode7D = 0;
+		Word _mode7CenterX = 0;
+		Word _mode7CenterY = 0;
+		Word _mode7HorizontalScroll = 0;
+		Word _mode7VerticalScroll = 0;
+		bool _cgramHighByte: 1;
+		bool _enableSpriteWindow1: 1;
+		bool _invertSpriteWindow1: 1;
+		bool _enableSpriteWindow2: 1;
+		bool _invertSpriteWindow2: 1;
+		bool _enableColorWindow1: 1;
+		bool _invertColorWindow1: 1;
+		bool _enableColorWindow2: 1;
+		bool _invertColorWindow2: 1;
+		bool _enableSpriteOnMainScreen: 1;
+		bool _enableSpriteOnSubscreen: 1;
+		bool _enableSpriteWindowsOnMainScreen: 1;
+		bool _enableSpriteWindowsOnSubscreen: 1;
+		bool _enableSpriteColorMath: 1;
+		bool _colorMathMinus: 1;
+		bool _halfColorMath: 1;
+		bool _enableBackdropColorMath: 1;
+		bool _oamPriorityRotation: 1;
+		bool _spriteRangeOver: 1;
+		bool _spriteTimeOver: 1;
+	};
 
 	// note that anything labeled "word address" means it's an address where each increment is a word (16 bits), not a byte.
-	class PPU: public MMIODevice {
+	class PPU: public MMIODevice, private PPURegisterState {
 	public:
+		// VRAM is paged (in 2 KiB pages) so that forked machines can share it copy-on-write
+		using VRAM = PagedMemory<Word, 1024>;
+		static constexpr size_t VRAM_WORDS = 32 * 1024;
+
+		// VRAM writes are tracked in 1 KiB blocks, CGRAM and OAM writes in 256-byte blocks
+		static constexpr uint8_t VRAM_DIRTY_BLOCK_SHIFT = 10;
+		static constexpr uint8_t CGRAM_DIRTY_BLOCK_SHIFT = 8;
+		static constexpr uint8_t OAM_DIRTY_BLOCK_SHIFT = 8;
+
 		enum class AddressRemapping: Byte {
 			NoRemap = 0,
 			_2bpp   = 1,
@@ -33,12 +107,7 @@ namespace Blaze {
 			High = true,
 		};
 
-		enum class WindowMaskLogic: Byte {
-			OR = 0,
-			AND = 1,
-			XOR = 2,
-			XNOR = 3,
-		};
+		using WindowMaskLogic = WindowMask::Logic;
 
 		enum class SpriteSize: Byte {
 			_8x8And16x16 = 0,
@@ -130,7 +199,53 @@ namespace Blaze {
 			bool flipHorizontally: 1;
 		};
 
+		static constexpr size_t LINE_WIDTH = 256;
+		static constexpr size_t FRAME_HEIGHT = 224;
+
+		// a whole frame of packed RGBA8888 pixels, row by row
+		using Frame = std::array<uint32_t, LINE_WIDTH * FRAME_HEIGHT>;
+		using FrameListener = std::function<void(const Frame& frame)>;
+
+		// layers 0-3 are the backgrounds
+		static constexpr Byte LAYER_OBJ = 4;
+		static constexpr Byte LAYER_BACKDROP = 5;
+
+		// only used for window masks (since the backdrop never gets a window of its own)
+		static constexpr Byte LAYER_COLOR_WINDOW = 5;
+
+		struct LayerSlot {
+			Byte layer;
+			Byte priority;
+		};
+
+		// a single line of a single layer
+		struct LayerLine {
+			std::array<uint32_t, LINE_WIDTH> color {};
+
+			// 0 means the pixel is transparent; otherwise, it's the pixel's priority plus one
+			std::array<Byte, LINE_WIDTH> priority {};
+
+			// only used by the sprite layer: whether the pixel can participate in color math
+			std::array<bool, LINE_WIDTH> colorMath {};
+		};
+
 	private:
+		// everything needed to compose a single scanline
+		struct ScanlineBuffers {
+			std::array<LayerLine, 5> layers;
+			std::array<uint32_t, LINE_WIDTH> main {};
+			std::array<uint32_t, LINE_WIDTH> sub {};
+			std::array<Byte, LINE_WIDTH> mainSource {};
+			std::array<Byte, LINE_WIDTH> subSource {};
+
+			// the pixels of each layer that aren't hidden by its window on the screen being composed (0 or 0xffffffff)
+			std::array<std::array<uint32_t, LINE_WIDTH>, 5> visible {};
+
+			// color math masks (0 or 0xffffffff; see `ColorMath::apply`)
+			std::array<uint32_t, LINE_WIDTH> enable {};
+			std::array<uint32_t, LINE_WIDTH> half {};
+		};
+
 		struct Background {
 			Byte tilemapAddressAndSize = 0;
 			Byte nba = 0;
@@ -148,15 +263,8 @@ namespace Blaze {
 			bool enableWindowsOnMainScreen: 1;
 			bool enableWindowsOnSubscreen: 1;
 			bool enableColorMath: 1;
-			SDL_Surface* _surface = nullptr;
 
 			Background();
-			~Background();
-
-			Background(const Background&) = delete;
-			Background(Background&&) = delete;
-			Background& operator=(const Background&) = delete;
-			Background& operator=(Background&&) = delete;
 
 			inline Word tilemapWordAddress() const {
 				return static_cast<Word>((tilemapAddressAndSize >> 2) & 0x3f) << 10;
@@ -175,75 +283,155 @@ namespace Blaze {
 			};
 
 			void reset();
-			void render(SDL_Renderer* renderer, const Word* vram, const Word* cgram, bool highPriority, Byte backgroundIndex, PPU& ppu);
+
+			// renders the visible part of a single line of this background (at the current scroll)
+			void renderLine(size_t line, const VRAM& vram, const uint32_t* palette, Byte backgroundIndex, PPU& ppu, LayerLine& output);
 		};
 
 		Bus* _bus = nullptr;
 
-		Byte _inidisp = 0;
-		Byte _objsel = 0;
-		Word _oamByteAddress = 0;
-		Byte _oamLatch = 0;
-		Byte _bgmode = 0;
-		Byte _mosaic = 0;
-		Byte _vmain = 0;
-		Word _vramWordAddress = 0;
-		Word _vramLatch = 0;
-		Byte _cgramWordAddress = 0;
-		Byte _cgramLatch = 0;
-		Byte _window1Left = 0;
-		Byte _window1Right = 0;
-		Byte _window2Left = 0;
-		Byte _window2Right = 0;
-		WindowMaskLogic _spriteWindowMaskLogic = WindowMaskLogic::OR;
-		WindowMaskLogic _colorWindowMaskLogic = WindowMaskLogic::OR;
-		Byte _cgwsel = 0;
-		Byte _fixedBlue = 0;
-		Byte _fixedGreen = 0;
-		Byte _fixedRed = 0;
-		Byte _setini = 0;
-		Byte _bgScrollLatch = 0;
-		Byte _bgHorizontalScrollLatch = 0;
-		Byte _nmitimen = 0;
-		Byte _rdnmi = 0;
-		bool _cgramHighByte: 1;
-		bool _enableSpriteWindow1: 1;
-		bool _invertSpriteWindow1: 1;
-		bool _enableSpriteWindow2: 1;
-		bool _invertSpriteWindow2: 1;
-		bool _enableColorWindow1: 1;
-		bool _invertColorWindow1: 1;
-		bool _enableColorWindow2: 1;
-		bool _invertColorWindow2: 1;
-		bool _enableSpriteOnMainScreen: 1;
-		bool _enableSpriteOnSubscreen: 1;
-		bool _enableSpriteWindowsOnMainScreen: 1;
-		bool _enableSpriteWindowsOnSubscreen: 1;
-		bool _enableSpriteColorMath: 1;
-		bool _colorMathMinus: 1;
-		bool _halfColorMath: 1;
-		bool _enableBackdropColorMath: 1;
-		bool _oamPriorityRotation: 1;
-
 		std::array<Background, 4> _backgrounds;
 		std::array<Byte, 544> _oamData;
 		std::array<Word, 256> _cgram;
-		std::array<Word, 32 * 1024> _vram;
-
-		std::mutex _rdnmiMutex;
 
-		SDL_Renderer* _renderer = nullptr;
-		SDL_Renderer* _backbufferRenderer = nullptr;
+		// CGRAM converted into RGBA8888 pixels; kept up-to-date by CGRAM writes. colors are always converted at full brightness,
+		// since the screen brightness only applies to the final output (after color math; see `renderScanline`)
+		std::shared_ptr<const ColorTable> _colorTable = ColorTable::shared(ColorTable::MAX_BRIGHTNESS);
+		std::array<uint32_t, 256> _palette;
+		VRAM _vram = VRAM(VRAM_WORDS);
+
+		// all of these are indexed by byte offset
+		DirtyBitmap _vramDirty = DirtyBitmap(VRAM_WORDS * 2, VRAM_DIRTY_BLOCK_SHIFT);
+		DirtyBitmap _cgramDirty = DirtyBitmap(256 * 2, CGRAM_DIRTY_BLOCK_SHIFT);
+		DirtyBitmap _oamDirty = DirtyBitmap(544, OAM_DIRTY_BLOCK_SHIFT);
+
+		static constexpr Byte FRAME_BUFFER_COUNT = 3;
+		static constexpr Byte FRAME_INDEX_MASK = 0x03;
+		static constexpr Byte FRAME_FRESH = 0x80;
+
+		// triple buffering: the renderer draws into one frame while the presenter reads another, and the third is the most recently
+		// finished frame. the renderer and the presenter each swap their frame with the finished one atomically, so neither ever waits
+		// on the other. `_readyFrame` is marked fresh when the renderer puts a new frame there (and the mark is dropped by the presenter).
+		std::vector<Frame> _frames = std::vector<Frame>(FRAME_BUFFER_COUNT);
+		Byte _drawingFrame = 0;
+		Byte _presentingFrame = 1;
+		std::atomic<Byte> _readyFrame {2 | FRAME_FRESH};
+		FrameListener _frameListener;
+
+		static constexpr size_t SPRITE_COUNT = 128;
+		static constexpr size_t MAX_SPRITES_PER_LINE = 32;
+		static constexpr size_t MAX_SPRITE_TILES_PER_LINE = 34;
+		static constexpr size_t MAX_LINES = 240;
+
+		// OAM decoded into structure-of-arrays form. this is kept up-to-date by OAM writes
+		// so that sprite evaluation doesn't have to unpack the OAM bitfields every frame.
+		struct SpriteTable {
+			std::array<int16_t, SPRITE_COUNT> x {};
+			std::array<Byte, SPRITE_COUNT> y {};
+			std::array<Byte, SPRITE_COUNT> tileIndex {};
+			std::array<Byte, SPRITE_COUNT> paletteGroup {};
+			std::array<Byte, SPRITE_COUNT> priority {};
+			std::array<bool, SPRITE_COUNT> large {};
+			std::array<bool, SPRITE_COUNT> secondTilePage {};
+			std::array<bool, SPRITE_COUNT> flipVertically {};
+			std::array<bool, SPRITE_COUNT> flipHorizontally {};
+		};
+
+		// the sprites that will be drawn on a single line, in OAM priority order (first = topmost)
+		struct SpriteLine {
+			std::array<Byte, MAX_SPRITES_PER_LINE> sprites {};
+			Byte count = 0;
+		};
+
+		SpriteTable _spriteTable;
+		std::array<SpriteLine, MAX_LINES> _spriteLines;
+
+		void updatePalette();
+		void updateSprite(Byte index);
+
+		// bands shorter than this aren't worth handing off to another thread
+		static constexpr size_t MIN_BAND_LINES = 16;
+		static constexpr unsigned MAX_BAND_WORKERS = 4;
+
+		// one set of line buffers per band worker
+		std::vector<ScanlineBuffers> _lineBuffers = std::vector<ScanlineBuffers>(1);
+		std::unique_ptr<ThreadPool> _bandPool;
+
+		// lines that have been reached but not rendered yet. nothing that affects rendering has changed since the first
+		// of them was reached, so they can all be rendered together (in parallel) once something does change.
+		size_t _pendingFirstLine = 0;
+		size_t _pendingLineCount = 0;
+
+		// frame skipping (for fast-forward); only the main PPU decides which frames to skip, the render thread's copy just follows along
+		std::atomic<unsigned> _frameSkip {0};
+		unsigned _skippedFrames = 0;
+		bool _skippingFrame = false;
+
+		void flushLines();
+
+		// forks start out without any frames or line buffers; they're only allocated once something is actually rendered
+		void allocateRenderBuffers();
+
+		// for `fork`: leaves out everything that the fork copies from its parent (or only needs once it renders)
+		struct ForkTag {};
+		explicit PPU(ForkTag);
+
+		// the window masks for each layer (plus the color window), rebuilt whenever a window register changes
+		std::array<WindowMask, 6> _windowMasks;
+		bool _windowMasksDirty = true;
+
+		static WindowMask layerWindowMask(const WindowMask& window1, const WindowMask& window2, bool enable1, bool invert1, bool enable2, bool invert2, WindowMaskLogic logic);
+		void updateWindowMasks();
+
+		// the pixels of the current line that are in `region` of the color window
+		WindowMask colorRegionMask(ColorRegion region) const;
+
+		void evaluateSprites();
+		void renderSpriteLine(size_t line, LayerLine& output);
+
+		// renders mode 7's BG1 and (if EXTBG is enabled) BG2
+		void renderMode7Line(size_t line, LayerLine& background1, LayerLine* background2);
+		void composeScreen(ScanlineBuffers& buffers, bool subscreen, uint32_t backdrop, uint32_t* output, Byte* source);
+		void renderScanline(size_t line, ScanlineBuffers& buffers);
+
+		// hands the frame that was just finished over to the presenter
+		void presentFrame();
+
+		enum class CommandType: Byte {
+			Read,
+			Write,
+			Reset,
+			EndVBlank,
+			Scanline,
+			BeginVBlank,
+		};
+
+		// a single entry in the log recorded for the render thread. for reads and writes, `offset` is the register;
+		// for scanlines, it's the line number.
+		struct Command {
+			CommandType type;
+			Address offset;
+			Address value;
+		};
+
+		// with asynchronous rendering enabled, this is the PPU that the render thread replays the command log on.
+		// it renders into *our* backbuffer (i.e. its `_output` is us).
+		std::unique_ptr<PPU> _shadow;
+		PPU* _output = this;
 
-		mutable std::mutex _renderTextureMutex;
-		bool _swapped = true;
-		SDL_Surface* _renderSurface;
-		SDL_Surface* _renderBackbuffer;
+		std::thread _renderThread;
+		std::mutex _renderQueueMutex;
+		std::condition_variable _renderQueueCondVar;
+		bool _frameQueued = false;
+		bool _stopRenderThread = false;
 
-		Byte* _tileBuffer = nullptr;
-		Byte* _tilePixelBuffer = nullptr;
+		// the commands for the frame currently being emulated, the frame waiting for the render thread, and the frame being rendered
+		std::vector<Command> _commands;
+		std::vector<Command> _queuedCommands;
+		std::vector<Command> _replayCommands;
 
-		void renderSpriteLayer(Byte priority);
+		void renderThreadMain();
+		void replay(const Command& command);
 
 	public:
 		inline Byte addressIncrementAmountInWords() const {
@@ -280,6 +468,19 @@ namespace Blaze {
 			return (_setini & (1 << 6)) != 0;
 		};
 
+		inline bool mode7FlipHorizontally() const {
+			return (_mode7Settings & (1 << 0)) != 0;
+		};
+
+		inline bool mode7FlipVertically() const {
+			return (_mode7Settings & (1 << 1)) != 0;
+		};
+
+		// what to show outside of the 1024x1024 playfield: 0/1 = wrap around, 2 = transparent, 3 = tile 0
+		inline Byte mode7ScreenOver() const {
+			return (_mode7Settings >> 6) & 3;
+		};
+
 		inline bool externalSync() const {
 			return (_setini & (1 << 7)) != 0;
 		};
@@ -348,25 +549,80 @@ namespace Blaze {
 		void write(Address offset, Byte bitSize, Address value) override;
 
 		void reset(Bus* bus) override;
+		std::unique_ptr<MMIODevice> fork(Bus* bus) override;
+
+		inline const VRAM& vram() const {
+			return _vram;
+		};
+
+		// the blocks of each memory that have been written to since the bitmap was last cleared
+		inline DirtyBitmap& vramDirtyBlocks() {
+			return _vramDirty;
+		};
+		inline DirtyBitmap& cgramDirtyBlocks() {
+			return _cgramDirty;
+		};
+		inline DirtyBitmap& oamDirtyBlocks() {
+			return _oamDirty;
+		};
 
 		void beginVBlank();
 		void endVBlank();
 
+		// called at the start of every scanline (after `endVBlank` for the first one); visible lines get rendered here
+		void beginScanline(size_t line);
+
+		/**
+		 * Sets a function to call with every frame that gets rendered (i.e. every frame that isn't skipped), right before it's presented.
+		 *
+		 * The listener is called on whichever thread renders the frame (the render thread when rendering asynchronously), so it should
+		 * be quick about it. This must be set before any frames are rendered.
+		 */
+		inline void setFrameListener(FrameListener listener) {
+			_frameListener = std::move(listener);
+		};
+
+		/**
+		 * Only renders one out of every `frameSkip + 1` frames.
+		 *
+		 * Skipped frames are still emulated (vblank flags, sprite evaluation, latches, etc.), but they're never rasterized or presented.
+		 * This can be changed from any thread; it takes effect at the start of the next frame.
+		 */
+		inline void setFrameSkip(unsigned frameSkip) {
+			_frameSkip.store(frameSkip, std::memory_order_relaxed);
+		};
+
+		/**
+		 * Moves rendering onto a separate thread.
+		 *
+		 * With asynchronous rendering, every register access is recorded (along with the scanline and vblank boundaries) and
+		 * handed over to a render thread at the start of vblank. The render thread replays the log on its own copy of the PPU,
+		 * so it can rasterize one frame while the CPU thread emulates the next. The output is identical to synchronous rendering.
+		 */
+		void setAsyncRendering(bool enable);
+
+		inline bool asyncRendering() const {
+			return _shadow != nullptr;
+		};
+
 		inline bool overscan() const {
 			return (_setini & (1 << 2)) != 0;
 		};
 
-		inline void renderSurface(std::function<void(SDL_Surface* surface)> renderer) {
-			std::unique_lock lock(_renderTextureMutex);
-			if (_swapped) {
-				_swapped = false;
-				renderer(_renderSurface);
+		// the most recently finished frame, or `nullptr` if no new frame has been finished since the last call.
+		// the returned frame stays valid (and unmodified) until the next call. this must only be called from one thread at a time.
+		inline const Frame* latestFrame() {
+			if ((_readyFrame.load(std::memory_order_acquire) & FRAME_FRESH) == 0) {
+				return nullptr;
 			}
+
+			_presentingFrame = _readyFrame.exchange(_presentingFrame, std::memory_order_acq_rel) & FRAME_INDEX_MASK;
+			return &_frames[_presentingFrame];
 		};
 
-		size_t readTile(const Word* vram, Word vramWordAddress, Byte width, Byte height, TileFormat format);
-		static Color readColor(const Word* cgram, Byte index);
+		// decodes a single row of pixels of a tile into `output` (which must have room for `width` pixels)
+		static void readTileRow(const VRAM& vram, Word vramWordAddress, Byte width, Byte row, TileFormat format, Byte* output);
 		static Sprite readSprite(const Byte* oam, Byte index);
-		static TilemapEntry readTilemapEntry(const Word* vram, Word tilemapBaseWordAddress, Byte x, Byte y);
+		static TilemapEntry readTilemapEntry(const VRAM& vram, Word tilemapBaseWordAddress, Byte x, Byte y);
 	};
 };
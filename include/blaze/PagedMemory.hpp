@@ -0,0 +1,123 @@
+#pragma once
+
+#include <blaze/MemTypes.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace Blaze {
+	/**
+	 * A block of memory split into fixed-size pages that can be shared between multiple owners.
+	 *
+	 * Sharing is copy-on-write: owners share a page until one of them writes to it, at which
+	 * point the writer gets its own copy of that page.
+	 */
+	template<typename T, size_t PageSize>
+	class PagedMemory {
+		static_assert((PageSize & (PageSize - 1)) == 0, "page size must be a power of 2");
+
+	public:
+		static constexpr size_t PAGE_SIZE = PageSize;
+
+	private:
+		using Page = std::array<T, PageSize>;
+
+		std::vector<std::shared_ptr<Page>> _pages;
+		size_t _size = 0;
+
+		Page& writablePage(size_t pageIndex) {
+			auto& page = _pages[pageIndex];
+
+			if (page.use_count() > 1) {
+				// someone else is still using this page, so we need our own copy before we can modify it
+				page = std::make_shared<Page>(*page);
+			}
+
+			return *page;
+		};
+
+	public:
+		explicit PagedMemory(size_t size = 0) {
+			resize(size);
+		};
+
+		inline size_t size() const {
+			return _size;
+		};
+
+		inline size_t pageCount() const {
+			return _pages.size();
+		};
+
+		// the contents of a single page (only the first `size() - (pageIndex * PageSize)` elements of the last page are in use)
+		inline const T* pageData(size_t pageIndex) const {
+			return _pages[pageIndex]->data();
+		};
+
+		// resizes the memory; any newly added elements are zero-initialized
+		void resize(size_t size) {
+			_size = size;
+			_pages.resize((size + PageSize - 1) / PageSize);
+
+			for (auto& page: _pages) {
+				if (!page) {
+					page = std::make_shared<Page>();
+				}
+			}
+		};
+
+		inline T read(size_t index) const {
+			return (*_pages[index / PageSize])[index % PageSize];
+		};
+
+		inline T operator[](size_t index) const {
+			return read(index);
+		};
+
+		inline void write(size_t index, T value) {
+			writablePage(index / PageSize)[index % PageSize] = value;
+		};
+
+		void fill(T value) {
+			for (auto& page: _pages) {
+				if (page.use_count() > 1) {
+					// don't modify pages that are still shared; just drop our reference to them
+					page = std::make_shared<Page>();
+				}
+				page->fill(value);
+			}
+		};
+
+		// makes this memory share all of its pages with `other`. no data is copied here.
+		void shareFrom(const PagedMemory& other) {
+			_pages = other._pages;
+			_size = other._size;
+		};
+
+		// makes this memory a copy of `other` that doesn't share any pages with it (e.g. for an owner on another thread,
+		// where checking whether a page is shared would race with the other owner copying it)
+		void copyFrom(const PagedMemory& other) {
+			_pages.resize(other._pages.size());
+			_size = other._size;
+
+			for (size_t i = 0; i < _pages.size(); ++i) {
+				_pages[i] = std::make_shared<Page>(*other._pages[i]);
+			}
+		};
+
+		// the number of pages that are currently shared with at least one other owner
+		size_t sharedPageCount() const {
+			size_t count = 0;
+
+			for (const auto& page: _pages) {
+				if (page.use_count() > 1) {
+					++count;
+				}
+			}
+
+			return count;
+		};
+	};
+} // namespace Blaze
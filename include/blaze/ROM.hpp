@@ -6,6 +6,7 @@
 #include <string>
 #include <array>
 #include <vector>
+#include <memory>
 
 namespace Blaze {
 	class ROM: public MMIODevice {
@@ -54,7 +55,8 @@ namespace Blaze {
 		};
 
 	private:
-		std::vector<Byte> _memory;
+		// the ROM image is never modified after loading, so it can be shared between machines
+		std::shared_ptr<const std::vector<Byte>> _memory;
 		Type _type = Type::INVALID;
 		Bus* _bus = nullptr;
 
@@ -68,6 +70,13 @@ namespace Blaze {
 
 		void load(const std::string& path);
 
+		// makes this ROM use the same (already loaded) image as `other` without copying it
+		void shareFrom(const ROM& other);
+
+		// the `byteCount` bytes starting at `offset` (which is mirrored the same way reads are), or `nullptr`
+		// if no ROM is loaded or those bytes aren't all in the image
+		const Byte* data(Address offset, size_t byteCount) const;
+
 		Byte registerSize(Address offset, Byte attemptedAccessSize) override;
 		Address read(Address offset, Byte bitSize) override;
 		void write(Address offset, Byte bitSize, Address value) override;
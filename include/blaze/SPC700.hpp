@@ -0,0 +1,167 @@
+#pragma once
+
+#include <blaze/MemTypes.hpp>
+#include <blaze/DSP.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace Blaze {
+	/**
+	 * The S-SMP: the SPC700 CPU inside the APU, along with its 64 KiB of RAM (ARAM), its timers,
+	 * the IPL boot ROM, its I/O registers ($F0-$FF), and the DSP (which is clocked along with it).
+	 */
+	class SPC700 {
+	public:
+		static constexpr size_t ARAM_SIZE = 64 * 1024;
+		static constexpr Word IPL_ROM_ADDRESS = 0xffc0;
+		static constexpr size_t IPL_ROM_SIZE = 64;
+
+		// the SPC700 runs at 1.024 MHz
+		static constexpr uint64_t CLOCK_RATE = 1024000;
+
+		struct flags {
+			enum IgnoreMe: Byte {
+				c = (1 << 0), // carry
+				z = (1 << 1), // zero
+				i = (1 << 2), // interrupt enable (unused on the SNES)
+				h = (1 << 3), // half carry
+				b = (1 << 4), // break
+				p = (1 << 5), // direct page (0 = $00xx, 1 = $01xx)
+				v = (1 << 6), // overflow
+				n = (1 << 7), // negative
+			};
+		};
+
+		struct Timer {
+			// the number of ticks between each increment of the counter (0 means 256)
+			Byte target = 0;
+
+			// counts up to the target
+			Byte stage = 0;
+
+			// the 4-bit counter the software reads (and clears) through $FD-$FF
+			Byte counter = 0;
+
+			bool enabled = false;
+		};
+
+		Byte A = 0;
+		Byte X = 0;
+		Byte Y = 0;
+		Byte SP = 0xef;
+		Word PC = 0;
+		Byte PSW = 0;
+
+		// writing to this directly (rather than through `write`) bypasses the DSP's BRR cache;
+		// reset the DSP (or call `dsp.aramWritten`) after doing so
+		DSP::ARAM aram {};
+
+		// what the CPU wrote to $2140-$2143 (read here through $F4-$F7)
+		std::array<Byte, 4> portsFromCPU {};
+
+		// what was written to $F4-$F7 (read by the CPU through $2140-$2143)
+		std::array<Byte, 4> portsToCPU {};
+
+		std::array<Timer, 3> timers;
+		DSP dsp;
+		Byte dspAddress = 0;
+
+		// $F1; the IPL ROM is mapped in on reset
+		Byte control = 0x80;
+
+		// set by SLEEP and STOP; nothing can wake the SPC700 up from either of them on the SNES
+		bool stopped = false;
+
+		// the total number of cycles executed since reset
+		uint64_t cycles = 0;
+
+		SPC700();
+
+		void reset();
+
+		// executes a single instruction, returning the number of cycles it took
+		unsigned step();
+
+		// executes instructions until at least `cycle` cycles have been executed in total
+		void runUntil(uint64_t cycle);
+
+		// these go through the I/O registers and the IPL ROM, just like the SPC700's own accesses do
+		Byte read(Word address);
+		void write(Word address, Byte value);
+
+		inline bool iplRomEnabled() const {
+			return (control & (1 << 7)) != 0;
+		};
+
+	private:
+		// cycles since the last 64 kHz timer tick
+		unsigned _timerPhase = 0;
+
+		// 64 kHz ticks since the last 8 kHz tick
+		Byte _timerDivider = 0;
+
+		// cycles since the DSP last generated a sample
+		unsigned _dspPhase = 0;
+
+		void advanceTimers(unsigned elapsedCycles);
+		void advanceClock(unsigned elapsedCycles);
+		static void tickTimer(Timer& timer);
+
+		inline Word directPage(Byte offset) const {
+			return ((PSW & flags::p) != 0 ? 0x100 : 0) | offset;
+		};
+
+		inline Byte readDirect(Byte offset) {
+			return read(directPage(offset));
+		};
+
+		inline void writeDirect(Byte offset, Byte value) {
+			write(directPage(offset), value);
+		};
+
+		// 16-bit direct page accesses wrap around within the page
+		Word readDirect16(Byte offset);
+		void writeDirect16(Byte offset, Word value);
+
+		Byte fetch();
+		Word fetch16();
+		Word read16(Word address);
+
+		void push(Byte value);
+		Byte pop();
+		void push16(Word value);
+		Word pop16();
+
+		inline void setFlag(Byte flag, bool set) {
+			PSW = set ? (PSW | flag) : (PSW & ~flag);
+		};
+
+		inline bool getFlag(Byte flag) const {
+			return (PSW & flag) != 0;
+		};
+
+		inline Byte setNZ(Byte value) {
+			setFlag(flags::n, (value & 0x80) != 0);
+			setFlag(flags::z, value == 0);
+			return value;
+		};
+
+		// the addresses of the operands of the ALU instructions (OR/AND/EOR/CMP/ADC/SBC), which all share the same addressing modes
+		Word aluOperandAddress(Byte opcode);
+
+		Byte alu(Byte operation, Byte lhs, Byte rhs);
+		Byte adc(Byte lhs, Byte rhs);
+		Byte sbc(Byte lhs, Byte rhs);
+		void compare(Byte lhs, Byte rhs);
+
+		Byte shift(Byte operation, Byte value);
+
+		// decodes a `m.b` operand (a 13-bit address and a 3-bit bit number)
+		void fetchMemoryBit(Word& address, Byte& bit);
+
+		// fetches the relative offset and takes the branch if `condition` is true, returning the extra cycles that took
+		unsigned branch(bool condition);
+	};
+} // namespace Blaze
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <blaze/MemTypes.hpp>
+#include <blaze/DSP.hpp>
+
+#include <array>
+#include <string>
+
+namespace Blaze {
+	class SPC700;
+
+	/**
+	 * A `.spc` file: a snapshot of the whole APU (the SPC700's registers, ARAM, and the DSP's registers)
+	 * taken while a game was playing music, which is enough to keep the music going without the rest of the SNES.
+	 */
+	class SPCSnapshot {
+	public:
+		struct HeaderOffset {
+			enum IgnoreMe: Word {
+				Signature = 0x00,
+				HasID666 = 0x23,
+				PC = 0x25,
+				A = 0x27,
+				X = 0x28,
+				Y = 0x29,
+				PSW = 0x2a,
+				SP = 0x2b,
+				SongTitle = 0x2e,
+				GameTitle = 0x4e,
+			};
+		};
+
+		static constexpr size_t ARAM_OFFSET = 0x100;
+		static constexpr size_t DSP_REGISTERS_OFFSET = 0x10100;
+
+		// the 64 bytes after the DSP registers are unused, and anything after those is optional
+		static constexpr size_t MINIMUM_SIZE = DSP_REGISTERS_OFFSET + DSP::REGISTER_COUNT;
+
+		Word PC = 0;
+		Byte A = 0;
+		Byte X = 0;
+		Byte Y = 0;
+		Byte PSW = 0;
+		Byte SP = 0;
+
+		// this includes the state of the I/O registers at $F0-$FF
+		DSP::ARAM aram {};
+
+		std::array<Byte, DSP::REGISTER_COUNT> dspRegisters {};
+
+		// from the ID666 tag (if there is one)
+		std::string songTitle;
+		std::string gameTitle;
+
+		/**
+		 * @throws std::runtime_error if the file can't be read or isn't an SPC file
+		 */
+		void load(const std::string& path);
+
+		// resets the given SPC700 (and its DSP) into the state saved in this snapshot
+		void restore(SPC700& spc) const;
+	};
+} // namespace Blaze
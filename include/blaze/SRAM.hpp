@@ -1,13 +1,25 @@
 #pragma once
 
 #include <blaze/MMIO.hpp>
+#include <blaze/MemRam.hpp>
+#include <blaze/PagedMemory.hpp>
+#include <blaze/DirtyBitmap.hpp>
 
-#include <vector>
 #include <cstddef> // for size_t
 
 namespace Blaze {
 	class SRAM: public MMIODevice {
-		std::vector<Byte> _data;
+	public:
+		// the same page size as RAM, so the bus can access both of them directly in the same way
+		// (SRAM smaller than this, e.g. 2 KiB, still takes up a whole page)
+		static constexpr size_t PAGE_SIZE = MemRam::PAGE_SIZE;
+
+		// writes are tracked in 256-byte blocks
+		static constexpr uint8_t DIRTY_BLOCK_SHIFT = 8;
+
+	private:
+		PagedMemory<Byte, PAGE_SIZE> _data;
+		DirtyBitmap _dirty = DirtyBitmap(0, DIRTY_BLOCK_SHIFT);
 
 	public:
 		void setSize(size_t size);
@@ -18,5 +30,24 @@ namespace Blaze {
 		void write(Address offset, Byte bitSize, Address value) override;
 
 		void reset(Bus* bus) override;
+
+		// makes this SRAM share all of its pages with `other` (copy-on-write)
+		void shareFrom(const SRAM& other);
+
+		inline const PagedMemory<Byte, PAGE_SIZE>& memory() const {
+			return _data;
+		};
+		// for the bus's direct accesses; anything written through this has to be marked in `dirtyBlocks`, too
+		inline PagedMemory<Byte, PAGE_SIZE>& memory() {
+			return _data;
+		};
+
+		// the blocks that have been written to since the bitmap was last cleared (e.g. for persisting saves)
+		inline DirtyBitmap& dirtyBlocks() {
+			return _dirty;
+		};
+		inline const DirtyBitmap& dirtyBlocks() const {
+			return _dirty;
+		};
 	};
 };
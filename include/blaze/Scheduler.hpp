@@ -0,0 +1,71 @@
+#pragma once
+
+#include <blaze/IdleLoopDetector.hpp>
+#include <blaze/MemTypes.hpp>
+
+#include <cstdint>
+
+namespace Blaze {
+	struct Bus;
+
+	/**
+	 * Keeps track of the beam position as the CPU runs and drives the interrupt controller with it.
+	 *
+	 * Whoever runs the CPU calls `advance` after every instruction (including the ones in interrupt handlers),
+	 * so the beam never stops moving and the CPU always sees the same H/V state as the APU (which catches up to
+	 * the CPU's cycle counter on its own). Whatever has to happen outside of the core at a new scanline
+	 * (e.g. rendering it) is up to the caller; `advance` only reports it.
+	 */
+	class Scheduler {
+	public:
+		static constexpr uint64_t MASTER_CLOCKS_PER_SCANLINE = 1364;
+		static constexpr uint16_t SCANLINES = 262;
+		static constexpr uint16_t VBLANK_FIRST_SCANLINE = 225;
+		static constexpr uint16_t VBLANK_FIRST_SCANLINE_OVERSCAN = 240;
+
+		// what happened during a call to `advance`
+		struct Events {
+			enum IgnoreMe: Byte {
+				NEW_SCANLINE = 1 << 0,
+				VBLANK_START = 1 << 1,
+				VBLANK_END   = 1 << 2,
+			};
+		};
+
+		/**
+		 * Moves the beam forward by the `cycles` (master clock cycles) the last instruction took.
+		 *
+		 * If the CPU can't do anything until the next event (see `IdleLoopDetector`), this also skips straight to that event
+		 * (adding the skipped cycles to the CPU's cycle counter).
+		 *
+		 * @returns a combination of `Events`
+		 */
+		Byte advance(Bus& bus, uint64_t cycles);
+
+		void reset();
+
+		inline uint16_t scanline() const {
+			return _scanline;
+		};
+
+		// the position within the current scanline (in master clock cycles)
+		inline uint64_t position() const {
+			return _position;
+		};
+
+		// with overscan, vblank starts 15 scanlines later
+		inline void setOverscan(bool overscan) {
+			_overscan = overscan;
+		};
+
+		inline uint16_t vblankFirstScanline() const {
+			return _overscan ? VBLANK_FIRST_SCANLINE_OVERSCAN : VBLANK_FIRST_SCANLINE;
+		};
+
+	private:
+		uint16_t _scanline = 0;
+		uint64_t _position = 0;
+		bool _overscan = false;
+		IdleLoopDetector _idleLoopDetector;
+	};
+} // namespace Blaze
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace Blaze {
+	/**
+	 * A fixed set of worker threads for splitting a job into independent tasks.
+	 *
+	 * `run` hands out the tasks to the workers (the calling thread is worker 0 and helps out)
+	 * and only returns once all of them are done. Each worker has a stable index, so jobs can keep
+	 * per-worker scratch buffers.
+	 */
+	class ThreadPool {
+	public:
+		using Job = std::function<void(size_t task, size_t worker)>;
+
+	private:
+		std::vector<std::thread> _threads;
+		std::mutex _mutex;
+		std::condition_variable _startCondVar;
+		std::condition_variable _doneCondVar;
+		const Job* _job = nullptr;
+		size_t _taskCount = 0;
+		std::atomic<size_t> _nextTask {0};
+		size_t _generation = 0;
+		size_t _busyThreads = 0;
+		bool _stop = false;
+
+		void threadMain(size_t worker);
+		void work(const Job& job, size_t taskCount, size_t worker);
+
+	public:
+		// `threadCount` doesn't include the calling thread, so a pool of 0 threads runs everything inline
+		explicit ThreadPool(size_t threadCount);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// the number of workers (including the calling thread)
+		inline size_t workerCount() const {
+			return _threads.size() + 1;
+		};
+
+		// runs `job` for every task in `[0, taskCount)` and waits for all of them to finish
+		void run(size_t taskCount, const Job& job);
+	};
+} // namespace Blaze
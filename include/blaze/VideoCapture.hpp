@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Blaze {
+	/**
+	 * Streams frames to a file (or pipe) on a dedicated writer thread.
+	 *
+	 * Frames are copied into a fixed set of recycled buffers and queued up for the writer, so submitting a frame
+	 * never allocates and never waits on the disk. The only exception is when every buffer is still waiting to be
+	 * written; in that case, `submit` waits for the writer to catch up and the overflow gets counted.
+	 */
+	class VideoCapture {
+	public:
+		enum class Format: uint8_t {
+			// packed 8-bit R, G, B, and A bytes, one frame after another
+			RawRGBA,
+
+			// YUV4MPEG2 with full-resolution (4:4:4) chroma
+			Y4M,
+		};
+
+		static constexpr size_t DEFAULT_QUEUE_DEPTH = 8;
+
+	private:
+		std::FILE* _file = nullptr;
+		bool _ownsFile = false;
+		Format _format;
+		size_t _width;
+		size_t _height;
+
+		std::vector<std::vector<uint32_t>> _buffers;
+
+		// indices into `_buffers`; neither of these ever grows past the number of buffers
+		std::vector<size_t> _freeBuffers;
+		std::vector<size_t> _queue;
+		size_t _queueHead = 0;
+		size_t _queueSize = 0;
+
+		std::mutex _mutex;
+		std::condition_variable _queuedCondVar;
+		std::condition_variable _freedCondVar;
+		bool _stop = false;
+		std::thread _writerThread;
+
+		// only used by the writer thread
+		std::vector<uint8_t> _encoded;
+
+		std::atomic<size_t> _framesWritten {0};
+		std::atomic<size_t> _overflows {0};
+		std::atomic<bool> _writeFailed {false};
+
+		void writerThreadMain();
+		void encode(const std::vector<uint32_t>& frame);
+
+	public:
+		/**
+		 * Opens `path` for writing (`-` means standard output) and starts the writer thread.
+		 *
+		 * @throws std::runtime_error if the file can't be opened
+		 */
+		VideoCapture(const std::string& path, Format format, size_t width, size_t height, size_t queueDepth = DEFAULT_QUEUE_DEPTH);
+
+		~VideoCapture();
+
+		VideoCapture(const VideoCapture&) = delete;
+		VideoCapture& operator=(const VideoCapture&) = delete;
+
+		// Y4M for paths ending in `.y4m`, raw RGBA for everything else
+		static Format formatForPath(const std::string& path);
+
+		// writes out any frames that are still queued up and closes the file. no more frames can be submitted afterwards.
+		void finish();
+
+		// queues up a frame of `width * height` packed RGBA8888 pixels (i.e. with red in the most significant byte)
+		void submit(const uint32_t* pixels);
+
+		inline size_t framesWritten() const {
+			return _framesWritten.load(std::memory_order_relaxed);
+		};
+
+		// the number of times `submit` had to wait for the writer because the queue was full
+		inline size_t overflowCount() const {
+			return _overflows.load(std::memory_order_relaxed);
+		};
+
+		inline bool writeFailed() const {
+			return _writeFailed.load(std::memory_order_relaxed);
+		};
+	};
+} // namespace Blaze
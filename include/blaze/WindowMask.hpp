@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Blaze {
+	/**
+	 * A set of pixels on a single (256-pixel-wide) scanline, stored as a 256-bit mask.
+	 *
+	 * Combining masks only takes a handful of word-wide logic operations, regardless of the shape of the windows.
+	 */
+	class WindowMask {
+	public:
+		static constexpr size_t WIDTH = 256;
+		static constexpr size_t WORD_COUNT = WIDTH / 64;
+
+		// these match the values of the WBGLOG/WOBJLOG fields
+		enum class Logic: uint8_t {
+			OR = 0,
+			AND = 1,
+			XOR = 2,
+			XNOR = 3,
+		};
+
+	private:
+		std::array<uint64_t, WORD_COUNT> _words {};
+
+	public:
+		// the pixels from `left` to `right` (inclusive); if `left` is greater than `right`, the range is empty
+		static WindowMask range(uint8_t left, uint8_t right) {
+			WindowMask result;
+
+			if (left > right) {
+				return result;
+			}
+
+			for (size_t word = 0; word < WORD_COUNT; ++word) {
+				size_t first = word * 64;
+				size_t last = first + 63;
+
+				if (right < first || left > last) {
+					continue;
+				}
+
+				size_t from = (left > first) ? (left - first) : 0;
+				size_t to = (right < last) ? (right - first) : 63;
+				uint64_t bits = (to - from == 63) ? ~static_cast<uint64_t>(0) : (((static_cast<uint64_t>(1) << (to - from + 1)) - 1) << from);
+
+				result._words[word] = bits;
+			}
+
+			return result;
+		};
+
+		static WindowMask combine(const WindowMask& a, const WindowMask& b, Logic logic) {
+			switch (logic) {
+				case Logic::OR:   return a | b;
+				case Logic::AND:  return a & b;
+				case Logic::XOR:  return a ^ b;
+				case Logic::XNOR: return ~(a ^ b);
+			}
+			return a | b;
+		};
+
+		inline bool test(size_t x) const {
+			return ((_words[x / 64] >> (x % 64)) & 1) != 0;
+		};
+
+		// writes out one 32-bit mask per pixel (all ones for the pixels in the set, zero for the rest)
+		void expand(uint32_t* output) const {
+			for (size_t word = 0; word < WORD_COUNT; ++word) {
+				uint64_t bits = _words[word];
+
+				for (size_t bit = 0; bit < 64; ++bit) {
+					output[(word * 64) + bit] = static_cast<uint32_t>(0) - static_cast<uint32_t>((bits >> bit) & 1);
+				}
+			}
+		};
+
+		bool any() const {
+			uint64_t combined = 0;
+			for (auto word: _words) {
+				combined |= word;
+			}
+			return combined != 0;
+		};
+
+		WindowMask operator~() const {
+			WindowMask result;
+			for (size_t i = 0; i < WORD_COUNT; ++i) {
+				result._words[i] = ~_words[i];
+			}
+			return result;
+		};
+
+		WindowMask operator&(const WindowMask& other) const {
+			WindowMask result;
+			for (size_t i = 0; i < WORD_COUNT; ++i) {
+				result._words[i] = _words[i] & other._words[i];
+			}
+			return result;
+		};
+
+		WindowMask operator|(const WindowMask& other) const {
+			WindowMask result;
+			for (size_t i = 0; i < WORD_COUNT; ++i) {
+				result._words[i] = _words[i] | other._words[i];
+			}
+			return result;
+		};
+
+		WindowMask operator^(const WindowMask& other) const {
+			WindowMask result;
+			for (size_t i = 0; i < WORD_COUNT; ++i) {
+				result._words[i] = _words[i] ^ other._words[i];
+			}
+			return result;
+		};
+
+		bool operator==(const WindowMask& other) const {
+			return _words == other._words;
+		};
+
+		bool operator!=(const WindowMask& other) const {
+			return _words != other._words;
+		};
+	};
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <array>
+#include <memory>
 
 namespace Blaze {
 	struct Color {
@@ -11,5 +13,46 @@ namespace Blaze {
 
 		constexpr Color(std::uint8_t r = 0, std::uint8_t g = 0, std::uint8_t b = 0, std::uint8_t a = 255): // NOLINT
 			r(r), g(g), b(b), a(a) {};
+
+		// packs this color into a single RGBA8888 pixel (i.e. red in the most significant byte)
+		constexpr std::uint32_t toRGBA8888() const {
+			return (static_cast<std::uint32_t>(r) << 24) | (static_cast<std::uint32_t>(g) << 16) | (static_cast<std::uint32_t>(b) << 8) | static_cast<std::uint32_t>(a);
+		};
+	};
+
+	/**
+	 * A lookup table from SNES BGR555 colors to RGBA8888 pixels, with the master brightness (0-15) already applied.
+	 *
+	 * The table only needs to be rebuilt when the brightness changes. Since there are only 16 brightness levels,
+	 * `shared` keeps one immutable table per level that every PPU (including every fork) uses.
+	 */
+	class ColorTable {
+	public:
+		static constexpr std::uint8_t MAX_BRIGHTNESS = 15;
+
+	private:
+		std::array<std::uint32_t, 32768> _entries;
+		std::uint8_t _brightness = MAX_BRIGHTNESS;
+
+		void rebuild();
+
+	public:
+		explicit ColorTable(std::uint8_t brightness = MAX_BRIGHTNESS);
+
+		// the table for `brightness`, shared by everyone who uses it; it's only built the first time it's asked for
+		static std::shared_ptr<const ColorTable> shared(std::uint8_t brightness);
+
+		// returns true if the table had to be rebuilt
+		bool setBrightness(std::uint8_t brightness);
+
+		inline std::uint8_t brightness() const {
+			return _brightness;
+		};
+
+		inline std::uint32_t operator[](std::uint16_t bgr555) const {
+			return _entries[bgr555 & 0x7fff];
+		};
+
+		static Color convert(std::uint16_t bgr555, std::uint8_t brightness = MAX_BRIGHTNESS);
 	};
 } // namespace Blaze
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace Blaze {
+	/**
+	 * A fast, non-cryptographic 64-bit hash (XXH64).
+	 *
+	 * Input is consumed in 32-byte stripes spread across 4 independent lanes, so the compiler can keep
+	 * all of them in flight at once. Data can be fed in any number of pieces; the result only depends
+	 * on the concatenated bytes.
+	 */
+	class Hash64 {
+		uint64_t _seed;
+		uint64_t _lanes[4];
+		uint8_t _buffer[32];
+		size_t _bufferSize = 0;
+		uint64_t _totalSize = 0;
+
+		void consumeStripe(const uint8_t* stripe);
+
+	public:
+		explicit Hash64(uint64_t seed = 0);
+
+		void update(const void* data, size_t size);
+		uint64_t digest() const;
+
+		static uint64_t hash(const void* data, size_t size, uint64_t seed = 0);
+	};
+
+	// the hashes recorded for a single frame
+	struct FrameHashes {
+		uint64_t frame = 0;
+		uint64_t framebuffer = 0;
+		uint64_t wram = 0;
+		uint64_t vram = 0;
+
+		inline bool operator==(const FrameHashes& other) const {
+			return frame == other.frame && framebuffer == other.framebuffer && wram == other.wram && vram == other.vram;
+		};
+		inline bool operator!=(const FrameHashes& other) const {
+			return !(*this == other);
+		};
+
+		// a single line (without a newline) of the form `<frame> <framebuffer> <wram> <vram>`, with the hashes in hex
+		std::string toString() const;
+
+		// parses a line produced by `toString`; returns `false` if it's malformed
+		static bool parse(const std::string& line, FrameHashes& output);
+	};
+
+	/**
+	 * Compares a stream of frame hashes against a golden file (in the format written by `FrameHashes::toString`).
+	 *
+	 * Checking stops at the first frame that doesn't match (or once the golden file runs out).
+	 */
+	class FrameHashChecker {
+		std::vector<FrameHashes> _golden;
+		size_t _next = 0;
+		bool _failed = false;
+
+	public:
+		/**
+		 * @throws std::runtime_error if the golden file contains a malformed line
+		 */
+		explicit FrameHashChecker(std::istream& golden);
+
+		// returns `false` if `hashes` doesn't match the golden file (or a previous frame already didn't)
+		bool check(const FrameHashes& hashes);
+
+		inline bool failed() const {
+			return _failed;
+		};
+
+		// whether every frame in the golden file has been checked
+		inline bool finished() const {
+			return _next >= _golden.size();
+		};
+
+		// the expected hashes for the frame that failed the check (only valid if `failed()`)
+		inline const FrameHashes& expected() const {
+			return _golden[_next];
+		};
+	};
+} // namespace Blaze
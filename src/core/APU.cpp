@@ -0,0 +1,58 @@
+#include <blaze/APU.hpp>
+#include <blaze/Bus.hpp>
+#include <blaze/util.hpp>
+#include <blaze/debug.hpp>
+
+#include <cassert>
+
+Blaze::Byte Blaze::APU::registerSize(Address offset, Byte attemptedAccessSize) {
+	return 8;
+};
+
+Blaze::Address Blaze::APU::read(Address offset, Byte bitSize) {
+	assert(bitSize == 8);
+	catchUp();
+	return _spc.portsToCPU[offset];
+};
+
+void Blaze::APU::write(Address offset, Byte bitSize, Address value) {
+	assert(bitSize == 8);
+
+	// let the SPC700 see everything the CPU wrote before this
+	catchUp();
+	_spc.portsFromCPU[offset] = value;
+};
+
+void Blaze::APU::catchUp() {
+	if (_bus == nullptr) {
+		return;
+	}
+
+	auto cpuCycle = _bus->cpu.cycleCounter;
+
+	// the CPU's cycle counter starts over when it's reset
+	if (cpuCycle > _lastCPUCycle) {
+		_masterClock += cpuCycle - _lastCPUCycle;
+	}
+
+	_lastCPUCycle = cpuCycle;
+
+	_spc.runUntil(_masterClock * SPC700::CLOCK_RATE / MASTER_CLOCK_RATE);
+};
+
+void Blaze::APU::endFrame() {
+	catchUp();
+};
+
+void Blaze::APU::reset(Bus* bus) {
+	_bus = bus;
+	_spc.reset();
+	_lastCPUCycle = 0;
+	_masterClock = 0;
+};
+
+std::unique_ptr<Blaze::MMIODevice> Blaze::APU::fork(Bus* bus) {
+	auto child = std::make_unique<APU>(*this);
+	child->_bus = bus;
+	return child;
+};
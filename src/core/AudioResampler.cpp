@@ -0,0 +1,59 @@
+#include <blaze/AudioResampler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+Blaze::AudioResampler::AudioResampler(AudioRing& ring, unsigned inputRate, unsigned outputRate):
+	_ring(ring),
+	_inputRate(inputRate),
+	_baseStep(static_cast<double>(inputRate) / outputRate)
+{};
+
+void Blaze::AudioResampler::setOutputRate(unsigned outputRate) {
+	_baseStep = static_cast<double>(_inputRate) / outputRate;
+};
+
+bool Blaze::AudioResampler::nextInput(Sample& sample) {
+	if (_stagedIndex == _stagedCount) {
+		_stagedCount = _ring.pop(_staged.data(), _staged.size());
+		_stagedIndex = 0;
+
+		if (_stagedCount == 0) {
+			return false;
+		}
+	}
+
+	sample = _staged[_stagedIndex++];
+	return true;
+};
+
+void Blaze::AudioResampler::render(Sample* output, size_t count) {
+	// how far the ring is from being half full, from -1 (empty) to 1 (full)
+	double fill = static_cast<double>(_ring.size() + (_stagedCount - _stagedIndex)) / _ring.capacity();
+	double step = _baseStep * (1.0 + MAX_RATE_ADJUSTMENT * std::clamp((fill * 2.0) - 1.0, -1.0, 1.0));
+	bool underrun = false;
+
+	for (size_t i = 0; i < count; ++i) {
+		while (_position >= 1.0) {
+			_position -= 1.0;
+			_previous = _current;
+
+			// if we ran out, just hold the last sample
+			if (!nextInput(_current)) {
+				underrun = true;
+			}
+		}
+
+		auto interpolate = [&](int16_t from, int16_t to) {
+			return static_cast<int16_t>(std::lround(from + ((to - from) * _position)));
+		};
+
+		output[i].left = interpolate(_previous.left, _current.left);
+		output[i].right = interpolate(_previous.right, _current.right);
+		_position += step;
+	}
+
+	if (underrun) {
+		_underruns.fetch_add(1, std::memory_order_relaxed);
+	}
+};
@@ -0,0 +1,51 @@
+#include <blaze/AudioRing.hpp>
+
+#include <algorithm>
+
+static size_t roundUpToPowerOf2(size_t value) {
+	size_t result = 1;
+	while (result < value) {
+		result <<= 1;
+	}
+	return result;
+};
+
+Blaze::AudioRing::AudioRing(size_t capacity):
+	_buffer(roundUpToPowerOf2(std::max<size_t>(capacity, 1))),
+	_mask(_buffer.size() - 1)
+{};
+
+size_t Blaze::AudioRing::size() const {
+	return _writeIndex.load(std::memory_order_acquire) - _readIndex.load(std::memory_order_acquire);
+};
+
+size_t Blaze::AudioRing::push(const Sample* samples, size_t count) {
+	size_t write = _writeIndex.load(std::memory_order_relaxed);
+	size_t read = _readIndex.load(std::memory_order_acquire);
+	count = std::min(count, capacity() - (write - read));
+
+	// copy in (at most) two pieces: up to the end of the buffer, then from the start
+	size_t start = write & _mask;
+	size_t first = std::min(count, capacity() - start);
+	std::copy(samples, samples + first, _buffer.begin() + start);
+	std::copy(samples + first, samples + count, _buffer.begin());
+
+	// publish the samples only once they've been written
+	_writeIndex.store(write + count, std::memory_order_release);
+	return count;
+};
+
+size_t Blaze::AudioRing::pop(Sample* samples, size_t count) {
+	size_t read = _readIndex.load(std::memory_order_relaxed);
+	size_t write = _writeIndex.load(std::memory_order_acquire);
+	count = std::min(count, write - read);
+
+	size_t start = read & _mask;
+	size_t first = std::min(count, capacity() - start);
+	std::copy(_buffer.begin() + start, _buffer.begin() + start + first, samples);
+	std::copy(_buffer.begin(), _buffer.begin() + (count - first), samples + first);
+
+	// only hand the space back to the producer once we're done reading it
+	_readIndex.store(read + count, std::memory_order_release);
+	return count;
+};
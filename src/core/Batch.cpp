@@ -0,0 +1,49 @@
+#include <blaze/Batch.hpp>
+#include <blaze/util.hpp>
+
+Blaze::Batch::Batch(const Bus& snapshot, size_t count) {
+	_machines.reserve(count);
+	_schedulers.resize(count);
+
+	for (size_t i = 0; i < count; ++i) {
+		auto& machine = _machines.emplace_back(std::make_unique<Bus>());
+		machine->copyStateFrom(snapshot);
+	}
+};
+
+size_t Blaze::Batch::size() const {
+	return _machines.size();
+};
+
+Blaze::Bus& Blaze::Batch::operator[](size_t index) {
+	return *_machines[index];
+};
+
+const Blaze::Bus& Blaze::Batch::operator[](size_t index) const {
+	return *_machines[index];
+};
+
+Blaze::Scheduler& Blaze::Batch::scheduler(size_t index) {
+	return _schedulers[index];
+};
+
+void Blaze::Batch::setButtons(size_t index, size_t port, Word buttons) {
+	_machines[index]->joypads.setButtons(port, buttons);
+};
+
+void Blaze::Batch::step() {
+	for (size_t i = 0; i < _machines.size(); ++i) {
+		auto& machine = *_machines[i];
+		auto& cpu = machine.cpu;
+		auto beginCycle = cpu.cycleCounter;
+
+		// interrupts are only taken between instructions
+		machine.interrupts.service(cpu);
+
+		// this does nothing if the CPU is stopped or waiting for an interrupt
+		cpu.execute();
+
+		// even a machine that's waiting for an interrupt has to keep its beam moving (or it would never get one)
+		_schedulers[i].advance(machine, cpu.cycleCounter - beginCycle);
+	}
+};
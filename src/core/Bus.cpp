@@ -23,6 +23,18 @@ static constexpr bool addressIsUpperHalf(Blaze::Word address) {
 
 namespace Blaze
 {
+	struct DummyDevice: public MMIODevice {
+		Address read(Address offset, Byte bitSize) override {
+			return 0;
+		};
+
+		void write(Address offset, Byte bitSize, Address value) override {};
+
+		void reset(Bus* bus) override {};
+	};
+
+	static DummyDevice globalDummyDevice;
+
     //=== Constructor ===
     Bus::Bus()
     {
@@ -37,7 +49,28 @@ namespace Blaze
 			Address resultShift = 0;
 
 			while (bitSize > 0) {
-				findDeviceAndOffset(address, bitSize, false, 0, device, offset);
+				const auto& mapping = _pageTable[(address & 0xffffff) >> PAGE_SHIFT];
+				Byte value;
+
+				if (readMemory(mapping, address, value)) {
+					result |= static_cast<Address>(value) << resultShift;
+					bitSize -= 8;
+					resultShift += 8;
+					address = addressInBank(address, 1);
+					continue;
+				}
+
+				if (mapping.device != nullptr) {
+					device = mapping.device;
+					offset = mapping.offset + (address & PAGE_MASK);
+				} else {
+					findDeviceAndOffset(address, bitSize, false, 0, device, offset);
+				}
+
+				if (device == nullptr) {
+					// the device for this address isn't connected (e.g. a machine without a PPU or APU)
+					device = &globalDummyDevice;
+				}
 
 				auto registerBitSize = device->registerSize(offset, bitSize);
 
@@ -48,7 +81,7 @@ namespace Blaze
 				result = (result & resultPreserveMask) | ((tmp & tmpPreserveMask) << resultShift);
 				bitSize -= registerBitSize;
 				resultShift += registerBitSize;
-				address += registerBitSize / 8;
+				address = addressInBank(address, registerBitSize / 8);
 			}
 
 			return result;
@@ -59,7 +92,26 @@ namespace Blaze
 			Address offset = 0;
 
 			while (bitSize > 0) {
-				findDeviceAndOffset(address, bitSize, true, data, device, offset);
+				const auto& mapping = _pageTable[(address & 0xffffff) >> PAGE_SHIFT];
+
+				if (writeMemory(mapping, address, data & 0xff)) {
+					data >>= 8;
+					bitSize -= 8;
+					address = addressInBank(address, 1);
+					continue;
+				}
+
+				if (mapping.device != nullptr) {
+					device = mapping.device;
+					offset = mapping.offset + (address & PAGE_MASK);
+				} else {
+					findDeviceAndOffset(address, bitSize, true, data, device, offset);
+				}
+
+				if (device == nullptr) {
+					// the device for this address isn't connected (e.g. a machine without a PPU or APU)
+					device = &globalDummyDevice;
+				}
 
 				auto registerBitSize = device->registerSize(offset, bitSize);
 				auto dataMask = ~(UINT32_MAX << registerBitSize);
@@ -68,53 +120,48 @@ namespace Blaze
 
 				data >>= registerBitSize;
 				bitSize -= registerBitSize;
-				address += registerBitSize / 8;
+				address = addressInBank(address, registerBitSize / 8);
 			}
 		};
 
     //=== Writing to the bus ===
-    void Bus::write(Address addr, Byte data)
-    {
-		cpu.cycleCounter += 1;
-		write(addr, 8, data);
-    }
     void Bus::write(Address addr, Word data)
     {
-		cpu.cycleCounter += 2;
+		cpu.cycleCounter += accessSpeed(addr, 2);
 		write(addr, 16, data);
     }
     void Bus::write(Address addr, Address data)
     {
-		cpu.cycleCounter += 3;
+		cpu.cycleCounter += accessSpeed(addr, 3);
 		write(addr, 24, data);
     }
 
     //=== Reading from the bus ===
-    Byte Bus::read8(Address addr)
-    {
-		cpu.cycleCounter += 1;
-		return read(addr, 8);
-    }
-
     Word Bus::read16(Address addr)
     {
-		cpu.cycleCounter += 2;
+		cpu.cycleCounter += accessSpeed(addr, 2);
 		return read(addr, 16);
     }
 
     Address Bus::read24(Address addr)
     {
-		cpu.cycleCounter += 3;
+		cpu.cycleCounter += accessSpeed(addr, 3);
 		return read(addr, 24);
     }
 
 	void Bus::reset() {
+		_fastROM = false;
+		updatePageTable();
+
 		ram.reset(this);
 		sram.reset(this);
 		// *don't* reset the ROM
 		//rom.reset(this);
 		dma.reset(this);
 		mulDiv.reset(this);
+		interrupts.reset(this);
+		joypads.reset(this);
+		_memorySelect.reset(this);
 		if (ppu != nullptr) {
 			ppu->reset(this);
 		}
@@ -124,107 +171,323 @@ namespace Blaze
 		cpu.reset(this);
 	};
 
-	struct DummyDevice: public MMIODevice {
-		Address read(Address offset, Byte bitSize) override {
-			return 0;
-		};
+	bool Bus::peek8(Address address, Byte& value) {
+		const auto& mapping = _pageTable[(address & 0xffffff) >> PAGE_SHIFT];
 
-		void write(Address offset, Byte bitSize, Address value) override {};
+		if (readMemory(mapping, address, value)) {
+			return true;
+		}
 
-		void reset(Bus* bus) override {};
+		if (mapping.device == nullptr) {
+			return false;
+		}
+
+		value = mapping.device->read(mapping.offset + (address & PAGE_MASK), 8);
+		return true;
 	};
 
-	static DummyDevice globalDummyDevice;
+	void Bus::copyStateFrom(const Bus& other) {
+		cpu.copyStateFrom(other.cpu);
+		ram.shareFrom(other.ram);
+		rom.shareFrom(other.rom);
+		dma.copyStateFrom(other.dma);
+		sram.shareFrom(other.sram);
+		mulDiv = other.mulDiv;
+		interrupts.copyStateFrom(other.interrupts);
+		joypads = other.joypads;
+		cpu.instrumentation = other.cpu.instrumentation;
+		_fastROM = other._fastROM;
+
+		// we have the same memory map as the other bus, so we can just translate its page table to our devices
+		// rather than building one from scratch
+		for (Address page = 0; page < PAGE_COUNT; ++page) {
+			const auto& otherMapping = other._pageTable[page];
+			auto& mapping = _pageTable[page];
+
+			mapping = PageMapping {};
+			mapping.offset = otherMapping.offset;
+			mapping.speed = otherMapping.speed;
+			mapping.mixedSpeed = otherMapping.mixedSpeed;
+
+			if (otherMapping.device == &other.ram) {
+				mapping.device = &ram;
+			} else if (otherMapping.device == &other.rom) {
+				mapping.device = &rom;
+			} else if (otherMapping.device == &other.sram) {
+				mapping.device = &sram;
+			}
+
+			mapMemory(mapping);
+		}
+
+		// the registers have to point to our own devices, too
+		updateRegisterTables();
+	};
+
+	std::unique_ptr<Bus> Bus::fork() {
+		auto child = std::make_unique<Bus>();
+
+		child->copyStateFrom(*this);
+
+		if (ppu != nullptr) {
+			child->_ownedPPU = ppu->fork(child.get());
+			child->ppu = child->_ownedPPU.get();
+		}
+
+		if (apu != nullptr) {
+			child->_ownedAPU = apu->fork(child.get());
+			child->apu = child->_ownedAPU.get();
+		}
+
+		child->updateRegisterTables();
+
+		return child;
+	};
+
+	void Bus::updatePageTable() {
+		updateRegisterTables();
+
+		for (Address page = 0; page < PAGE_COUNT; ++page) {
+			Address start = page << PAGE_SHIFT;
+			Address end = start | PAGE_MASK;
+			MMIODevice* startDevice = nullptr;
+			MMIODevice* endDevice = nullptr;
+			Address startOffset = 0;
+			Address endOffset = 0;
+			auto& mapping = _pageTable[page];
+
+			mapping = PageMapping {};
+			mapping.speed = pageSpeed(page);
+			mapping.mixedSpeed = (start & 0x400000) == 0 && (start & 0xf000) == (JOYPAD_SERIAL_END & 0xf000);
+
+			if (!mapAddress(start, startDevice, startOffset) || !mapAddress(end, endDevice, endOffset)) {
+				continue;
+			}
+
+			// only pages that map linearly onto a single memory device can be resolved ahead of time
+			if (startDevice != endDevice || (endOffset - startOffset) != PAGE_MASK) {
+				continue;
+			}
+
+			if (startDevice != &ram && startDevice != &rom && startDevice != &sram) {
+				continue;
+			}
+
+			mapping.device = startDevice;
+			mapping.offset = startOffset;
+			mapMemory(mapping);
+		}
+	};
+
+	void Bus::mapMemory(PageMapping& mapping) {
+		if (mapping.device == &ram) {
+			mapping.memory = &ram.memory();
+			mapping.dirty = &ram.dirtyBlocks();
+		} else if (mapping.device == &sram) {
+			auto& memory = sram.memory();
+
+			// SRAM is mirrored, so this only works if the page doesn't wrap around within it
+			if (memory.size() == 0 || (mapping.offset % memory.size()) + PAGE_MASK >= memory.size()) {
+				return;
+			}
+
+			mapping.offset %= memory.size();
+			mapping.memory = &memory;
+			mapping.dirty = &sram.dirtyBlocks();
+		} else if (mapping.device == &rom) {
+			mapping.data = rom.data(mapping.offset, PAGE_MASK + 1);
+		}
+	};
+
+	Byte Bus::pageSpeed(Address page) const {
+		Byte bank;
+		Word addr;
+		split24(page << PAGE_SHIFT, bank, addr);
+
+		// only ROM in banks $80 and up can be accessed faster (when FastROM is enabled)
+		auto romSpeed = (bank >= 0x80 && _fastROM) ? AccessSpeed::Fast : AccessSpeed::Slow;
+
+		// banks $40 through $7F and $C0 through $FF don't have any MMIO (or the low RAM mirror) in them
+		if ((bank & 0x40) != 0) {
+			return romSpeed;
+		}
+
+		if (addr < 0x2000) {
+			// the first 8 KiB of RAM
+			return AccessSpeed::Slow;
+		} else if (addr < 0x6000) {
+			// MMIO
+			return AccessSpeed::Fast;
+		} else if (addr < 0x8000) {
+			// expansion (e.g. HiROM SRAM)
+			return AccessSpeed::Slow;
+		}
+
+		return romSpeed;
+	};
+
+	void Bus::setFastROM(bool fastROM) {
+		if (fastROM == _fastROM) {
+			return;
+		}
+
+		_fastROM = fastROM;
+
+		// this only affects banks $80 through $FF
+		for (Address page = PAGE_COUNT / 2; page < PAGE_COUNT; ++page) {
+			_pageTable[page].speed = pageSpeed(page);
+		}
+	};
+
+	Address Bus::MemorySelect::read(Address offset, Byte bitSize) {
+		// MEMSEL is write-only
+		return 0;
+	};
+
+	void Bus::MemorySelect::write(Address offset, Byte bitSize, Address value) {
+		_bus->setFastROM((value & MEMSEL_FASTROM) != 0);
+	};
+
+	void Bus::MemorySelect::reset(Bus* bus) {
+		_bus = bus;
+	};
 }
 
 void Blaze::Bus::findDeviceAndOffset(Address fullAddress, Byte bitSize, bool forWrite, Address valueWhenWriting, MMIODevice*& outDevice, Address& outOffset) {
-	bool usingHiROM = rom.type() == ROM::Type::HiROM || rom.type() == ROM::Type::ExHiROM;
+	if (mapRegister(fullAddress, outDevice, outOffset) || mapAddress(fullAddress, outDevice, outOffset)) {
+		return;
+	}
+
+	// if we got here, we were unable to map this access.
+	outDevice = &globalDummyDevice;
+	outOffset = 0;
+	cpu.instrumentation.onInvalidAccess(fullAddress, bitSize, forWrite, valueWhenWriting);
+};
 
+bool Blaze::Bus::mapRegister(Address fullAddress, MMIODevice*& outDevice, Address& outOffset) const {
 	Byte bank;
 	Word addr;
 	split24(fullAddress, bank, addr);
 
-	outDevice = nullptr;
-	outOffset = 0;
-
-	// for both LoROM and HiROM, banks $80 through $FD are a mirror of banks $00 through $7D
-	if (bank >= 0x80 && bank <= 0xfd) {
-		bank -= 0x80;
+	// registers only show up in banks $00 through $3F and $80 through $BF
+	if ((bank & 0x40) != 0) {
+		return false;
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr == 0x4200) {
-		// NMI and timer control register
-		outDevice = ppu;
-		outOffset = PPU_SPECIAL_OFFSET_NMITIMEN;
-		return;
+	const RegisterMapping* mapping = nullptr;
+
+	if ((addr & 0xff00) == B_BUS_REGISTERS_START) {
+		mapping = &_bBusRegisters[addr - B_BUS_REGISTERS_START];
+	} else if ((addr & 0xfe00) == CPU_REGISTERS_START) {
+		mapping = &_cpuRegisters[addr - CPU_REGISTERS_START];
+	} else {
+		return false;
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr == 0x4210) {
-		// NMI status register
-		outDevice = ppu;
-		outOffset = PPU_SPECIAL_OFFSET_RDNMI;
-		return;
+	if (mapping->device == nullptr) {
+		return false;
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr >= 0x2100 && addr <= 0x213f) {
-		// the PPU has memory-mapped registers from $2100 through $213F
-		outDevice = ppu;
-		outOffset = addr - 0x2100;
-		return;
+	outDevice = mapping->device;
+	outOffset = mapping->offset;
+	return true;
+};
+
+void Blaze::Bus::updateRegisterTables() {
+	_bBusRegisters.fill(RegisterMapping {});
+	_cpuRegisters.fill(RegisterMapping {});
+
+	// the PPU and APU registers are still there when they're not connected (e.g. in the tests); they just don't do anything
+	MMIODevice* ppuDevice = (ppu != nullptr) ? ppu : &globalDummyDevice;
+	MMIODevice* apuDevice = (apu != nullptr) ? apu : &globalDummyDevice;
+
+	// the PPU has memory-mapped registers from $2100 through $213F
+	for (Address offset = 0x00; offset <= 0x3f; ++offset) {
+		_bBusRegisters[offset] = { ppuDevice, offset };
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr == 0x420b) {
-		// DMA enable register
-		outDevice = &dma;
-		outOffset = DMA_SPECIAL_OFFSET_MDMAEN;
-		return;
+	// APU IO registers (only 4 of them, but mirrored across $2140 through $217F)
+	for (Address offset = 0x40; offset <= 0x7f; ++offset) {
+		_bBusRegisters[offset] = { apuDevice, offset % 4 };
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr == 0x420c) {
-		// HDMA enable register
-		outDevice = &dma;
-		outOffset = DMA_SPECIAL_OFFSET_HDMAEN;
-		return;
+	// every device in $4200 through $43FF gets the offset of its registers from $4200
+	auto mapCPURegister = [&](MMIODevice* device, Address offset) {
+		_cpuRegisters[offset] = { device, offset };
+	};
+
+	// NMI and timer control, the H/V timer, and the interrupt status registers
+	for (Address offset: {
+		InterruptController::Registers::NMITIMEN,
+		InterruptController::Registers::HTIMEL,
+		InterruptController::Registers::HTIMEH,
+		InterruptController::Registers::VTIMEL,
+		InterruptController::Registers::VTIMEH,
+		InterruptController::Registers::RDNMI,
+		InterruptController::Registers::TIMEUP,
+		InterruptController::Registers::HVBJOY,
+	}) {
+		mapCPURegister(&interrupts, offset);
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr >= 0x4300 && addr <= 0x437f) {
-		// DMA control region
-		outDevice = &dma;
-		outOffset = addr - 0x4300;
-		return;
+	for (Address offset: {
+		MulDiv::Registers::WRMPYA,
+		MulDiv::Registers::WRMPYB,
+		MulDiv::Registers::WRDIVL,
+		MulDiv::Registers::WRDIVH,
+		MulDiv::Registers::WRDIVB,
+		MulDiv::Registers::RDDIVL,
+		MulDiv::Registers::RDDIVH,
+		MulDiv::Registers::RDMPYL,
+		MulDiv::Registers::RDMPYH,
+	}) {
+		mapCPURegister(&mulDiv, offset);
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr >= 0x2140 && addr <= 0x217f) {
-		// APU IO registers (only 4 of them, but mirrored across this range)
-		outDevice = apu;
-		outOffset = addr % 4;
-		return;
+	// the results of the automatic joypad read
+	for (Address offset = Joypads::Registers::JOY1L; offset <= Joypads::Registers::JOY4H; ++offset) {
+		mapCPURegister(&joypads, offset);
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr >= Blaze::MULDIV_BLOCK1_START && addr <= Blaze::MULDIV_BLOCK1_END) {
-		outDevice = &mulDiv;
-		outOffset = (addr - Blaze::MULDIV_BLOCK1_START) + Blaze::MULDIV_BLOCK1_OFFSET_BEGIN;
-		return;
+	// the DMA and HDMA enable registers, and the DMA channel registers
+	mapCPURegister(&dma, DMA::Registers::MDMAEN);
+	mapCPURegister(&dma, DMA::Registers::HDMAEN);
+
+	for (Address offset = DMA::Registers::CHANNELS; offset <= DMA::Registers::CHANNELS_END; ++offset) {
+		mapCPURegister(&dma, offset);
 	}
 
-	if (bank >= 0x00 && bank <= 0x3f && addr >= Blaze::MULDIV_BLOCK2_START && addr <= Blaze::MULDIV_BLOCK2_END) {
-		outDevice = &mulDiv;
-		outOffset = (addr - Blaze::MULDIV_BLOCK2_START) + Blaze::MULDIV_BLOCK2_OFFSET_BEGIN;
-		return;
+	// ROM access speed (FastROM); `MemorySelect` only has the one register
+	_cpuRegisters[MEMSEL] = { &_memorySelect, 0 };
+};
+
+bool Blaze::Bus::mapAddress(Address fullAddress, MMIODevice*& outDevice, Address& outOffset) {
+	bool usingHiROM = rom.type() == ROM::Type::HiROM || rom.type() == ROM::Type::ExHiROM;
+
+	Byte bank;
+	Word addr;
+	split24(fullAddress, bank, addr);
+
+	outDevice = nullptr;
+	outOffset = 0;
+
+	// for both LoROM and HiROM, banks $80 through $FD are a mirror of banks $00 through $7D
+	if (bank >= 0x80 && bank <= 0xfd) {
+		bank -= 0x80;
 	}
 
 	// banks $7E and $7F map the full 128 KiB of RAM
 	if (bank == 0x7e || bank == 0x7f) {
 		outDevice = &ram;
 		outOffset = addr + ((bank == 0x7f) ? BANK_SIZE : 0);
-		return;
+		return true;
 	}
 
 	// the first 2 pages of RAM are mirrored into the first 2 pages of every bank in banks $00 through $3F
 	if (bank >= 0x00 && bank <= 0x3f && addr < 0x2000) {
 		outDevice = &ram;
 		outOffset = addr;
-		return;
+		return true;
 	}
 
 	if (usingHiROM) {
@@ -233,7 +496,7 @@ void Blaze::Bus::findDeviceAndOffset(Address fullAddress, Byte bitSize, bool for
 			outDevice = &rom;
 			// in this case, the corresponding offset is exactly the same as the full input address
 			outOffset = fullAddress;
-			return;
+			return true;
 		}
 
 		// in HiROM, banks $40 through $7D map the ROM out linearly
@@ -241,7 +504,7 @@ void Blaze::Bus::findDeviceAndOffset(Address fullAddress, Byte bitSize, bool for
 			outDevice = &rom;
 			// since this is mapped out linearly (full banks used), we can just subtract the start address to get the ROM offset
 			outOffset = fullAddress - HIROM_LINEAR_START;
-			return;
+			return true;
 		}
 
 		// in HiROM, banks $FE and $FF map the final 128 KiB of the ROM
@@ -249,33 +512,33 @@ void Blaze::Bus::findDeviceAndOffset(Address fullAddress, Byte bitSize, bool for
 			outDevice = &rom;
 			// again: this is mapped out linearly (full banks used), so we can just subtract the start address (and add the offset start) to get the ROM offset
 			outOffset = (fullAddress - HIROM_FINAL_128KIB_MEMORY_START) + HIROM_FINAL_128KIB_OFFSET_START;
-			return;
+			return true;
 		}
 	} else {
 		// in LoROM, the upper half of banks $00 through $7D map the ROM out linearly
 		if (bank >= 0x00 && bank <= 0x7d && addressIsUpperHalf(addr)) {
 			outDevice = &rom;
 			outOffset = (addr - UPPER_HALF_MIN) + (bank * BANK_HALF_SIZE);
-			return;
+			return true;
 		}
 
 		// in LoROM, the upper half of banks $FE and $FF map the final 64 KiB of the ROM
 		if (bank >= 0xfe && bank <= 0xff && addressIsUpperHalf(addr)) {
 			outDevice = &rom;
 			outOffset = (addr - UPPER_HALF_MIN) + LOROM_FINAL_64KIB + ((bank == 0xfe) ? 0 : BANK_HALF_SIZE);
-			return;
+			return true;
 		}
 
 		if (bank >= 0x70 && bank <= 0x7d && !addressIsUpperHalf(addr)) {
 			outDevice = &sram;
 			outOffset = addr + ((bank - 0x70) * BANK_HALF_SIZE);
-			return;
+			return true;
 		}
 
 		if (bank >= 0xfe && bank <= 0xff && !addressIsUpperHalf(addr)) {
 			outDevice = &sram;
 			outOffset = addr + LOROM_FINAL_SRAM + ((bank - 0xfe) * BANK_HALF_SIZE);
-			return;
+			return true;
 		}
 	}
 
@@ -283,10 +546,5 @@ void Blaze::Bus::findDeviceAndOffset(Address fullAddress, Byte bitSize, bool for
 	//   HiROM SRAM in $6000 through $7FFF of banks $20 through $3F
 	//   all the SNES MMIO peripherals
 
-	// if we got here, we were unable to map this access.
-	outDevice = &globalDummyDevice;
-	outOffset = 0;
-	if (invalidAccess) {
-		invalidAccess(fullAddress, bitSize, forWrite, valueWhenWriting);
-	}
+	return false;
 };
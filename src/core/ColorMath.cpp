@@ -0,0 +1,157 @@
+#include <blaze/ColorMath.hpp>
+#include <blaze/color.hpp>
+
+#include <algorithm>
+#include <array>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define BLAZE_COLOR_MATH_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+// alpha lives in the lowest byte of an RGBA8888 pixel
+static constexpr uint32_t ALPHA_MASK = 0x000000ff;
+
+// the SIMD paths work on this many pixels per iteration
+static constexpr size_t CHUNK_SIZE = 16;
+
+void Blaze::ColorMath::applyScalar(uint32_t* main, const uint32_t* addend, const uint32_t* enable, const uint32_t* half, size_t count, bool subtract) {
+	for (size_t i = 0; i < count; ++i) {
+		if (enable[i] == 0) {
+			continue;
+		}
+
+		uint32_t result = 0;
+
+		for (unsigned shift = 8; shift < 32; shift += 8) {
+			int a = (main[i] >> shift) & 0xff;
+			int b = (addend[i] >> shift) & 0xff;
+			int component = 0;
+
+			if (subtract) {
+				component = std::max(a - b, 0);
+				if (half[i] != 0) {
+					component >>= 1;
+				}
+			} else {
+				component = a + b;
+				// halving the sum means it can never saturate
+				component = (half[i] != 0) ? (component >> 1) : std::min(component, 0xff);
+			}
+
+			result |= static_cast<uint32_t>(component) << shift;
+		}
+
+		main[i] = result | ALPHA_MASK;
+	}
+};
+
+#if defined(__AVX2__)
+
+static inline __m256i applyVector(__m256i main, __m256i addend, __m256i enable, __m256i half, bool subtract) {
+	const __m256i lowBits = _mm256_set1_epi8(0x7f);
+	__m256i full;
+	__m256i halved;
+
+	if (subtract) {
+		full = _mm256_subs_epu8(main, addend);
+		halved = _mm256_and_si256(_mm256_srli_epi32(full, 1), lowBits);
+	} else {
+		full = _mm256_adds_epu8(main, addend);
+		// floor((a + b) / 2) per byte, without overflowing: (a & b) + ((a ^ b) >> 1)
+		halved = _mm256_add_epi8(_mm256_and_si256(main, addend), _mm256_and_si256(_mm256_srli_epi32(_mm256_xor_si256(main, addend), 1), lowBits));
+	}
+
+	__m256i result = _mm256_blendv_epi8(full, halved, half);
+	return _mm256_or_si256(_mm256_blendv_epi8(main, result, enable), _mm256_and_si256(enable, _mm256_set1_epi32(ALPHA_MASK)));
+};
+
+#elif defined(BLAZE_COLOR_MATH_SSE2)
+
+static inline __m128i select(__m128i mask, __m128i ifSet, __m128i ifClear) {
+	return _mm_or_si128(_mm_and_si128(mask, ifSet), _mm_andnot_si128(mask, ifClear));
+};
+
+static inline __m128i applyVector(__m128i main, __m128i addend, __m128i enable, __m128i half, bool subtract) {
+	const __m128i lowBits = _mm_set1_epi8(0x7f);
+	__m128i full;
+	__m128i halved;
+
+	if (subtract) {
+		full = _mm_subs_epu8(main, addend);
+		halved = _mm_and_si128(_mm_srli_epi32(full, 1), lowBits);
+	} else {
+		full = _mm_adds_epu8(main, addend);
+		// floor((a + b) / 2) per byte, without overflowing: (a & b) + ((a ^ b) >> 1)
+		halved = _mm_add_epi8(_mm_and_si128(main, addend), _mm_and_si128(_mm_srli_epi32(_mm_xor_si128(main, addend), 1), lowBits));
+	}
+
+	__m128i result = select(half, halved, full);
+	return _mm_or_si128(select(enable, result, main), _mm_and_si128(enable, _mm_set1_epi32(ALPHA_MASK)));
+};
+
+#endif
+
+void Blaze::ColorMath::apply(uint32_t* main, const uint32_t* addend, const uint32_t* enable, const uint32_t* half, size_t count, bool subtract) {
+	size_t i = 0;
+
+#if defined(__AVX2__)
+	for (; i + CHUNK_SIZE <= count; i += CHUNK_SIZE) {
+		for (size_t offset = 0; offset < CHUNK_SIZE; offset += 8) {
+			auto* mainVector = reinterpret_cast<__m256i*>(&main[i + offset]);
+			auto result = applyVector(
+				_mm256_loadu_si256(mainVector),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&addend[i + offset])),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&enable[i + offset])),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&half[i + offset])),
+				subtract
+			);
+			_mm256_storeu_si256(mainVector, result);
+		}
+	}
+#elif defined(BLAZE_COLOR_MATH_SSE2)
+	for (; i + CHUNK_SIZE <= count; i += CHUNK_SIZE) {
+		for (size_t offset = 0; offset < CHUNK_SIZE; offset += 4) {
+			auto* mainVector = reinterpret_cast<__m128i*>(&main[i + offset]);
+			auto result = applyVector(
+				_mm_loadu_si128(mainVector),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(&addend[i + offset])),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(&enable[i + offset])),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(&half[i + offset])),
+				subtract
+			);
+			_mm_storeu_si128(mainVector, result);
+		}
+	}
+#endif
+
+	applyScalar(&main[i], &addend[i], &enable[i], &half[i], count - i, subtract);
+};
+
+void Blaze::ColorMath::applyBrightness(uint32_t* pixels, size_t count, uint8_t brightness) {
+	// one lookup table per brightness level, shared by every thread (and only built once)
+	static const auto scaleTables = []() {
+		std::array<std::array<uint8_t, 256>, ColorTable::MAX_BRIGHTNESS + 1> tables;
+
+		for (unsigned level = 0; level < tables.size(); ++level) {
+			for (unsigned component = 0; component < 256; ++component) {
+				tables[level][component] = static_cast<uint8_t>((component * level) / ColorTable::MAX_BRIGHTNESS);
+			}
+		}
+
+		return tables;
+	}();
+
+	const auto& scale = scaleTables[brightness & 0x0f];
+
+	for (size_t i = 0; i < count; ++i) {
+		uint32_t pixel = pixels[i];
+
+		pixels[i] = (static_cast<uint32_t>(scale[pixel >> 24]) << 24)
+			| (static_cast<uint32_t>(scale[(pixel >> 16) & 0xff]) << 16)
+			| (static_cast<uint32_t>(scale[(pixel >> 8) & 0xff]) << 8)
+			| (pixel & ALPHA_MASK);
+	}
+};
@@ -28,12 +28,12 @@ Blaze::Byte Blaze::DMA::registerSize(Address offset, Byte attemptedAccessSize) {
 Blaze::Address Blaze::DMA::read(Address offset, Byte bitSize) {
 	assert(bitSize == 8);
 
-	if (offset == DMA_SPECIAL_OFFSET_HDMAEN) {
+	if (offset == Registers::HDMAEN) {
 		return _hdmaEnable;
-	} else if (offset == DMA_SPECIAL_OFFSET_MDMAEN) {
+	} else if (offset == Registers::MDMAEN) {
 		return 0;
 	} else {
-		Channel& channel = _channels[offset / 16];
+		Channel& channel = _channels[(offset - Registers::CHANNELS) / 16];
 		Byte channelRegister = offset % 16;
 
 		switch (channelRegister) {
@@ -58,10 +58,10 @@ Blaze::Address Blaze::DMA::read(Address offset, Byte bitSize) {
 void Blaze::DMA::write(Address offset, Byte bitSize, Address value) {
 	assert(bitSize == 8);
 
-	if (offset == DMA_SPECIAL_OFFSET_HDMAEN) {
+	if (offset == Registers::HDMAEN) {
 		_hdmaEnable = value;
 		// TODO: HDMA
-	} else if (offset == DMA_SPECIAL_OFFSET_MDMAEN) {
+	} else if (offset == Registers::MDMAEN) {
 		for (Byte index = 0; index < 8; ++index) {
 			if ((value & (1 << index)) == 0) {
 				continue;
@@ -147,7 +147,7 @@ void Blaze::DMA::write(Address offset, Byte bitSize, Address value) {
 			channel.byteCount = 0;
 		}
 	} else {
-		Channel& channel = _channels[offset / 16];
+		Channel& channel = _channels[(offset - Registers::CHANNELS) / 16];
 		Byte channelRegister = offset % 16;
 
 		switch (channelRegister) {
@@ -169,3 +169,8 @@ void Blaze::DMA::write(Address offset, Byte bitSize, Address value) {
 void Blaze::DMA::reset(Bus* bus) {
 	_bus = bus;
 };
+
+void Blaze::DMA::copyStateFrom(const DMA& other) {
+	_hdmaEnable = other._hdmaEnable;
+	_channels = other._channels;
+};
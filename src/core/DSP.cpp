@@ -0,0 +1,651 @@
+#include <blaze/DSP.hpp>
+#include <blaze/util.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define BLAZE_DSP_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+namespace Blaze {
+	struct DSPRegisters {
+		enum IgnoreMe: Byte {
+			// per-voice registers (offsets from $x0 for voice x)
+			VOLL   = 0x00,
+			VOLR   = 0x01,
+			PITCHL = 0x02,
+			PITCHH = 0x03,
+			SRCN   = 0x04,
+			ADSR1  = 0x05,
+			ADSR2  = 0x06,
+			GAIN   = 0x07,
+			ENVX   = 0x08,
+			OUTX   = 0x09,
+
+			// global registers
+			MVOLL = 0x0c,
+			MVOLR = 0x1c,
+			EVOLL = 0x2c,
+			EVOLR = 0x3c,
+			KON   = 0x4c,
+			KOFF  = 0x5c,
+			FLG   = 0x6c,
+			ENDX  = 0x7c,
+			EFB   = 0x0d,
+			PMON  = 0x2d,
+			NON   = 0x3d,
+			EON   = 0x4d,
+			DIR   = 0x5d,
+			ESA   = 0x6d,
+			EDL   = 0x7d,
+
+			// FIR coefficient x is at $xF
+			FIR0  = 0x0f,
+		};
+	};
+
+	struct DSPFlags {
+		enum IgnoreMe: Byte {
+			NOISE_RATE_MASK    = 0x1f,
+			ECHO_WRITE_DISABLE = 1 << 5,
+			MUTE               = 1 << 6,
+			SOFT_RESET         = 1 << 7,
+		};
+	};
+
+	// BRR block headers
+	struct BRRHeader {
+		enum IgnoreMe: Byte {
+			END  = 1 << 0,
+			LOOP = 1 << 1,
+		};
+	};
+
+	// the envelope and noise rates are all derived from a single counter with this period
+	static constexpr int COUNTER_RANGE = 2048 * 5 * 3;
+
+	static constexpr std::array<uint16_t, 32> COUNTER_RATES = {
+		0, 2048, 1536, 1280, 1024, 768, 640, 512, 384, 320, 256, 192, 160, 128, 96, 80,
+		64, 48, 40, 32, 24, 20, 16, 12, 10, 8, 6, 5, 4, 3, 2, 1,
+	};
+
+	static constexpr std::array<uint16_t, 32> COUNTER_OFFSETS = {
+		1, 0, 1040, 536, 0, 1040, 536, 0, 1040, 536, 0, 1040, 536, 0, 1040, 536,
+		0, 1040, 536, 0, 1040, 536, 0, 1040, 536, 0, 1040, 536, 0, 1040, 0, 0,
+	};
+
+	// the DSP's interpolation table (the left half of a Gaussian curve)
+	static constexpr std::array<int16_t, 512> GAUSSIAN_TABLE = {
+		   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+		   1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    2,    2,    2,    2,    2,
+		   2,    2,    3,    3,    3,    3,    3,    4,    4,    4,    4,    4,    5,    5,    5,    5,
+		   6,    6,    6,    6,    7,    7,    7,    8,    8,    8,    9,    9,    9,   10,   10,   10,
+		  11,   11,   11,   12,   12,   13,   13,   14,   14,   15,   15,   15,   16,   16,   17,   17,
+		  18,   19,   19,   20,   20,   21,   21,   22,   23,   23,   24,   24,   25,   26,   27,   27,
+		  28,   29,   29,   30,   31,   32,   32,   33,   34,   35,   36,   36,   37,   38,   39,   40,
+		  41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51,   52,   53,   54,   55,   56,
+		  58,   59,   60,   61,   62,   64,   65,   66,   67,   69,   70,   71,   73,   74,   76,   77,
+		  78,   80,   81,   83,   84,   86,   87,   89,   90,   92,   94,   95,   97,   99,  100,  102,
+		 104,  106,  107,  109,  111,  113,  115,  117,  118,  120,  122,  124,  126,  128,  130,  132,
+		 134,  137,  139,  141,  143,  145,  147,  150,  152,  154,  156,  159,  161,  163,  166,  168,
+		 171,  173,  175,  178,  180,  183,  186,  188,  191,  193,  196,  199,  201,  204,  207,  210,
+		 212,  215,  218,  221,  224,  227,  230,  233,  236,  239,  242,  245,  248,  251,  254,  257,
+		 260,  263,  267,  270,  273,  276,  280,  283,  286,  290,  293,  297,  300,  304,  307,  311,
+		 314,  318,  321,  325,  328,  332,  336,  339,  343,  347,  351,  354,  358,  362,  366,  370,
+		 374,  378,  381,  385,  389,  393,  397,  401,  405,  410,  414,  418,  422,  426,  430,  434,
+		 439,  443,  447,  451,  456,  460,  464,  469,  473,  477,  482,  486,  491,  495,  499,  504,
+		 508,  513,  517,  522,  527,  531,  536,  540,  545,  550,  554,  559,  563,  568,  573,  577,
+		 582,  587,  592,  596,  601,  606,  611,  615,  620,  625,  630,  635,  640,  644,  649,  654,
+		 659,  664,  669,  674,  678,  683,  688,  693,  698,  703,  708,  713,  718,  723,  728,  732,
+		 737,  742,  747,  752,  757,  762,  767,  772,  777,  782,  787,  792,  797,  802,  806,  811,
+		 816,  821,  826,  831,  836,  841,  846,  851,  855,  860,  865,  870,  875,  880,  884,  889,
+		 894,  899,  904,  908,  913,  918,  923,  927,  932,  937,  941,  946,  951,  955,  960,  965,
+		 969,  974,  978,  983,  988,  992,  997, 1001, 1005, 1010, 1014, 1019, 1023, 1027, 1032, 1036,
+		1040, 1045, 1049, 1053, 1057, 1061, 1066, 1070, 1074, 1078, 1082, 1086, 1090, 1094, 1098, 1102,
+		1106, 1109, 1113, 1117, 1121, 1125, 1128, 1132, 1136, 1139, 1143, 1146, 1150, 1153, 1157, 1160,
+		1164, 1167, 1170, 1174, 1177, 1180, 1183, 1186, 1190, 1193, 1196, 1199, 1202, 1205, 1207, 1210,
+		1213, 1216, 1219, 1221, 1224, 1227, 1229, 1232, 1234, 1237, 1239, 1241, 1244, 1246, 1248, 1251,
+		1253, 1255, 1257, 1259, 1261, 1263, 1265, 1267, 1269, 1270, 1272, 1274, 1275, 1277, 1279, 1280,
+		1282, 1283, 1284, 1286, 1287, 1288, 1290, 1291, 1292, 1293, 1294, 1295, 1296, 1297, 1297, 1298,
+		1299, 1300, 1300, 1301, 1302, 1302, 1303, 1303, 1303, 1304, 1304, 1304, 1304, 1304, 1305, 1305,
+	};
+
+	// a voice's position covers one BRR block, in 1/4096ths of a sample
+	static constexpr unsigned BLOCK_SAMPLES = 16;
+	static constexpr unsigned POSITION_SHIFT = 12;
+
+	static constexpr int MAX_PITCH = 0x7fff;
+
+	static inline int clamp16(int value) {
+		return std::clamp(value, -32768, 32767);
+	};
+} // namespace Blaze
+
+Blaze::DSP::DSP():
+	_brrCache(BRR_CACHE_SIZE)
+{
+	reset();
+};
+
+void Blaze::DSP::reset() {
+	std::fill(_registers.begin(), _registers.end(), 0);
+	_registers[DSPRegisters::FLG] = DSPFlags::SOFT_RESET | DSPFlags::MUTE | DSPFlags::ECHO_WRITE_DISABLE;
+
+	std::fill(_voices.begin(), _voices.end(), Voice());
+	std::fill(_brrCache.begin(), _brrCache.end(), CachedBlock());
+	std::fill(_pageGenerations.begin(), _pageGenerations.end(), 0);
+
+	for (auto& volumes: _volumes) {
+		std::fill(volumes.begin(), volumes.end(), 0);
+	}
+	std::fill(_firCoefficients.begin(), _firCoefficients.end(), 0);
+
+	_pendingKeyOn = 0;
+	_everyOtherSample = true;
+	_counter = 0;
+	_noise = 0x4000;
+
+	for (auto& history: _echoHistory) {
+		std::fill(history.begin(), history.end(), 0);
+	}
+	_echoHistoryPosition = 0;
+	_echoOffset = 0;
+	_echoLength = 0;
+
+	_output.clear();
+};
+
+Blaze::Byte Blaze::DSP::readRegister(Byte address) const {
+	return _registers[address & (REGISTER_COUNT - 1)];
+};
+
+void Blaze::DSP::writeRegister(Byte address, Byte value) {
+	address &= REGISTER_COUNT - 1;
+	_registers[address] = value;
+
+	switch (address) {
+		case DSPRegisters::KON:
+			_pendingKeyOn |= value;
+			break;
+
+		case DSPRegisters::ENDX:
+			// writing anything clears all the bits
+			_registers[address] = 0;
+			break;
+
+		default:
+			switch (address & 0x0f) {
+				case DSPRegisters::VOLL:
+				case DSPRegisters::VOLR:
+					_volumes[address & 0x0f][address >> 4] = static_cast<int8_t>(value);
+					break;
+
+				case DSPRegisters::FIR0:
+					_firCoefficients[address >> 4] = static_cast<int8_t>(value);
+					break;
+
+				default:
+					break;
+			}
+			break;
+	}
+};
+
+void Blaze::DSP::takeSamples(std::vector<Sample>& samples) {
+	samples.insert(samples.end(), _output.begin(), _output.end());
+	_output.clear();
+};
+
+bool Blaze::DSP::counterFires(unsigned rate) const {
+	// rate 0 never fires
+	if (rate == 0) {
+		return false;
+	}
+
+	return (static_cast<unsigned>(_counter) + COUNTER_OFFSETS[rate]) % COUNTER_RATES[rate] == 0;
+};
+
+Blaze::Word Blaze::DSP::sampleDirectoryEntry(size_t index, Word offset, const ARAM& aram) const {
+	Word entry = (_registers[DSPRegisters::DIR] << 8) + (_registers[(index << 4) | DSPRegisters::SRCN] * 4) + offset;
+	return concat16(aram[static_cast<Word>(entry + 1)], aram[entry]);
+};
+
+const Blaze::DSP::CachedBlock& Blaze::DSP::decodeBlock(Word address, int16_t previous1, int16_t previous2, const ARAM& aram) {
+	auto& block = _brrCache[address & (BRR_CACHE_SIZE - 1)];
+	Word lastAddress = address + BRR_BLOCK_SIZE - 1;
+	std::array<uint32_t, 2> generations { _pageGenerations[address >> 8], _pageGenerations[lastAddress >> 8] };
+
+	if (block.valid && block.address == address && block.previous1 == previous1 && block.previous2 == previous2 && block.generations == generations) {
+		return block;
+	}
+
+	Byte header = aram[address];
+	int shift = header >> 4;
+	int filter = (header >> 2) & 3;
+	int sample1 = previous1;
+	int sample2 = previous2;
+
+	for (size_t i = 0; i < BLOCK_SAMPLES; ++i) {
+		Byte data = aram[static_cast<Word>(address + 1 + (i >> 1))];
+		int nybble = ((i & 1) == 0) ? (data >> 4) : (data & 0x0f);
+		int sample = (nybble ^ 8) - 8;
+
+		// shifts above 12 are invalid and just produce 0 (or -2048 for negative values)
+		sample = (shift <= 12) ? ((sample * (1 << shift)) >> 1) : (sample < 0 ? -2048 : 0);
+
+		// the second-to-last sample is used at half its (doubled) value
+		int last = sample1;
+		int beforeLast = sample2 >> 1;
+
+		switch (filter) {
+			case 1:
+				sample += last >> 1;
+				sample += (-last) >> 5;
+				break;
+
+			case 2:
+				sample += last;
+				sample -= beforeLast;
+				sample += beforeLast >> 4;
+				sample += (last * -3) >> 6;
+				break;
+
+			case 3:
+				sample += last;
+				sample -= beforeLast;
+				sample += (last * -13) >> 7;
+				sample += (beforeLast * 3) >> 4;
+				break;
+
+			default:
+				break;
+		}
+
+		// the decoded samples are stored doubled, wrapping around at 16 bits
+		sample = static_cast<int16_t>(clamp16(sample) * 2);
+
+		block.samples[i] = sample;
+		sample2 = sample1;
+		sample1 = sample;
+	}
+
+	block.address = address;
+	block.previous1 = previous1;
+	block.previous2 = previous2;
+	block.generations = generations;
+	block.valid = true;
+
+	return block;
+};
+
+void Blaze::DSP::loadBlock(Voice& voice, const ARAM& aram) {
+	const auto& block = decodeBlock(voice.blockAddress, voice.samples[2], voice.samples[1], aram);
+	voice.blockHeader = aram[voice.blockAddress];
+	std::copy(block.samples.begin(), block.samples.end(), voice.samples.begin() + 3);
+};
+
+void Blaze::DSP::keyOn(Voice& voice, size_t index, const ARAM& aram) {
+	voice.keyOnDelay = 5;
+	voice.envelope = 0;
+	voice.hiddenEnvelope = 0;
+	voice.envelopeMode = EnvelopeMode::Attack;
+	voice.position = 0;
+	std::fill(voice.samples.begin(), voice.samples.end(), 0);
+
+	voice.blockAddress = sampleDirectoryEntry(index, 0, aram);
+	loadBlock(voice, aram);
+
+	_registers[DSPRegisters::ENDX] &= ~(1 << index);
+};
+
+void Blaze::DSP::advanceBlock(Voice& voice, size_t index, const ARAM& aram) {
+	if ((voice.blockHeader & BRRHeader::END) != 0) {
+		_registers[DSPRegisters::ENDX] |= 1 << index;
+
+		// samples that end without looping silence the voice (but it keeps decoding from the loop point anyways)
+		if ((voice.blockHeader & BRRHeader::LOOP) == 0) {
+			voice.envelopeMode = EnvelopeMode::Release;
+			voice.envelope = 0;
+		}
+
+		voice.blockAddress = sampleDirectoryEntry(index, 2, aram);
+	} else {
+		voice.blockAddress += BRR_BLOCK_SIZE;
+	}
+
+	// the last 3 samples are still needed for interpolation
+	std::copy(voice.samples.end() - 3, voice.samples.end(), voice.samples.begin());
+	loadBlock(voice, aram);
+};
+
+int Blaze::DSP::interpolate(const Voice& voice) const {
+	unsigned offset = (voice.position >> 4) & 0xff;
+	const int16_t* forward = &GAUSSIAN_TABLE[255 - offset];
+	const int16_t* reverse = &GAUSSIAN_TABLE[offset];
+	const int16_t* in = &voice.samples[voice.position >> POSITION_SHIFT];
+
+	int output = (forward[0] * in[0]) >> 11;
+	output += (forward[256] * in[1]) >> 11;
+	output += (reverse[256] * in[2]) >> 11;
+	output = static_cast<int16_t>(output);
+	output += (reverse[0] * in[3]) >> 11;
+
+	return clamp16(output) & ~1;
+};
+
+void Blaze::DSP::runEnvelope(Voice& voice, size_t index) {
+	int envelope = voice.envelope;
+
+	if (voice.envelopeMode == EnvelopeMode::Release) {
+		voice.envelope = std::max(envelope - 8, 0);
+		return;
+	}
+
+	const Byte* registers = &_registers[index << 4];
+	Byte adsr1 = registers[DSPRegisters::ADSR1];
+	int data = registers[DSPRegisters::ADSR2];
+	unsigned rate = 0;
+
+	if ((adsr1 & 0x80) != 0) {
+		// ADSR
+		if (voice.envelopeMode == EnvelopeMode::Attack) {
+			rate = ((adsr1 & 0x0f) * 2) + 1;
+			envelope += (rate < 31) ? 0x20 : 0x400;
+		} else {
+			envelope -= 1;
+			envelope -= envelope >> 8;
+			rate = (voice.envelopeMode == EnvelopeMode::Decay) ? (((adsr1 >> 3) & 0x0e) + 0x10) : (data & 0x1f);
+		}
+	} else {
+		// GAIN
+		data = registers[DSPRegisters::GAIN];
+		int mode = data >> 5;
+
+		if (mode < 4) {
+			// direct
+			envelope = data * 0x10;
+			rate = 31;
+		} else {
+			rate = data & 0x1f;
+
+			if (mode == 4) {
+				// linear decrease
+				envelope -= 0x20;
+			} else if (mode == 5) {
+				// exponential decrease
+				envelope -= 1;
+				envelope -= envelope >> 8;
+			} else {
+				// linear increase (mode 7 slows down once it's most of the way there)
+				envelope += 0x20;
+				if (mode == 7 && static_cast<unsigned>(voice.hiddenEnvelope) >= 0x600) {
+					envelope += 0x8 - 0x20;
+				}
+			}
+		}
+	}
+
+	// the sustain level
+	if (voice.envelopeMode == EnvelopeMode::Decay && (envelope >> 8) == (data >> 5)) {
+		voice.envelopeMode = EnvelopeMode::Sustain;
+	}
+
+	voice.hiddenEnvelope = envelope;
+
+	// this also catches linear decreases going negative
+	if (static_cast<unsigned>(envelope) > 0x7ff) {
+		envelope = (envelope < 0) ? 0 : 0x7ff;
+		if (voice.envelopeMode == EnvelopeMode::Attack) {
+			voice.envelopeMode = EnvelopeMode::Decay;
+		}
+	}
+
+	if (counterFires(rate)) {
+		voice.envelope = envelope;
+	}
+};
+
+int Blaze::DSP::firScalar(const int16_t* history, const int16_t* coefficients) {
+	int sum = 0;
+
+	for (size_t i = 0; i < FIR_TAPS - 1; ++i) {
+		sum += (history[i] * coefficients[i]) >> 6;
+	}
+
+	sum = static_cast<int16_t>(sum);
+	sum += static_cast<int16_t>((history[FIR_TAPS - 1] * coefficients[FIR_TAPS - 1]) >> 6);
+
+	return clamp16(sum);
+};
+
+int Blaze::DSP::mixScalar(const int16_t* outputs, const int16_t* volumes, Byte enabled) {
+	int total = 0;
+
+	for (size_t i = 0; i < VOICE_COUNT; ++i) {
+		if ((enabled & (1 << i)) != 0) {
+			total = clamp16(total + ((outputs[i] * volumes[i]) >> 7));
+		}
+	}
+
+	return total;
+};
+
+#if defined(BLAZE_DSP_SSE2)
+
+// multiplies 8 pairs of 16-bit values into 8 32-bit products (split across two vectors), each shifted right
+static inline void multiplyAndShift(__m128i a, __m128i b, int shift, __m128i& low, __m128i& high) {
+	__m128i productLow = _mm_mullo_epi16(a, b);
+	__m128i productHigh = _mm_mulhi_epi16(a, b);
+	low = _mm_srai_epi32(_mm_unpacklo_epi16(productLow, productHigh), shift);
+	high = _mm_srai_epi32(_mm_unpackhi_epi16(productLow, productHigh), shift);
+};
+
+static inline int horizontalSum(__m128i value) {
+	value = _mm_add_epi32(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+	value = _mm_add_epi32(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(value);
+};
+
+int Blaze::DSP::fir(const int16_t* history, const int16_t* coefficients) {
+	__m128i low;
+	__m128i high;
+	multiplyAndShift(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(history)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients)),
+		6,
+		low,
+		high
+	);
+
+	// the last tap is added separately (after the others wrap around)
+	int last = _mm_cvtsi128_si32(_mm_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 3, 3)));
+	high = _mm_and_si128(high, _mm_set_epi32(0, -1, -1, -1));
+
+	int sum = static_cast<int16_t>(horizontalSum(_mm_add_epi32(low, high)));
+	sum += static_cast<int16_t>(last);
+
+	return clamp16(sum);
+};
+
+int Blaze::DSP::mix(const int16_t* outputs, const int16_t* volumes, Byte enabled) {
+	__m128i low;
+	__m128i high;
+	multiplyAndShift(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(outputs)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(volumes)),
+		7,
+		low,
+		high
+	);
+
+	const __m128i lowBits = _mm_set_epi32(8, 4, 2, 1);
+	const __m128i highBits = _mm_set_epi32(128, 64, 32, 16);
+	__m128i enabledVector = _mm_set1_epi32(enabled);
+	low = _mm_and_si128(low, _mm_cmpeq_epi32(_mm_and_si128(enabledVector, lowBits), lowBits));
+	high = _mm_and_si128(high, _mm_cmpeq_epi32(_mm_and_si128(enabledVector, highBits), highBits));
+
+	// if neither the positive nor the negative contributions can overflow by themselves, no running total can either
+	const __m128i zero = _mm_setzero_si128();
+	__m128i lowPositive = _mm_cmpgt_epi32(low, zero);
+	__m128i highPositive = _mm_cmpgt_epi32(high, zero);
+	int positive = horizontalSum(_mm_add_epi32(_mm_and_si128(low, lowPositive), _mm_and_si128(high, highPositive)));
+	int negative = horizontalSum(_mm_add_epi32(_mm_andnot_si128(lowPositive, low), _mm_andnot_si128(highPositive, high)));
+
+	if (positive > 32767 || negative < -32768) {
+		return mixScalar(outputs, volumes, enabled);
+	}
+
+	return positive + negative;
+};
+
+#else
+
+int Blaze::DSP::fir(const int16_t* history, const int16_t* coefficients) {
+	return firScalar(history, coefficients);
+};
+
+int Blaze::DSP::mix(const int16_t* outputs, const int16_t* volumes, Byte enabled) {
+	return mixScalar(outputs, volumes, enabled);
+};
+
+#endif
+
+void Blaze::DSP::generateSample(ARAM& aram) {
+	if (--_counter < 0) {
+		_counter = COUNTER_RANGE - 1;
+	}
+
+	Byte flags = _registers[DSPRegisters::FLG];
+
+	if (counterFires(flags & DSPFlags::NOISE_RATE_MASK)) {
+		int feedback = (_noise << 13) ^ (_noise << 14);
+		_noise = (feedback & 0x4000) ^ (_noise >> 1);
+	}
+
+	// key on and key off are only processed every other sample
+	Byte keyOnVoices = 0;
+	Byte keyOffVoices = 0;
+	_everyOtherSample = !_everyOtherSample;
+
+	if (_everyOtherSample) {
+		keyOnVoices = _pendingKeyOn;
+		keyOffVoices = _registers[DSPRegisters::KOFF];
+		_pendingKeyOn = 0;
+	}
+
+	Byte pitchModulation = _registers[DSPRegisters::PMON];
+	Byte noiseVoices = _registers[DSPRegisters::NON];
+	std::array<int16_t, VOICE_COUNT> outputs {};
+	int previousOutput = 0;
+
+	for (size_t i = 0; i < VOICE_COUNT; ++i) {
+		auto& voice = _voices[i];
+		Byte bit = 1 << i;
+		Byte* registers = &_registers[i << 4];
+
+		if ((keyOnVoices & bit) != 0) {
+			keyOn(voice, i, aram);
+		}
+
+		if ((keyOffVoices & bit) != 0) {
+			voice.envelopeMode = EnvelopeMode::Release;
+		}
+
+		if ((flags & DSPFlags::SOFT_RESET) != 0) {
+			voice.envelopeMode = EnvelopeMode::Release;
+			voice.envelope = 0;
+		}
+
+		int output = 0;
+
+		if (voice.keyOnDelay > 0) {
+			--voice.keyOnDelay;
+		} else {
+			int sample = ((noiseVoices & bit) != 0) ? static_cast<int16_t>(_noise * 2) : interpolate(voice);
+			output = ((sample * voice.envelope) >> 11) & ~1;
+
+			int pitch = concat16(registers[DSPRegisters::PITCHH] & 0x3f, registers[DSPRegisters::PITCHL]);
+			if (i > 0 && (pitchModulation & bit) != 0) {
+				pitch += ((previousOutput >> 5) * pitch) >> 10;
+			}
+
+			voice.position += std::min(pitch, MAX_PITCH);
+
+			// pitches are below 4 samples per output sample, so at most one block can be finished at a time
+			if (voice.position >= (BLOCK_SAMPLES << POSITION_SHIFT)) {
+				voice.position -= BLOCK_SAMPLES << POSITION_SHIFT;
+				advanceBlock(voice, i, aram);
+			}
+
+			runEnvelope(voice, i);
+		}
+
+		outputs[i] = output;
+		previousOutput = output;
+		registers[DSPRegisters::ENVX] = voice.envelope >> 4;
+		registers[DSPRegisters::OUTX] = output >> 8;
+	}
+
+	Byte echoVoices = _registers[DSPRegisters::EON];
+	std::array<int, 2> mainOutput {
+		mix(outputs.data(), _volumes[0].data(), 0xff),
+		mix(outputs.data(), _volumes[1].data(), 0xff),
+	};
+	std::array<int, 2> echoOutput {
+		mix(outputs.data(), _volumes[0].data(), echoVoices),
+		mix(outputs.data(), _volumes[1].data(), echoVoices),
+	};
+
+	// echo: read the oldest sample from the echo buffer and run it through the FIR filter
+	Word echoAddress = (_registers[DSPRegisters::ESA] << 8) + _echoOffset;
+	_echoHistoryPosition = (_echoHistoryPosition + 1) & (FIR_TAPS - 1);
+
+	std::array<int, 2> echoInput;
+	for (size_t channel = 0; channel < 2; ++channel) {
+		Word address = echoAddress + (channel * 2);
+		auto sample = static_cast<int16_t>(concat16(aram[static_cast<Word>(address + 1)], aram[address]));
+		auto& history = _echoHistory[channel];
+
+		history[_echoHistoryPosition] = history[_echoHistoryPosition + FIR_TAPS] = sample >> 1;
+		echoInput[channel] = fir(&history[_echoHistoryPosition + 1], _firCoefficients.data()) & ~1;
+	}
+
+	Sample result;
+	std::array<int, 2> finalOutput;
+	for (size_t channel = 0; channel < 2; ++channel) {
+		Byte offset = channel << 4;
+		int output = static_cast<int16_t>((mainOutput[channel] * static_cast<int8_t>(_registers[DSPRegisters::MVOLL + offset])) >> 7);
+		output += static_cast<int16_t>((echoInput[channel] * static_cast<int8_t>(_registers[DSPRegisters::EVOLL + offset])) >> 7);
+		finalOutput[channel] = ((flags & DSPFlags::MUTE) != 0) ? 0 : clamp16(output);
+
+		// feed the echo (plus feedback) back into the echo buffer
+		int feedback = echoOutput[channel] + static_cast<int16_t>((echoInput[channel] * static_cast<int8_t>(_registers[DSPRegisters::EFB])) >> 7);
+		feedback = clamp16(feedback) & ~1;
+
+		if ((flags & DSPFlags::ECHO_WRITE_DISABLE) == 0) {
+			Word address = echoAddress + (channel * 2);
+			aram[address] = feedback & 0xff;
+			aram[static_cast<Word>(address + 1)] = (feedback >> 8) & 0xff;
+			aramWritten(address);
+			aramWritten(address + 1);
+		}
+	}
+
+	// the echo buffer length only changes when the buffer wraps around
+	if (_echoOffset == 0) {
+		_echoLength = (_registers[DSPRegisters::EDL] & 0x0f) * 0x800;
+	}
+
+	_echoOffset += 4;
+	if (_echoOffset >= _echoLength) {
+		_echoOffset = 0;
+	}
+
+	result.left = finalOutput[0];
+	result.right = finalOutput[1];
+
+	if (_output.size() < MAX_BUFFERED_SAMPLES) {
+		_output.push_back(result);
+	}
+};
@@ -0,0 +1,210 @@
+#include <blaze/IdleLoopDetector.hpp>
+#include <blaze/Bus.hpp>
+#include <blaze/util.hpp>
+
+namespace Blaze {
+	// reading these has no side effects beyond the first read (which clears their flags),
+	// and they only change on scheduled events (a new scanline, hblank, or a timer IRQ)
+	static constexpr Word STATUS_REGISTERS_START = 0x4210; // RDNMI
+	static constexpr Word STATUS_REGISTERS_END = 0x4212; // HVBJOY
+} // namespace Blaze
+
+bool Blaze::IdleLoopDetector::CPUState::operator==(const CPUState& other) const {
+	return A == other.A && X == other.X && Y == other.Y && DR == other.DR && DBR == other.DBR && P == other.P && e == other.e;
+};
+
+void Blaze::IdleLoopDetector::reset() {
+	_loopStart = NO_LOOP;
+	_loopEnd = NO_LOOP;
+	_decodedStart = NO_LOOP;
+	_decodedEnd = NO_LOOP;
+};
+
+bool Blaze::IdleLoopDetector::check(Bus& bus) {
+	auto& cpu = bus.cpu;
+
+	if (cpu.stopped || cpu.waitingForInterrupt) {
+		return true;
+	}
+
+	Address executed = cpu.executingPC;
+	Address next = concat24(cpu.PBR, cpu.PC);
+
+	if (next <= executed && executed - next < MAX_LOOP_SIZE) {
+		// we just went back to the start of a (potential) loop
+		auto state = captureState(bus);
+
+		if (next != _loopStart || executed != _loopEnd || !(state == _loopState)) {
+			_loopStart = next;
+			_loopEnd = executed;
+			_loopState = state;
+			return false;
+		}
+
+		// the last trip around the loop didn't change anything; now it just has to be a loop that can't change anything by itself
+		Byte flags = cpu.P & (CPU::flags::m | CPU::flags::x);
+
+		if (_decodedStart != _loopStart || _decodedEnd != _loopEnd || _decodedFlags != flags) {
+			_decodedStart = _loopStart;
+			_decodedEnd = _loopEnd;
+			_decodedFlags = flags;
+			_decodedIsPolling = isPollingLoop(bus, _loopStart, _loopEnd);
+		}
+
+		return _decodedIsPolling;
+	}
+
+	if (executed < _loopStart || executed > _loopEnd) {
+		// we left the loop (e.g. for an interrupt handler), so it has to be verified from scratch when we come back
+		_loopStart = NO_LOOP;
+		_loopEnd = NO_LOOP;
+	}
+
+	return false;
+};
+
+Blaze::IdleLoopDetector::CPUState Blaze::IdleLoopDetector::captureState(const Bus& bus) {
+	const auto& cpu = bus.cpu;
+
+	CPUState state;
+	state.A = cpu.A.forceLoadFull();
+	state.X = cpu.X.forceLoadFull();
+	state.Y = cpu.Y.forceLoadFull();
+	state.DR = cpu.DR;
+	state.DBR = cpu.DBR;
+	state.P = cpu.P;
+	state.e = cpu.e;
+	return state;
+};
+
+bool Blaze::IdleLoopDetector::isStableSource(Bus& bus, Address address) {
+	Byte bank;
+	Word addr;
+	split24(address, bank, addr);
+
+	if ((bank & 0x7f) <= 0x3f && addr >= STATUS_REGISTERS_START && addr <= STATUS_REGISTERS_END) {
+		return true;
+	}
+
+	// RAM, ROM, and SRAM can only be changed by the CPU itself (or DMA, which only the CPU can start)
+	Byte value;
+	return bus.peek8(address, value);
+};
+
+bool Blaze::IdleLoopDetector::isPollingLoop(Bus& bus, Address start, Address end) {
+	auto& cpu = bus.cpu;
+	bool accumulator8Bit = cpu.memoryAndAccumulatorAre8Bit();
+	bool index8Bit = cpu.indexRegistersAre8Bit();
+	Byte bank = start >> 16;
+	Address address = start;
+
+	auto peekOperand = [&](Byte byteCount, Address& operand) {
+		operand = 0;
+
+		for (Byte i = 0; i < byteCount; ++i) {
+			Byte value;
+			if (!bus.peek8(concat24(bank, (address + 1 + i) & 0xffff), value)) {
+				return false;
+			}
+			operand |= static_cast<Address>(value) << (i * 8);
+		}
+
+		return true;
+	};
+
+	while (address <= end) {
+		Byte opcode;
+		if (!bus.peek8(address, opcode)) {
+			return false;
+		}
+
+		auto info = CPU::decodeInstruction(opcode, accumulator8Bit, index8Bit);
+		Address operand;
+
+		if (info.opcode == CPU::Opcode::INVALID || !peekOperand(info.size - 1, operand)) {
+			return false;
+		}
+
+		if (address == end) {
+			// the loop has to end by going back to its start
+			Word nextPC = (address + info.size) & 0xffff;
+
+			switch (info.opcode) {
+				case CPU::Opcode::BRA:
+					return concat24(bank, nextPC + static_cast<int8_t>(operand)) == start;
+
+				case CPU::Opcode::BRL:
+					return concat24(bank, nextPC + static_cast<int16_t>(operand)) == start;
+
+				case CPU::Opcode::JMP:
+					if (info.addressingMode == CPU::AddressingMode::Absolute) {
+						return concat24(bank, operand) == start;
+					} else if (info.addressingMode == CPU::AddressingMode::AbsoluteLong) {
+						return operand == start;
+					}
+					return false;
+
+				default:
+					return false;
+			}
+		}
+
+		// everything else in the loop can only read from stable sources (or not access memory at all)
+		bool accessIs8Bit = accumulator8Bit;
+
+		switch (info.opcode) {
+			case CPU::Opcode::LDX:
+			case CPU::Opcode::LDY:
+			case CPU::Opcode::CPX:
+			case CPU::Opcode::CPY:
+				accessIs8Bit = index8Bit;
+				break;
+
+			case CPU::Opcode::LDA:
+			case CPU::Opcode::BIT:
+			case CPU::Opcode::CMP:
+			case CPU::Opcode::AND:
+			case CPU::Opcode::ORA:
+			case CPU::Opcode::EOR:
+				break;
+
+			case CPU::Opcode::NOP:
+				address += info.size;
+				continue;
+
+			default:
+				return false;
+		}
+
+		Address source;
+
+		switch (info.addressingMode) {
+			case CPU::AddressingMode::Immediate:
+				address += info.size;
+				continue;
+
+			case CPU::AddressingMode::Absolute:
+				source = concat24(cpu.DBR, operand);
+				break;
+
+			case CPU::AddressingMode::AbsoluteLong:
+				source = operand;
+				break;
+
+			case CPU::AddressingMode::Direct:
+				source = (cpu.DR + operand) & 0xffff;
+				break;
+
+			default:
+				return false;
+		}
+
+		if (!isStableSource(bus, source) || (!accessIs8Bit && !isStableSource(bus, (source + 1) & 0xffffff))) {
+			return false;
+		}
+
+		address += info.size;
+	}
+
+	return false;
+};
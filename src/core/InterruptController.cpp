@@ -0,0 +1,204 @@
+#include <blaze/InterruptController.hpp>
+#include <blaze/CPU.hpp>
+#include <blaze/util.hpp>
+
+Blaze::Address Blaze::InterruptController::read(Address offset, Byte bitSize) {
+	switch (offset) {
+		case Registers::NMITIMEN:
+			return _nmitimen;
+
+		case Registers::RDNMI: {
+			Byte value = _vblankFlag ? (1 << 7) : 0;
+
+			// reading clears the vblank flag (unless forced blanking is holding it)
+			if (!_forcedBlanking) {
+				_vblankFlag = false;
+			}
+
+			return value;
+		}
+
+		case Registers::TIMEUP:
+			// reading acknowledges the timer IRQ
+			return _irqLine.exchange(false, std::memory_order_acq_rel) ? (1 << 7) : 0;
+
+		case Registers::HVBJOY:
+			return (_vblank ? (1 << 7) : 0) | (_position >= HBLANK_START ? (1 << 6) : 0) | (_autoJoypadReadScanlines > 0 ? (1 << 0) : 0);
+
+		default:
+			return 0;
+	}
+};
+
+void Blaze::InterruptController::write(Address offset, Byte bitSize, Address value) {
+	switch (offset) {
+		case Registers::NMITIMEN: {
+			auto prev = _nmitimen;
+			_nmitimen = value;
+
+			// enabling NMIs while the vblank flag is still set triggers one right away
+			if ((prev & NMITIMENFlags::NMI) == 0 && (_nmitimen & NMITIMENFlags::NMI) != 0 && _vblankFlag) {
+				_nmiPending.store(true, std::memory_order_release);
+			}
+
+			// disabling the timer also acknowledges its IRQ
+			if ((_nmitimen & (NMITIMENFlags::H_IRQ | NMITIMENFlags::V_IRQ)) == 0) {
+				_irqLine.store(false, std::memory_order_release);
+			}
+
+			scheduleTimer();
+		} break;
+
+		case Registers::HTIMEL:
+			_htime = (_htime & 0x100) | value;
+			scheduleTimer();
+			break;
+		case Registers::HTIMEH:
+			_htime = (_htime & 0xff) | ((value & 1) << 8);
+			scheduleTimer();
+			break;
+		case Registers::VTIMEL:
+			_vtime = (_vtime & 0x100) | value;
+			scheduleTimer();
+			break;
+		case Registers::VTIMEH:
+			_vtime = (_vtime & 0xff) | ((value & 1) << 8);
+			scheduleTimer();
+			break;
+
+		default:
+			break;
+	}
+};
+
+void Blaze::InterruptController::reset(Bus* bus) {
+	_nmitimen = 0;
+	_htime = 0x1ff;
+	_vtime = 0x1ff;
+	_vblank = false;
+	_vblankFlag = false;
+	_forcedBlanking = false;
+	_scanline = 0;
+	_position = 0;
+	_nextEvent = NO_EVENT;
+	_timerFired = false;
+	_autoJoypadReadScanlines = 0;
+	_nmiPending.store(false, std::memory_order_release);
+	_irqLine.store(false, std::memory_order_release);
+};
+
+void Blaze::InterruptController::copyStateFrom(const InterruptController& other) {
+	_nmitimen = other._nmitimen;
+	_htime = other._htime;
+	_vtime = other._vtime;
+	_vblank = other._vblank;
+	_vblankFlag = other._vblankFlag;
+	_forcedBlanking = other._forcedBlanking;
+	_scanline = other._scanline;
+	_position = other._position;
+	_nextEvent = other._nextEvent;
+	_timerFired = other._timerFired;
+	_autoJoypadReadScanlines = other._autoJoypadReadScanlines;
+	_nmiPending.store(other.nmiPending(), std::memory_order_release);
+	_irqLine.store(other.irqAsserted(), std::memory_order_release);
+};
+
+void Blaze::InterruptController::beginScanline(uint16_t scanline) {
+	_scanline = scanline;
+	_position = 0;
+	_timerFired = false;
+
+	if (_autoJoypadReadScanlines > 0) {
+		--_autoJoypadReadScanlines;
+	}
+
+	scheduleTimer();
+	advance(0);
+};
+
+void Blaze::InterruptController::beginAutoJoypadRead() {
+	_autoJoypadReadScanlines = AUTO_JOYPAD_READ_SCANLINES;
+};
+
+void Blaze::InterruptController::beginVBlank() {
+	_vblank = true;
+	raiseVBlankFlag();
+};
+
+void Blaze::InterruptController::endVBlank() {
+	_vblank = false;
+
+	if (!_forcedBlanking) {
+		_vblankFlag = false;
+	}
+};
+
+void Blaze::InterruptController::setForcedBlanking(bool forcedBlanking) {
+	_forcedBlanking = forcedBlanking;
+
+	if (_forcedBlanking) {
+		raiseVBlankFlag();
+	}
+};
+
+void Blaze::InterruptController::service(CPU& cpu) {
+	if (_nmiPending.exchange(false, std::memory_order_acq_rel)) {
+		cpu.nmi();
+		return;
+	}
+
+	// a masked IRQ still wakes the CPU up from WAI (`irq` takes care of not entering the handler)
+	if (irqAsserted() && (cpu.waitingForInterrupt || !cpu.getFlag(CPU::flags::i))) {
+		cpu.irq();
+	}
+};
+
+void Blaze::InterruptController::raiseVBlankFlag() {
+	auto prev = _vblankFlag;
+	_vblankFlag = true;
+
+	if (!prev && (_nmitimen & NMITIMENFlags::NMI) != 0) {
+		_nmiPending.store(true, std::memory_order_release);
+	}
+};
+
+void Blaze::InterruptController::scheduleTimer() {
+	uint64_t event = NO_EVENT;
+
+	switch (_nmitimen & (NMITIMENFlags::H_IRQ | NMITIMENFlags::V_IRQ)) {
+		case NMITIMENFlags::H_IRQ:
+			// every scanline, at dot HTIME
+			event = _htime * MASTER_CLOCKS_PER_DOT;
+			break;
+
+		case NMITIMENFlags::V_IRQ:
+			// at the start of scanline VTIME
+			if (_scanline == _vtime) {
+				event = 0;
+			}
+			break;
+
+		case NMITIMENFlags::H_IRQ | NMITIMENFlags::V_IRQ:
+			// at dot HTIME of scanline VTIME
+			if (_scanline == _vtime) {
+				event = _htime * MASTER_CLOCKS_PER_DOT;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	// the timer only fires once per scanline, and not at all if the beam is already past it
+	if (_timerFired || event < _position) {
+		event = NO_EVENT;
+	}
+
+	_nextEvent = event;
+};
+
+void Blaze::InterruptController::fireTimer() {
+	_nextEvent = NO_EVENT;
+	_timerFired = true;
+	_irqLine.store(true, std::memory_order_release);
+};
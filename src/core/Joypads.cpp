@@ -0,0 +1,30 @@
+#include <blaze/Joypads.hpp>
+#include <blaze/util.hpp>
+
+Blaze::Byte Blaze::Joypads::registerSize(Address offset, Byte attemptedAccessSize) {
+	return 8;
+};
+
+Blaze::Address Blaze::Joypads::read(Address offset, Byte bitSize) {
+	if (offset < Registers::JOY1L || offset > Registers::JOY4H) {
+		return 0;
+	}
+
+	auto index = offset - Registers::JOY1L;
+	auto latched = _latched[index / 2];
+
+	return ((index & 1) == 0) ? lo8(latched) : hi8(latched, true);
+};
+
+void Blaze::Joypads::write(Address offset, Byte bitSize, Address value) {
+	// read-only
+};
+
+void Blaze::Joypads::reset(Bus* bus) {
+	_buttons.fill(0);
+	_latched.fill(0);
+};
+
+void Blaze::Joypads::autoRead() {
+	_latched = _buttons;
+};
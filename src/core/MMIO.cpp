@@ -3,3 +3,7 @@
 Blaze::Byte Blaze::MMIODevice::registerSize(Address offset, Byte attemptedAccessSize) {
 	return attemptedAccessSize;
 };
+
+std::unique_ptr<Blaze::MMIODevice> Blaze::MMIODevice::fork(Bus* bus) {
+	return nullptr;
+};
@@ -8,9 +8,8 @@ Blaze::MemRam::MemRam() {
 }
 
 void Blaze::MemRam::reset(Bus* bus) {
-	for (Byte & i : data) {
-		i = 0;
-	}
+	_data.fill(0);
+	_dirty.clear();
 };
 
 Blaze::Byte Blaze::MemRam::registerSize(Address offset, Byte attemptedAccessSize) {
@@ -19,9 +18,18 @@ Blaze::Byte Blaze::MemRam::registerSize(Address offset, Byte attemptedAccessSize
 
 Blaze::Address Blaze::MemRam::read(Address offset, Byte bitSize) {
 	assert(bitSize == 8);
-	return data[offset];
+	return _data.read(offset);
 };
 
 void Blaze::MemRam::write(Address offset, Byte bitSize, Address value) {
-	data[offset] = value;
+	_data.write(offset, value);
+	_dirty.mark(offset);
+};
+
+void Blaze::MemRam::shareFrom(const MemRam& other) {
+	_data.shareFrom(other._data);
+};
+
+uint32_t Blaze::MemRam::sharedPageCount() const {
+	return _data.sharedPageCount();
 };
@@ -1,35 +1,21 @@
 #include <blaze/MulDiv.hpp>
 #include <blaze/util.hpp>
 
-struct MulDivMMIORegisters {
-	enum IgnoreMe: Blaze::Byte {
-		WRMPYA = Blaze::MULDIV_BLOCK1_OFFSET_BEGIN + 0,
-		WRMPYB = Blaze::MULDIV_BLOCK1_OFFSET_BEGIN + 1,
-		WRDIVL = Blaze::MULDIV_BLOCK1_OFFSET_BEGIN + 2,
-		WRDIVH = Blaze::MULDIV_BLOCK1_OFFSET_BEGIN + 3,
-		WRDIVB = Blaze::MULDIV_BLOCK1_OFFSET_BEGIN + 4,
-		RDDIVL = Blaze::MULDIV_BLOCK2_OFFSET_BEGIN + 0,
-		RDDIVH = Blaze::MULDIV_BLOCK2_OFFSET_BEGIN + 1,
-		RDMPYL = Blaze::MULDIV_BLOCK2_OFFSET_BEGIN + 2,
-		RDMPYH = Blaze::MULDIV_BLOCK2_OFFSET_BEGIN + 3,
-	};
-};
-
 Blaze::Byte Blaze::MulDiv::registerSize(Address offset, Byte attemptedAccessSize) {
 	return 8;
 };
 
 Blaze::Address Blaze::MulDiv::read(Address offset, Byte bitSize) {
 	switch (offset) {
-		case MulDivMMIORegisters::WRMPYA: return _mulA;
-		case MulDivMMIORegisters::WRMPYB: return _mulB;
-		case MulDivMMIORegisters::WRDIVL: return lo8(_dividend);
-		case MulDivMMIORegisters::WRDIVH: return hi8(_dividend, true);
-		case MulDivMMIORegisters::WRDIVB: return _divisor;
-		case MulDivMMIORegisters::RDDIVL: return lo8(_quotient);
-		case MulDivMMIORegisters::RDDIVH: return hi8(_quotient, true);
-		case MulDivMMIORegisters::RDMPYL: return lo8(_productOrRemainder);
-		case MulDivMMIORegisters::RDMPYH: return hi8(_productOrRemainder, true);
+		case Registers::WRMPYA: return _mulA;
+		case Registers::WRMPYB: return _mulB;
+		case Registers::WRDIVL: return lo8(_dividend);
+		case Registers::WRDIVH: return hi8(_dividend, true);
+		case Registers::WRDIVB: return _divisor;
+		case Registers::RDDIVL: return lo8(_quotient);
+		case Registers::RDDIVH: return hi8(_quotient, true);
+		case Registers::RDMPYL: return lo8(_productOrRemainder);
+		case Registers::RDMPYH: return hi8(_productOrRemainder, true);
 
 		default:
 			return 0;
@@ -38,20 +24,20 @@ Blaze::Address Blaze::MulDiv::read(Address offset, Byte bitSize) {
 
 void Blaze::MulDiv::write(Address offset, Byte bitSize, Address value) {
 	switch (offset) {
-		case MulDivMMIORegisters::WRMPYA:
+		case Registers::WRMPYA:
 			_mulA = value;
 			break;
-		case MulDivMMIORegisters::WRMPYB:
+		case Registers::WRMPYB:
 			_mulB = value;
 			_productOrRemainder = static_cast<Word>(_mulA) * static_cast<Word>(_mulB);
 			break;
-		case MulDivMMIORegisters::WRDIVL:
+		case Registers::WRDIVL:
 			_dividend = hi8(_dividend, false) | value;
 			break;
-		case MulDivMMIORegisters::WRDIVH:
+		case Registers::WRDIVH:
 			_dividend = lo8(_dividend) | (value << 8);
 			break;
-		case MulDivMMIORegisters::WRDIVB:
+		case Registers::WRDIVB:
 			_divisor = value;
 			if (_divisor == 0) {
 				_quotient = 0xffff;
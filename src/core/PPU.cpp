@@ -0,0 +1,1577 @@
+#include <blaze/PPU.hpp>
+#include <blaze/Bus.hpp>
+#include <blaze/ColorMath.hpp>
+#include <cassert>
+#include <algorithm>
+#include <blaze/debug.hpp>
+
+namespace Blaze {
+	static constexpr int snesWidth = 256;
+	static constexpr int snesHeight = 224;
+};
+
+struct PPUMMIORegister {
+	enum IgnoreMe: Blaze::Address {
+		INIDISP     = 0x00,
+		OBJSEL      = 0x01,
+		OAMADDL     = 0x02,
+		OAMADDH     = 0x03,
+		OAMDATA     = 0x04,
+		BGMODE      = 0x05,
+		MOSAIC      = 0x06,
+		BG1SC       = 0x07,
+		BG2SC       = 0x08,
+		BG3SC       = 0x09,
+		BG4SC       = 0x0A,
+		BG12NBA     = 0x0B,
+		BG34NBA     = 0x0C,
+		BG1HOFS     = 0x0D,
+		M7HOFS      = 0x0D,
+		BG1VOFS     = 0x0E,
+		M7VOFS      = 0x0E,
+		BG2HOFS     = 0x0F,
+		BG2VOFS     = 0x10,
+		BG3HOFS     = 0x11,
+		BG3VOFS     = 0x12,
+		BG4HOFS     = 0x13,
+		BG4VOFS     = 0x14,
+		VMAIN       = 0x15,
+		VMADDL      = 0x16,
+		VMADDH      = 0x17,
+		VMDATAL     = 0x18,
+		VMDATAH     = 0x19,
+		M7SEL       = 0x1A,
+		M7A         = 0x1B,
+		M7B         = 0x1C,
+		M7C         = 0x1D,
+		M7D         = 0x1E,
+		M7X         = 0x1F,
+		M7Y         = 0x20,
+		CGADD       = 0x21,
+		CGDATA      = 0x22,
+		W12SEL      = 0x23,
+		W34SEL      = 0x24,
+		WOBJSEL     = 0x25,
+		WH0         = 0x26,
+		WH1         = 0x27,
+		WH2         = 0x28,
+		WH3         = 0x29,
+		WBGLOG      = 0x2A,
+		WOBJLOG     = 0x2B,
+		TM          = 0x2C,
+		TS          = 0x2D,
+		TMW         = 0x2E,
+		TSW         = 0x2F,
+		CGWSEL      = 0x30,
+		CGADSUB     = 0x31,
+		COLDATA     = 0x32,
+		SETINI      = 0x33,
+		MPYL        = 0x34,
+		MPYM        = 0x35,
+		MPYH        = 0x36,
+		SLHV        = 0x37,
+		OAMDATAREAD = 0x38,
+		VMDATALREAD = 0x39,
+		VMDATAHREAD = 0x3A,
+		CGDATAREAD  = 0x3B,
+		OPHCT       = 0x3C,
+		OPVCT       = 0x3D,
+		STAT77      = 0x3E,
+		STAT78      = 0x3F,
+	};
+};
+
+void Blaze::PPU::Background::reset() {
+	tilemapAddressAndSize = 0;
+	nba = 0;
+	horizontalScroll = 0;
+	verticalScroll = 0;
+	windowMaskLogic = WindowMaskLogic::OR;
+
+	doubleCharSize = false;
+	enableMosaic = false;
+	enableWindow1 = false;
+	invertWindow1 = false;
+	enableWindow2 = false;
+	invertWindow2 = false;
+	enableOnMainScreen = false;
+	enableOnSubscreen = false;
+	enableWindowsOnMainScreen = false;
+	enableWindowsOnSubscreen = false;
+	enableColorMath = false;
+};
+
+Blaze::Byte Blaze::PPU::registerSize(Address offset, Byte attemptedAccessSize) {
+	return 8;
+};
+
+Blaze::Address Blaze::PPU::read(Address offset, Byte bitSize) {
+	if (_shadow != nullptr) {
+		switch (offset) {
+			case PPUMMIORegister::OAMDATAREAD:
+			case PPUMMIORegister::VMDATALREAD:
+			case PPUMMIORegister::VMDATAHREAD:
+			case PPUMMIORegister::CGDATAREAD:
+				// these advance addresses and refill latches, so the render thread needs to see them too
+				_commands.push_back({ CommandType::Read, offset, 0 });
+				break;
+		}
+	}
+
+	switch (offset) {
+		case PPUMMIORegister::INIDISP: return _inidisp;
+		case PPUMMIORegister::OBJSEL:  return _objsel;
+		case PPUMMIORegister::OAMADDL: return (_oamByteAddress >> 1) & 0xff;
+		case PPUMMIORegister::OAMADDH: return ((_oamByteAddress >> 9) & 1) | (_oamPriorityRotation ? (1 << 7) : 0);
+		case PPUMMIORegister::BGMODE:  return _bgmode;
+		case PPUMMIORegister::MOSAIC:  return _mosaic;
+		case PPUMMIORegister::BG1SC:   return _backgrounds[0].tilemapAddressAndSize;
+		case PPUMMIORegister::BG2SC:   return _backgrounds[1].tilemapAddressAndSize;
+		case PPUMMIORegister::BG3SC:   return _backgrounds[2].tilemapAddressAndSize;
+		case PPUMMIORegister::BG4SC:   return _backgrounds[3].tilemapAddressAndSize;
+		case PPUMMIORegister::BG12NBA: return _backgrounds[0].nba | (_backgrounds[1].nba << 4);
+		case PPUMMIORegister::BG34NBA: return _backgrounds[2].nba | (_backgrounds[3].nba << 4);
+		case PPUMMIORegister::VMAIN:   return _vmain;
+		case PPUMMIORegister::VMADDL:  return _vramWordAddress & 0xff;
+		case PPUMMIORegister::VMADDH:  return (_vramWordAddress >> 8) & 0xff;
+		case PPUMMIORegister::CGADD:   return _cgramWordAddress;
+		case PPUMMIORegister::W12SEL:  return
+			getBit<Byte>(0, _backgrounds[0].invertWindow1) |
+			getBit<Byte>(1, _backgrounds[0].enableWindow1) |
+			getBit<Byte>(2, _backgrounds[0].invertWindow2) |
+			getBit<Byte>(3, _backgrounds[0].enableWindow2) |
+			getBit<Byte>(4, _backgrounds[1].invertWindow1) |
+			getBit<Byte>(5, _backgrounds[1].enableWindow1) |
+			getBit<Byte>(6, _backgrounds[1].invertWindow2) |
+			getBit<Byte>(7, _backgrounds[1].enableWindow2) ;
+		case PPUMMIORegister::W34SEL:  return
+			getBit<Byte>(0, _backgrounds[2].invertWindow1) |
+			getBit<Byte>(1, _backgrounds[2].enableWindow1) |
+			getBit<Byte>(2, _backgrounds[2].invertWindow2) |
+			getBit<Byte>(3, _backgrounds[2].enableWindow2) |
+			getBit<Byte>(4, _backgrounds[3].invertWindow1) |
+			getBit<Byte>(5, _backgrounds[3].enableWindow1) |
+			getBit<Byte>(6, _backgrounds[3].invertWindow2) |
+			getBit<Byte>(7, _backgrounds[3].enableWindow2) ;
+		case PPUMMIORegister::WOBJSEL:  return
+			getBit<Byte>(0, _invertSpriteWindow1) |
+			getBit<Byte>(1, _enableSpriteWindow1) |
+			getBit<Byte>(2, _invertSpriteWindow2) |
+			getBit<Byte>(3, _enableSpriteWindow2) |
+			getBit<Byte>(4, _invertColorWindow1)  |
+			getBit<Byte>(5, _enableColorWindow1)  |
+			getBit<Byte>(6, _invertColorWindow2)  |
+			getBit<Byte>(7, _enableColorWindow2)  ;
+		case PPUMMIORegister::WH0:      return _window1Left;
+		case PPUMMIORegister::WH1:      return _window1Right;
+		case PPUMMIORegister::WH2:      return _window2Left;
+		case PPUMMIORegister::WH3:      return _window2Right;
+		case PPUMMIORegister::WBGLOG:   return
+			(static_cast<Byte>(_backgrounds[0].windowMaskLogic) << 0) |
+			(static_cast<Byte>(_backgrounds[1].windowMaskLogic) << 2) |
+			(static_cast<Byte>(_backgrounds[2].windowMaskLogic) << 4) |
+			(static_cast<Byte>(_backgrounds[3].windowMaskLogic) << 6) ;
+		case PPUMMIORegister::WOBJLOG:  return (static_cast<Byte>(_spriteWindowMaskLogic) << 0) | (static_cast<Byte>(_colorWindowMaskLogic) << 2);
+		case PPUMMIORegister::TM:       return
+			getBit<Byte>(0, _backgrounds[0].enableOnMainScreen) |
+			getBit<Byte>(1, _backgrounds[1].enableOnMainScreen) |
+			getBit<Byte>(2, _backgrounds[2].enableOnMainScreen) |
+			getBit<Byte>(3, _backgrounds[3].enableOnMainScreen) |
+			getBit<Byte>(4, _enableSpriteOnMainScreen)          ;
+		case PPUMMIORegister::TS:       return
+			getBit<Byte>(0, _backgrounds[0].enableOnSubscreen) |
+			getBit<Byte>(1, _backgrounds[1].enableOnSubscreen) |
+			getBit<Byte>(2, _backgrounds[2].enableOnSubscreen) |
+			getBit<Byte>(3, _backgrounds[3].enableOnSubscreen) |
+			getBit<Byte>(4, _enableSpriteOnSubscreen)          ;
+		case PPUMMIORegister::TMW:      return
+			getBit<Byte>(0, _backgrounds[0].enableWindowsOnMainScreen) |
+			getBit<Byte>(1, _backgrounds[1].enableWindowsOnMainScreen) |
+			getBit<Byte>(2, _backgrounds[2].enableWindowsOnMainScreen) |
+			getBit<Byte>(3, _backgrounds[3].enableWindowsOnMainScreen) |
+			getBit<Byte>(4, _enableSpriteWindowsOnMainScreen)          ;
+		case PPUMMIORegister::TSW:      return
+			getBit<Byte>(0, _backgrounds[0].enableWindowsOnSubscreen) |
+			getBit<Byte>(1, _backgrounds[1].enableWindowsOnSubscreen) |
+			getBit<Byte>(2, _backgrounds[2].enableWindowsOnSubscreen) |
+			getBit<Byte>(3, _backgrounds[3].enableWindowsOnSubscreen) |
+			getBit<Byte>(4, _enableSpriteWindowsOnSubscreen)          ;
+		case PPUMMIORegister::CGWSEL:   return _cgwsel;
+		case PPUMMIORegister::CGADSUB:  return
+			getBit<Byte>(0, _backgrounds[0].enableColorMath) |
+			getBit<Byte>(1, _backgrounds[1].enableColorMath) |
+			getBit<Byte>(2, _backgrounds[2].enableColorMath) |
+			getBit<Byte>(3, _backgrounds[3].enableColorMath) |
+			getBit<Byte>(4, _enableSpriteColorMath)          |
+			getBit<Byte>(5, _enableBackdropColorMath)        |
+			getBit<Byte>(6, _halfColorMath)                  |
+			getBit<Byte>(7, _colorMathMinus)                 ;
+		case PPUMMIORegister::SETINI:   return _setini;
+
+		// signed 16-bit M7A times the signed 8-bit value last written to M7B
+		case PPUMMIORegister::MPYL: return  (static_cast<int32_t>(static_cast<int16_t>(_mode7A)) * static_cast<int8_t>(_mode7B >> 8))        & 0xff;
+		case PPUMMIORegister::MPYM: return ((static_cast<int32_t>(static_cast<int16_t>(_mode7A)) * static_cast<int8_t>(_mode7B >> 8)) >>  8) & 0xff;
+		case PPUMMIORegister::MPYH: return ((static_cast<int32_t>(static_cast<int16_t>(_mode7A)) * static_cast<int8_t>(_mode7B >> 8)) >> 16) & 0xff;
+
+		case PPUMMIORegister::STAT77:
+			// bits 0-3 are the PPU1 version number
+			return getBit<Byte>(6, _spriteRangeOver) | getBit<Byte>(7, _spriteTimeOver) | 1;
+
+		case PPUMMIORegister::OAMDATAREAD: {
+			auto val = _oamData[_oamByteAddress];
+			_oamByteAddress = (_oamByteAddress + 1) % _oamData.size();
+			return val;
+		} break;
+
+		case PPUMMIORegister::VMDATALREAD: {
+			auto val = lo8(_vramLatch);
+			if (addressIncrementMode() == AddressIncrementMode::Low) {
+				_vramLatch = _vram[_vramWordAddress % _vram.size()];
+				_vramWordAddress = (_vramWordAddress + 1) % _vram.size();
+			}
+			return val;
+		} break;
+
+		case PPUMMIORegister::VMDATAHREAD: {
+			auto val = hi8(_vramLatch, true);
+			if (addressIncrementMode() == AddressIncrementMode::High) {
+				_vramLatch = _vram[_vramWordAddress % _vram.size()];
+				_vramWordAddress = (_vramWordAddress + 1) % _vram.size();
+			}
+			return val;
+		} break;
+
+		case PPUMMIORegister::CGDATAREAD: {
+			auto val = _cgram[_cgramWordAddress];
+			if (_cgramHighByte) {
+				_cgramHighByte = false;
+				_cgramWordAddress = (_cgramWordAddress + 1) % _cgram.size();
+				return hi8(val, true);
+			} else {
+				_cgramHighByte = true;
+				return lo8(val);
+			}
+		} break;
+
+		default:
+			return 0;
+	}
+};
+
+void Blaze::PPU::write(Address offset, Byte bitSize, Address value) {
+	if (_shadow != nullptr) {
+		_commands.push_back({ CommandType::Write, offset, value });
+	}
+
+	// the lines reached so far have to be rendered with the state from before this write
+	flushLines();
+
+	switch (offset) {
+		case PPUMMIORegister::INIDISP:
+			_inidisp = value;
+			if (_bus != nullptr) {
+				_bus->interrupts.setForcedBlanking(forcedBlanking());
+			}
+			break;
+		case PPUMMIORegister::OBJSEL:
+			_objsel = value;
+			break;
+		case PPUMMIORegister::OAMADDL:
+			_oamByteAddress = (_oamByteAddress & (1 << 9)) | (value << 1);
+			break;
+		case PPUMMIORegister::OAMADDH:
+			_oamByteAddress = (_oamByteAddress & ~(1 << 9)) | ((value & 1) << 9);
+			_oamPriorityRotation = (value & (1 << 7)) != 0;
+			break;
+		case PPUMMIORegister::OAMDATA: {
+			if ((_oamByteAddress & 1) == 0) {
+				_oamLatch = value;
+			}
+
+			if (_oamByteAddress < 0x200 && (_oamByteAddress & 1) != 0) {
+				_oamData[_oamByteAddress - 1] = _oamLatch;
+				_oamData[_oamByteAddress] = value;
+				_oamDirty.mark(_oamByteAddress);
+				updateSprite(_oamByteAddress / 4);
+			}
+
+			if (_oamByteAddress >= 0x200) {
+				_oamData[_oamByteAddress] = value;
+				_oamDirty.mark(_oamByteAddress);
+
+				// each byte of the high table holds the extra bits for 4 sprites
+				Byte firstSprite = ((_oamByteAddress - 0x200) * 4) % SPRITE_COUNT;
+				for (Byte index = firstSprite; index < firstSprite + 4; ++index) {
+					updateSprite(index);
+				}
+			}
+
+			_oamByteAddress = (_oamByteAddress + 1) % _oamData.size();
+		} break;
+		case PPUMMIORegister::BGMODE:
+			_bgmode = value;
+			break;
+		case PPUMMIORegister::MOSAIC:
+			_mosaic = value;
+			break;
+		case PPUMMIORegister::BG1SC:
+			_backgrounds[0].tilemapAddressAndSize = value;
+			break;
+		case PPUMMIORegister::BG2SC:
+			_backgrounds[1].tilemapAddressAndSize = value;
+			break;
+		case PPUMMIORegister::BG3SC:
+			_backgrounds[2].tilemapAddressAndSize = value;
+			break;
+		case PPUMMIORegister::BG4SC:
+			_backgrounds[3].tilemapAddressAndSize = value;
+			break;
+		case PPUMMIORegister::BG12NBA:
+			_backgrounds[0].nba = value & 0x0f;
+			_backgrounds[1].nba = (value >> 4) & 0x0f;
+			break;
+		case PPUMMIORegister::BG34NBA:
+			_backgrounds[2].nba = value & 0x0f;
+			_backgrounds[3].nba = (value >> 4) & 0x0f;
+			break;
+		case PPUMMIORegister::BG1HOFS:
+			_backgrounds[0].horizontalScroll = (value << 8) | (_bgScrollLatch & ~7) |(_bgHorizontalScrollLatch & 7);
+			_bgScrollLatch = value;
+			_bgHorizontalScrollLatch = value;
+
+			// this is also M7HOFS, which goes through the mode 7 latch instead
+			_mode7HorizontalScroll = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::BG1VOFS:
+			_backgrounds[0].verticalScroll = (value << 8) | (_bgScrollLatch);
+			_bgScrollLatch = value;
+
+			// this is also M7VOFS
+			_mode7VerticalScroll = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::BG2HOFS:
+			_backgrounds[1].horizontalScroll = (value << 8) | (_bgScrollLatch & ~7) |(_bgHorizontalScrollLatch & 7);
+			_bgScrollLatch = value;
+			_bgHorizontalScrollLatch = value;
+			break;
+		case PPUMMIORegister::BG2VOFS:
+			_backgrounds[1].verticalScroll = (value << 8) | (_bgScrollLatch);
+			_bgScrollLatch = value;
+			break;
+		case PPUMMIORegister::BG3HOFS:
+			_backgrounds[2].horizontalScroll = (value << 8) | (_bgScrollLatch & ~7) |(_bgHorizontalScrollLatch & 7);
+			_bgScrollLatch = value;
+			_bgHorizontalScrollLatch = value;
+			break;
+		case PPUMMIORegister::BG3VOFS:
+			_backgrounds[2].verticalScroll = (value << 8) | (_bgScrollLatch);
+			_bgScrollLatch = value;
+			break;
+		case PPUMMIORegister::BG4HOFS:
+			_backgrounds[3].horizontalScroll = (value << 8) | (_bgScrollLatch & ~7) |(_bgHorizontalScrollLatch & 7);
+			_bgScrollLatch = value;
+			_bgHorizontalScrollLatch = value;
+			break;
+		case PPUMMIORegister::BG4VOFS:
+			_backgrounds[3].verticalScroll = (value << 8) | (_bgScrollLatch);
+			_bgScrollLatch = value;
+			break;
+		case PPUMMIORegister::VMAIN:
+			_vmain = value;
+			break;
+		case PPUMMIORegister::M7SEL:
+			_mode7Settings = value;
+			break;
+		case PPUMMIORegister::M7A:
+			_mode7A = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::M7B:
+			_mode7B = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::M7C:
+			_mode7C = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::M7D:
+			_mode7D = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::M7X:
+			_mode7CenterX = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::M7Y:
+			_mode7CenterY = (value << 8) | _mode7Latch;
+			_mode7Latch = value;
+			break;
+		case PPUMMIORegister::VMADDL:
+			_vramWordAddress = hi8(_vramWordAddress, false) | lo8(value);
+			_vramLatch = _vram[_vramWordAddress % _vram.size()];
+			break;
+		case PPUMMIORegister::VMADDH:
+			_vramWordAddress = lo8(_vramWordAddress) | (value << 8);
+			_vramLatch = _vram[_vramWordAddress % _vram.size()];
+			break;
+		case PPUMMIORegister::VMDATAL:
+			_vram.write(_vramWordAddress % _vram.size(), hi8(_vram[_vramWordAddress % _vram.size()], false) | lo8(value));
+			_vramDirty.mark((_vramWordAddress % _vram.size()) * 2);
+			if (addressIncrementMode() == AddressIncrementMode::Low) {
+				_vramWordAddress = (_vramWordAddress + 1) % _vram.size();
+			}
+			break;
+		case PPUMMIORegister::VMDATAH:
+			_vram.write(_vramWordAddress % _vram.size(), lo8(_vram[_vramWordAddress % _vram.size()]) | (value << 8));
+			_vramDirty.mark(((_vramWordAddress % _vram.size()) * 2) + 1);
+			if (addressIncrementMode() == AddressIncrementMode::High) {
+				_vramWordAddress = (_vramWordAddress + 1) % _vram.size();
+			}
+			break;
+		case PPUMMIORegister::CGADD:
+			_cgramWordAddress = value;
+			_cgramHighByte = false;
+			break;
+		case PPUMMIORegister::CGDATA:
+			if (_cgramHighByte) {
+				_cgramHighByte = false;
+				_cgram[_cgramWordAddress] = (value << 8) | _cgramLatch;
+				_cgramDirty.mark(_cgramWordAddress * 2);
+				_palette[_cgramWordAddress] = (*_colorTable)[_cgram[_cgramWordAddress]];
+				_cgramWordAddress = (_cgramWordAddress + 1) % _cgram.size();
+			} else {
+				_cgramHighByte = true;
+				_cgramLatch = value;
+			}
+			break;
+		case PPUMMIORegister::W12SEL:
+			_backgrounds[0].invertWindow1 = testBit(value, 0);
+			_backgrounds[0].enableWindow1 = testBit(value, 1);
+			_backgrounds[0].invertWindow2 = testBit(value, 2);
+			_backgrounds[0].enableWindow2 = testBit(value, 3);
+			_backgrounds[1].invertWindow1 = testBit(value, 4);
+			_backgrounds[1].enableWindow1 = testBit(value, 5);
+			_backgrounds[1].invertWindow2 = testBit(value, 6);
+			_backgrounds[1].enableWindow2 = testBit(value, 7);
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::W34SEL:
+			_backgrounds[2].invertWindow1 = testBit(value, 0);
+			_backgrounds[2].enableWindow1 = testBit(value, 1);
+			_backgrounds[2].invertWindow2 = testBit(value, 2);
+			_backgrounds[2].enableWindow2 = testBit(value, 3);
+			_backgrounds[3].invertWindow1 = testBit(value, 4);
+			_backgrounds[3].enableWindow1 = testBit(value, 5);
+			_backgrounds[3].invertWindow2 = testBit(value, 6);
+			_backgrounds[3].enableWindow2 = testBit(value, 7);
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WOBJSEL:
+			_invertSpriteWindow1 = testBit(value, 0);
+			_enableSpriteWindow1 = testBit(value, 1);
+			_invertSpriteWindow2 = testBit(value, 2);
+			_enableSpriteWindow2 = testBit(value, 3);
+			_invertColorWindow1  = testBit(value, 4);
+			_enableColorWindow1  = testBit(value, 5);
+			_invertColorWindow2  = testBit(value, 6);
+			_enableColorWindow2  = testBit(value, 7);
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WH0:
+			_window1Left = value;
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WH1:
+			_window1Right = value;
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WH2:
+			_window2Left = value;
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WH3:
+			_window2Right = value;
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WBGLOG:
+			_backgrounds[0].windowMaskLogic = static_cast<WindowMaskLogic>((value >> 0) & 3);
+			_backgrounds[1].windowMaskLogic = static_cast<WindowMaskLogic>((value >> 2) & 3);
+			_backgrounds[2].windowMaskLogic = static_cast<WindowMaskLogic>((value >> 4) & 3);
+			_backgrounds[3].windowMaskLogic = static_cast<WindowMaskLogic>((value >> 6) & 3);
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::WOBJLOG:
+			_spriteWindowMaskLogic = static_cast<WindowMaskLogic>((value >> 0) & 3);
+			_colorWindowMaskLogic  = static_cast<WindowMaskLogic>((value >> 2) & 3);
+			_windowMasksDirty = true;
+			break;
+		case PPUMMIORegister::TM:
+			_backgrounds[0].enableOnMainScreen = testBit(value, 0);
+			_backgrounds[1].enableOnMainScreen = testBit(value, 1);
+			_backgrounds[2].enableOnMainScreen = testBit(value, 2);
+			_backgrounds[3].enableOnMainScreen = testBit(value, 3);
+			_enableSpriteOnMainScreen          = testBit(value, 4);
+			break;
+		case PPUMMIORegister::TS:
+			_backgrounds[0].enableOnSubscreen = testBit(value, 0);
+			_backgrounds[1].enableOnSubscreen = testBit(value, 1);
+			_backgrounds[2].enableOnSubscreen = testBit(value, 2);
+			_backgrounds[3].enableOnSubscreen = testBit(value, 3);
+			_enableSpriteOnSubscreen          = testBit(value, 4);
+			break;
+		case PPUMMIORegister::TMW:
+			_backgrounds[0].enableWindowsOnMainScreen = testBit(value, 0);
+			_backgrounds[1].enableWindowsOnMainScreen = testBit(value, 1);
+			_backgrounds[2].enableWindowsOnMainScreen = testBit(value, 2);
+			_backgrounds[3].enableWindowsOnMainScreen = testBit(value, 3);
+			_enableSpriteWindowsOnMainScreen          = testBit(value, 4);
+			break;
+		case PPUMMIORegister::TSW:
+			_backgrounds[0].enableWindowsOnSubscreen = testBit(value, 0);
+			_backgrounds[1].enableWindowsOnSubscreen = testBit(value, 1);
+			_backgrounds[2].enableWindowsOnSubscreen = testBit(value, 2);
+			_backgrounds[3].enableWindowsOnSubscreen = testBit(value, 3);
+			_enableSpriteWindowsOnSubscreen          = testBit(value, 4);
+			break;
+		case PPUMMIORegister::CGWSEL:
+			_cgwsel = value;
+			break;
+		case PPUMMIORegister::CGADSUB:
+			_backgrounds[0].enableColorMath = testBit(value, 0);
+			_backgrounds[1].enableColorMath = testBit(value, 1);
+			_backgrounds[2].enableColorMath = testBit(value, 2);
+			_backgrounds[3].enableColorMath = testBit(value, 3);
+			_enableSpriteColorMath          = testBit(value, 4);
+			_enableBackdropColorMath        = testBit(value, 5);
+			_halfColorMath                  = testBit(value, 6);
+			_colorMathMinus                 = testBit(value, 7);
+			break;
+		case PPUMMIORegister::COLDATA: {
+			Byte colorVal = value & 0x1f;
+			if (testBit(value, 5)) {
+				_fixedRed = colorVal;
+			}
+			if (testBit(value, 6)) {
+				_fixedGreen = colorVal;
+			}
+			if (testBit(value, 7)) {
+				_fixedBlue = colorVal;
+			}
+		} break;
+		case PPUMMIORegister::SETINI:
+			_setini = value;
+			break;
+	}
+};
+
+void Blaze::PPU::reset(Bus* bus) {
+	if (_shadow != nullptr) {
+		_commands.push_back({ CommandType::Reset, 0, 0 });
+	}
+
+	flushLines();
+
+	_bus = bus;
+
+	_inidisp = 0;
+	updatePalette();
+	_objsel = 0;
+	_oamByteAddress = 0;
+	_oamLatch = 0;
+	_bgmode = 0;
+	_mosaic = 0;
+	_vmain = 0;
+	_vramWordAddress = 0;
+	_vramLatch = 0;
+	_cgramWordAddress = 0;
+	_cgramLatch = 0;
+	_window1Left = 0;
+	_window1Right = 0;
+	_window2Left = 0;
+	_window2Right = 0;
+	_spriteWindowMaskLogic = WindowMaskLogic::OR;
+	_colorWindowMaskLogic = WindowMaskLogic::OR;
+	_cgwsel = 0;
+	_fixedBlue = 0;
+	_fixedGreen = 0;
+	_fixedRed = 0;
+	_setini = 0;
+	_bgScrollLatch = 0;
+	_bgHorizontalScrollLatch = 0;
+	_mode7Settings = 0;
+	_mode7Latch = 0;
+	_mode7A = 0;
+	_mode7B = 0;
+	_mode7C = 0;
+	_mode7D = 0;
+	_mode7CenterX = 0;
+	_mode7CenterY = 0;
+	_mode7HorizontalScroll = 0;
+	_mode7VerticalScroll = 0;
+
+	_cgramHighByte = false;
+	_enableSpriteWindow1 = false;
+	_invertSpriteWindow1 = false;
+	_enableSpriteWindow2 = false;
+	_invertSpriteWindow2 = false;
+	_enableColorWindow1 = false;
+	_invertColorWindow1 = false;
+	_enableColorWindow2 = false;
+	_invertColorWindow2 = false;
+	_enableSpriteOnMainScreen = false;
+	_enableSpriteOnSubscreen = false;
+	_enableSpriteWindowsOnMainScreen = false;
+	_enableSpriteWindowsOnSubscreen = false;
+	_enableSpriteColorMath = false;
+	_colorMathMinus = false;
+	_halfColorMath = false;
+	_enableBackdropColorMath = false;
+	_oamPriorityRotation = false;
+	_windowMasksDirty = true;
+	_spriteRangeOver = false;
+	_spriteTimeOver = false;
+
+	for (auto& background: _backgrounds) {
+		background.reset();
+	}
+};
+
+std::unique_ptr<Blaze::MMIODevice> Blaze::PPU::fork(Bus* bus) {
+	std::unique_ptr<PPU> child(new PPU(ForkTag {}));
+
+	child->_bus = bus;
+
+	static_cast<PPURegisterState&>(*child) = *this;
+	child->_backgrounds = _backgrounds;
+	child->_windowMasksDirty = true;
+
+	// OAM and CGRAM are tiny, so they're just copied; VRAM is shared until either PPU writes to it
+	child->_oamData = _oamData;
+	child->_spriteTable = _spriteTable;
+	child->_cgram = _cgram;
+	child->_colorTable = _colorTable;
+	child->_palette = _palette;
+	child->_vram.shareFrom(_vram);
+
+	return child;
+};
+
+// note that we actually render in the opposite order of beginning and ending vblank:
+// we render to the backbuffer after ending vblank, and we swap the backbuffer with the
+// frontbuffer when beginning vblank. this matches the SNES PPU behavior: the vblank
+// period is used for the *software* to set up what will be rendered and then the period
+// *outside* vblank is used by the PPU to perform the rendering.
+
+void Blaze::PPU::presentFrame() {
+	auto* output = _output;
+
+	allocateRenderBuffers();
+
+	if (output->_frameListener) {
+		output->_frameListener(output->_frames[output->_drawingFrame]);
+	}
+
+	// swap the finished frame with the one the presenter is waiting on
+	output->_drawingFrame = output->_readyFrame.exchange(output->_drawingFrame | FRAME_FRESH, std::memory_order_acq_rel) & FRAME_INDEX_MASK;
+};
+
+void Blaze::PPU::beginVBlank() {
+	if (_shadow != nullptr) {
+		_commands.push_back({ CommandType::BeginVBlank, 0, 0 });
+
+		// hand this frame over to the render thread (which will present it once it's done rendering it).
+		// the render thread may still be busy with the previous frame, but we don't let it fall any further behind than that.
+		{
+			std::unique_lock lock(_renderQueueMutex);
+			_renderQueueCondVar.wait(lock, [&]() {
+				return !_frameQueued;
+			});
+			std::swap(_queuedCommands, _commands);
+			_frameQueued = true;
+		}
+		_renderQueueCondVar.notify_all();
+
+		_commands.clear();
+	} else {
+		flushLines();
+
+		if (!_skippingFrame) {
+			presentFrame();
+		}
+	}
+};
+
+void Blaze::PPU::endVBlank() {
+	if (_output == this) {
+		auto frameSkip = _frameSkip.load(std::memory_order_relaxed);
+
+		_skippingFrame = _skippedFrames < frameSkip;
+		_skippedFrames = _skippingFrame ? _skippedFrames + 1 : 0;
+	}
+
+	if (_shadow != nullptr) {
+		_commands.push_back({ CommandType::EndVBlank, 0, _skippingFrame });
+	}
+
+	// begin rendering
+
+	//Blaze::printLine("ppu", "Ended vblank; rendering in mode " + std::to_string(backgroundMode()));
+
+	flushLines();
+
+	// this is also needed when rendering asynchronously, since it determines the STAT77 flags
+	evaluateSprites();
+};
+
+void Blaze::PPU::beginScanline(size_t line) {
+	if (line >= static_cast<size_t>(Blaze::snesHeight) || _skippingFrame) {
+		return;
+	}
+
+	if (_shadow != nullptr) {
+		_commands.push_back({ CommandType::Scanline, static_cast<Address>(line), 0 });
+		return;
+	}
+
+	if (_pendingLineCount != 0 && line != _pendingFirstLine + _pendingLineCount) {
+		flushLines();
+	}
+
+	if (_pendingLineCount == 0) {
+		_pendingFirstLine = line;
+	}
+
+	++_pendingLineCount;
+};
+
+void Blaze::PPU::flushLines() {
+	if (_pendingLineCount == 0) {
+		return;
+	}
+
+	size_t firstLine = _pendingFirstLine;
+	size_t lineCount = _pendingLineCount;
+
+	_pendingLineCount = 0;
+
+	allocateRenderBuffers();
+
+	// the window masks are shared by all the workers, so they need to be up-to-date before any of them start
+	if (_windowMasksDirty) {
+		updateWindowMasks();
+	}
+
+	if (lineCount < MIN_BAND_LINES * 2) {
+		for (size_t line = firstLine; line < firstLine + lineCount; ++line) {
+			renderScanline(line, _lineBuffers[0]);
+		}
+		return;
+	}
+
+	if (!_bandPool) {
+		// the pool is only created once it's needed; most forked PPUs never render anything
+		auto threadCount = std::min(std::thread::hardware_concurrency(), MAX_BAND_WORKERS);
+		_bandPool = std::make_unique<ThreadPool>(threadCount > 1 ? threadCount - 1 : 0);
+		_lineBuffers.resize(_bandPool->workerCount());
+	}
+
+	// each line only depends on the (unchanging) PPU state and its own buffers, so the output is the same no matter how the lines are split up
+	size_t bandCount = std::min(_bandPool->workerCount(), lineCount / MIN_BAND_LINES);
+
+	_bandPool->run(bandCount, [&](size_t band, size_t worker) {
+		size_t bandBegin = firstLine + (lineCount * band) / bandCount;
+		size_t bandEnd = firstLine + (lineCount * (band + 1)) / bandCount;
+
+		for (size_t line = bandBegin; line < bandEnd; ++line) {
+			renderScanline(line, _lineBuffers[worker]);
+		}
+	});
+};
+
+void Blaze::PPU::allocateRenderBuffers() {
+	if (_output->_frames.empty()) {
+		_output->_frames.resize(FRAME_BUFFER_COUNT);
+	}
+
+	if (_lineBuffers.empty()) {
+		_lineBuffers.resize(1);
+	}
+};
+
+void Blaze::PPU::setAsyncRendering(bool enable) {
+	if (enable == (_shadow != nullptr)) {
+		return;
+	}
+
+	flushLines();
+
+	if (enable) {
+		// the render thread starts out with an exact copy of our current state; from then on, it stays in sync by replaying the command log
+		_shadow.reset(static_cast<PPU*>(fork(nullptr).release()));
+		_shadow->_output = this;
+
+		// but unlike a regular fork, it can't share VRAM pages with us: copy-on-write only works for owners on the same thread
+		_shadow->_vram.copyFrom(_vram);
+		_stopRenderThread = false;
+		_frameQueued = false;
+		_renderThread = std::thread(&PPU::renderThreadMain, this);
+	} else {
+		{
+			std::unique_lock lock(_renderQueueMutex);
+			_stopRenderThread = true;
+		}
+		_renderQueueCondVar.notify_all();
+		_renderThread.join();
+
+		// anything recorded for the current frame is simply dropped; our own state is always up-to-date
+		_shadow.reset();
+		_commands.clear();
+		_queuedCommands.clear();
+	}
+};
+
+void Blaze::PPU::renderThreadMain() {
+	while (true) {
+		{
+			std::unique_lock lock(_renderQueueMutex);
+			_renderQueueCondVar.wait(lock, [&]() {
+				return _frameQueued || _stopRenderThread;
+			});
+
+			// finish rendering the queued frame (if any) before stopping
+			if (!_frameQueued) {
+				break;
+			}
+
+			std::swap(_replayCommands, _queuedCommands);
+			_frameQueued = false;
+		}
+		_renderQueueCondVar.notify_all();
+
+		for (const auto& command: _replayCommands) {
+			_shadow->replay(command);
+		}
+
+		_replayCommands.clear();
+	}
+};
+
+void Blaze::PPU::replay(const Command& command) {
+	switch (command.type) {
+		case CommandType::Read:
+			read(command.offset, 8);
+			break;
+		case CommandType::Write:
+			write(command.offset, 8, command.value);
+			break;
+		case CommandType::Reset:
+			reset(nullptr);
+			break;
+		case CommandType::EndVBlank:
+			// the main PPU already decided whether this frame gets skipped
+			_skippingFrame = command.value != 0;
+			endVBlank();
+			break;
+		case CommandType::Scanline:
+			beginScanline(command.offset);
+			break;
+		case CommandType::BeginVBlank:
+			beginVBlank();
+			break;
+	}
+};
+
+// the order in which layers are drawn (from back to front) in each background mode
+static constexpr std::array<Blaze::PPU::LayerSlot, 12> LAYER_ORDER_MODE_0 = {{
+	{ 3, 0 }, { 2, 0 }, { Blaze::PPU::LAYER_OBJ, 0 },
+	{ 3, 1 }, { 2, 1 }, { Blaze::PPU::LAYER_OBJ, 1 },
+	{ 1, 0 }, { 0, 0 }, { Blaze::PPU::LAYER_OBJ, 2 },
+	{ 1, 1 }, { 0, 1 }, { Blaze::PPU::LAYER_OBJ, 3 },
+}};
+
+static constexpr std::array<Blaze::PPU::LayerSlot, 10> LAYER_ORDER_MODE_1 = {{
+	{ 2, 0 }, { Blaze::PPU::LAYER_OBJ, 0 },
+	{ 2, 1 }, { Blaze::PPU::LAYER_OBJ, 1 },
+	{ 1, 0 }, { 0, 0 }, { Blaze::PPU::LAYER_OBJ, 2 },
+	{ 1, 1 }, { 0, 1 }, { Blaze::PPU::LAYER_OBJ, 3 },
+}};
+
+// mode 1 with BG3 priority enabled: high-priority BG3 tiles go above everything else
+static constexpr std::array<Blaze::PPU::LayerSlot, 10> LAYER_ORDER_MODE_1_BG3_HIGH = {{
+	{ 2, 0 }, { Blaze::PPU::LAYER_OBJ, 0 },
+	{ Blaze::PPU::LAYER_OBJ, 1 },
+	{ 1, 0 }, { 0, 0 }, { Blaze::PPU::LAYER_OBJ, 2 },
+	{ 1, 1 }, { 0, 1 }, { Blaze::PPU::LAYER_OBJ, 3 },
+	{ 2, 1 },
+}};
+
+static constexpr std::array<Blaze::PPU::LayerSlot, 8> LAYER_ORDER_OTHER_MODES = {{
+	{ 1, 0 }, { Blaze::PPU::LAYER_OBJ, 0 },
+	{ 0, 0 }, { Blaze::PPU::LAYER_OBJ, 1 },
+	{ 1, 1 }, { Blaze::PPU::LAYER_OBJ, 2 },
+	{ 0, 1 }, { Blaze::PPU::LAYER_OBJ, 3 },
+}};
+
+void Blaze::PPU::composeScreen(ScanlineBuffers& buffers, bool subscreen, uint32_t backdrop, uint32_t* output, Byte* source) {
+	const LayerSlot* order = nullptr;
+	size_t orderSize = 0;
+
+	switch (backgroundMode()) {
+		case 0:
+			order = LAYER_ORDER_MODE_0.data();
+			orderSize = LAYER_ORDER_MODE_0.size();
+			break;
+		case 1:
+			if (mode1HighPriorityBackground3()) {
+				order = LAYER_ORDER_MODE_1_BG3_HIGH.data();
+				orderSize = LAYER_ORDER_MODE_1_BG3_HIGH.size();
+			} else {
+				order = LAYER_ORDER_MODE_1.data();
+				orderSize = LAYER_ORDER_MODE_1.size();
+			}
+			break;
+		default:
+			order = LAYER_ORDER_OTHER_MODES.data();
+			orderSize = LAYER_ORDER_OTHER_MODES.size();
+			break;
+	}
+
+	// each layer's enable bits and window are combined once for the whole line, so the layers can be drawn with nothing but masks
+	std::array<bool, 5> shown {};
+
+	for (Byte layer = 0; layer < shown.size(); ++layer) {
+		bool enabled = false;
+		bool windowed = false;
+
+		if (layer == LAYER_OBJ) {
+			enabled = subscreen ? _enableSpriteOnSubscreen : _enableSpriteOnMainScreen;
+			windowed = subscreen ? _enableSpriteWindowsOnSubscreen : _enableSpriteWindowsOnMainScreen;
+		} else {
+			const auto& background = _backgrounds[layer];
+			enabled = subscreen ? background.enableOnSubscreen : background.enableOnMainScreen;
+			windowed = subscreen ? background.enableWindowsOnSubscreen : background.enableWindowsOnMainScreen;
+		}
+
+		if (!enabled) {
+			continue;
+		}
+
+		// the layer is hidden inside its window
+		auto visible = windowed ? ~_windowMasks[layer] : ~WindowMask();
+
+		shown[layer] = visible.any();
+		visible.expand(buffers.visible[layer].data());
+	}
+
+	std::fill(output, output + Blaze::snesWidth, backdrop);
+	std::fill(source, source + Blaze::snesWidth, LAYER_BACKDROP);
+
+	for (size_t i = 0; i < orderSize; ++i) {
+		const auto& slot = order[i];
+
+		if (!shown[slot.layer]) {
+			continue;
+		}
+
+		const auto& layer = buffers.layers[slot.layer];
+		const auto& visible = buffers.visible[slot.layer];
+		Byte priority = slot.priority + 1;
+
+		for (size_t x = 0; x < static_cast<size_t>(Blaze::snesWidth); ++x) {
+			uint32_t take = (layer.priority[x] == priority) ? visible[x] : 0;
+			output[x] = (output[x] & ~take) | (layer.color[x] & take);
+			source[x] = (take != 0) ? slot.layer : source[x];
+		}
+	}
+};
+
+Blaze::WindowMask Blaze::PPU::layerWindowMask(const WindowMask& window1, const WindowMask& window2, bool enable1, bool invert1, bool enable2, bool invert2, WindowMaskLogic logic) {
+	auto first = invert1 ? ~window1 : window1;
+	auto second = invert2 ? ~window2 : window2;
+
+	if (enable1 && enable2) {
+		return WindowMask::combine(first, second, logic);
+	} else if (enable1) {
+		return first;
+	} else if (enable2) {
+		return second;
+	}
+
+	// no windows means no pixels are inside the window
+	return WindowMask();
+};
+
+void Blaze::PPU::updateWindowMasks() {
+	auto window1 = WindowMask::range(_window1Left, _window1Right);
+	auto window2 = WindowMask::range(_window2Left, _window2Right);
+
+	for (size_t i = 0; i < _backgrounds.size(); ++i) {
+		const auto& background = _backgrounds[i];
+		_windowMasks[i] = layerWindowMask(window1, window2, background.enableWindow1, background.invertWindow1, background.enableWindow2, background.invertWindow2, background.windowMaskLogic);
+	}
+
+	_windowMasks[LAYER_OBJ] = layerWindowMask(window1, window2, _enableSpriteWindow1, _invertSpriteWindow1, _enableSpriteWindow2, _invertSpriteWindow2, _spriteWindowMaskLogic);
+	_windowMasks[LAYER_COLOR_WINDOW] = layerWindowMask(window1, window2, _enableColorWindow1, _invertColorWindow1, _enableColorWindow2, _invertColorWindow2, _colorWindowMaskLogic);
+
+	_windowMasksDirty = false;
+};
+
+Blaze::WindowMask Blaze::PPU::colorRegionMask(ColorRegion region) const {
+	const auto& colorWindow = _windowMasks[LAYER_COLOR_WINDOW];
+
+	switch (region) {
+		case ColorRegion::NoRegions:     return WindowMask();
+		case ColorRegion::OutsideWindow: return ~colorWindow;
+		case ColorRegion::InsideWindow:  return colorWindow;
+		case ColorRegion::AllRegions:    return ~WindowMask();
+	}
+	return WindowMask();
+};
+
+void Blaze::PPU::renderScanline(size_t line, ScanlineBuffers& buffers) {
+	auto* targetRow = _output->_frames[_output->_drawingFrame].data() + (line * LINE_WIDTH);
+
+	if (backgroundMode() == 7) {
+		bool extbg = mode7SecondLayerEffect() && (_backgrounds[1].enableOnMainScreen || _backgrounds[1].enableOnSubscreen);
+
+		if (!extbg) {
+			buffers.layers[1].priority.fill(0);
+		}
+		buffers.layers[2].priority.fill(0);
+		buffers.layers[3].priority.fill(0);
+
+		renderMode7Line(line, buffers.layers[0], extbg ? &buffers.layers[1] : nullptr);
+	} else {
+		for (Byte backgroundIndex = 0; backgroundIndex < _backgrounds.size(); ++backgroundIndex) {
+			auto& background = _backgrounds[backgroundIndex];
+			auto& layer = buffers.layers[backgroundIndex];
+
+			if (background.enableOnMainScreen || background.enableOnSubscreen) {
+				background.renderLine(line, _vram, _palette.data(), backgroundIndex, *this, layer);
+			} else {
+				layer.priority.fill(0);
+			}
+		}
+	}
+
+	if (_enableSpriteOnMainScreen || _enableSpriteOnSubscreen) {
+		renderSpriteLine(line, buffers.layers[LAYER_OBJ]);
+	} else {
+		buffers.layers[LAYER_OBJ].priority.fill(0);
+	}
+
+	composeScreen(buffers, false, _palette[0], buffers.main.data(), buffers.mainSource.data());
+
+	// the color window decides where the main screen is clipped to black and where color math is prevented.
+	// both are resolved for the whole line with a few mask operations, then expanded into per-pixel masks.
+	auto clipRegion = colorRegionMask(mainScreenColorBlackRegion());
+	auto mathRegion = ~colorRegionMask(subscreenColorTransparentRegion());
+
+	auto fixedColor = (*_colorTable)[(static_cast<Word>(_fixedBlue) << 10) | (static_cast<Word>(_fixedGreen) << 5) | _fixedRed];
+	bool addSubscreen = colorAddened() == ColorAddened::Subscreen;
+
+	if (addSubscreen) {
+		// the subscreen's backdrop is the fixed color
+		composeScreen(buffers, true, fixedColor, buffers.sub.data(), buffers.subSource.data());
+	} else {
+		buffers.sub.fill(fixedColor);
+	}
+
+	// whether each layer participates in color math, indexed by the layer a main screen pixel came from
+	std::array<uint32_t, 6> layerMath {};
+	for (size_t i = 0; i < _backgrounds.size(); ++i) {
+		layerMath[i] = _backgrounds[i].enableColorMath ? 0xffffffff : 0;
+	}
+	layerMath[LAYER_OBJ] = _enableSpriteColorMath ? 0xffffffff : 0;
+	layerMath[LAYER_BACKDROP] = _enableBackdropColorMath ? 0xffffffff : 0;
+
+	// `half` holds the clip mask until it's replaced by the real half mask below
+	mathRegion.expand(buffers.enable.data());
+	clipRegion.expand(buffers.half.data());
+
+	auto black = Color(0, 0, 0).toRGBA8888();
+	uint32_t halfMath = _halfColorMath ? 0xffffffff : 0;
+	uint32_t anyColorMath = 0;
+
+	for (size_t x = 0; x < static_cast<size_t>(Blaze::snesWidth); ++x) {
+		uint32_t clipped = buffers.half[x];
+		buffers.main[x] = (buffers.main[x] & ~clipped) | (black & clipped);
+
+		// only sprites using palettes 4-7 participate in color math
+		Byte source = buffers.mainSource[x];
+		uint32_t spriteMath = (source != LAYER_OBJ || buffers.layers[LAYER_OBJ].colorMath[x]) ? 0xffffffff : 0;
+		buffers.enable[x] &= layerMath[source] & spriteMath;
+
+		// the result isn't halved for clipped pixels, nor when the subscreen is transparent (and the fixed color gets used instead)
+		uint32_t opaqueSub = (addSubscreen && buffers.subSource[x] == LAYER_BACKDROP) ? 0 : 0xffffffff;
+		buffers.half[x] = halfMath & ~clipped & opaqueSub;
+
+		anyColorMath |= buffers.enable[x];
+	}
+
+	if (anyColorMath) {
+		ColorMath::apply(buffers.main.data(), buffers.sub.data(), buffers.enable.data(), buffers.half.data(), Blaze::snesWidth, _colorMathMinus);
+	}
+
+	// the screen brightness is applied to the result of color math, not to its inputs
+	if (screenBrightness() != ColorTable::MAX_BRIGHTNESS) {
+		ColorMath::applyBrightness(buffers.main.data(), Blaze::snesWidth, screenBrightness());
+	}
+
+	std::copy(buffers.main.begin(), buffers.main.end(), targetRow);
+};
+
+Blaze::PPU::PPU() {
+	_cgram.fill(0);
+	_vram.fill(0);
+	_oamData.fill(0);
+
+	for (auto& frame: _frames) {
+		frame.fill(0);
+	}
+
+	updatePalette();
+
+	for (Byte index = 0; index < SPRITE_COUNT; ++index) {
+		updateSprite(index);
+	}
+};
+
+Blaze::PPU::PPU(ForkTag):
+	_vram(),
+	_frames(),
+	// no frames yet, so there's nothing fresh to present
+	_readyFrame(2),
+	_lineBuffers()
+{};
+
+Blaze::PPU::~PPU() {
+	setAsyncRendering(false);
+};
+
+void Blaze::PPU::readTileRow(const VRAM& vram, Word vramWordAddress, Byte width, Byte row, TileFormat format, Byte* output) {
+	auto basicTileWordSize = tileFormatWordSize(format);
+	auto bitPlanes = tileFormatPixelBitPlanes(format);
+
+	switch (format) {
+		case TileFormat::Mode7:
+		case TileFormat::Mode7Direct:
+			std::fill(output, output + width, 0);
+			return;
+
+		default:
+			break;
+	}
+
+	// larger tiles are made up of 8x8 tiles laid out in rows of 16 tiles
+	for (Byte column = 0; column < width; column += 8) {
+		size_t baseWordOffset = (static_cast<size_t>(basicTileWordSize) * ((static_cast<size_t>(16) * (row / 8)) + (column / 8))) + (row % 8);
+		std::array<Byte, 8> bitPlaneBytes {};
+
+		for (Byte bitPlane = 0; bitPlane < bitPlanes; ++bitPlane) {
+			Byte bitPlaneWordIndex = bitPlane % 2;
+			size_t bitPlaneWordOffset = bitPlane / 2;
+			auto bitPlaneWord = vram[(vramWordAddress + baseWordOffset + (bitPlaneWordOffset * 8)) % vram.size()];
+			bitPlaneBytes[bitPlane] = bitPlaneWord >> (bitPlaneWordIndex * 8);
+		}
+
+		for (Byte pixel = 0; pixel < 8; ++pixel) {
+			Byte pixelMask = 1 << (7 - pixel);
+			Byte pixelValue = 0;
+
+			for (Byte bitPlane = 0; bitPlane < bitPlanes; ++bitPlane) {
+				if ((bitPlaneBytes[bitPlane] & pixelMask) != 0) {
+					pixelValue |= 1 << bitPlane;
+				}
+			}
+
+			output[column + pixel] = pixelValue;
+		}
+	}
+};
+
+Blaze::PPU::Sprite Blaze::PPU::readSprite(const Byte* oam, Byte index) {
+	Sprite result;
+	size_t offset = static_cast<size_t>(index) * 4;
+	size_t finalOffset = 512 + (index / 4);
+	Byte finalBits = (oam[finalOffset] >> ((index % 4) * 2)) & 3;
+	Byte configBits = oam[offset + 3];
+
+	result.x = static_cast<int16_t>(oam[offset]) + static_cast<int16_t>(((finalBits & (1 << 0)) != 0) ? -256 : 0);
+	result.y = oam[offset + 1];
+	result.tileIndex = oam[offset + 2];
+	result.secondTilePage = (configBits & (1 << 0)) != 0;
+	result.paletteGroup = (configBits >> 1) & 7;
+	result.priority = (configBits >> 4) & 3;
+	result.flipHorizontally = (configBits & (1 << 6)) != 0;
+	result.flipVertically = (configBits & (1 << 7)) != 0;
+	result.large = (finalBits & (1 << 1)) != 0;
+
+	return result;
+};
+
+Blaze::PPU::TilemapEntry Blaze::PPU::readTilemapEntry(const VRAM& vram, Word tilemapBaseWordAddress, Byte x, Byte y) {
+	Blaze::PPU::TilemapEntry result;
+
+	assert((tilemapBaseWordAddress & 0x3ff) == 0);
+	assert(x < 32 && y < 32);
+
+	Word index = (static_cast<Word>(y) * 32) + static_cast<Word>(x);
+	auto data = vram[(tilemapBaseWordAddress + index) % vram.size()];
+
+	result.tileIndex = data & 0x3ff;
+	result.paletteGroup = (data >> 10) & 7;
+	result.highPriority = (data & (1 << 13)) != 0;
+	result.flipHorizontally = (data & (1 << 14)) != 0;
+	result.flipVertically = (data & (1 << 15)) != 0;
+
+	return result;
+};
+
+Blaze::PPU::Background::Background() {
+	reset();
+};
+
+void Blaze::PPU::Background::renderLine(size_t line, const VRAM& vram, const uint32_t* palette, Byte backgroundIndex, PPU& ppu, LayerLine& output) {
+	output.priority.fill(0);
+
+	size_t subpaletteSize = 0;
+	size_t subpaletteCount = 0;
+	size_t paletteBase = 0;
+	TileFormat tileFormat = TileFormat::INVALID;
+	size_t dimensions = doubleCharSize ? 16 : 8;
+
+	switch (ppu.backgroundMode()) {
+		case 0: {
+			subpaletteSize = 4;
+			subpaletteCount = 8;
+			paletteBase = subpaletteCount * subpaletteSize * backgroundIndex;
+			tileFormat = TileFormat::_2bpp;
+		} break;
+
+		case 1: {
+			if (backgroundIndex == 2) {
+				// BG3 uses 2bpp
+				subpaletteSize = 4;
+				subpaletteCount = 8;
+				tileFormat = TileFormat::_2bpp;
+			}
+		} [[fallthrough]];
+		case 2: {
+			if (backgroundIndex == 0 || backgroundIndex == 1) {
+				subpaletteSize = 16;
+				subpaletteCount = 8;
+				tileFormat = TileFormat::_4bpp;
+			}
+		} break;
+
+		default:
+			// TODO
+			break;
+	}
+
+	if (tileFormat == TileFormat::INVALID) {
+		return;
+	}
+
+	assert(paletteBase + (subpaletteCount * subpaletteSize) <= 256);
+
+	// the tilemap is made up of 1-4 32x32 screens; the scroll wraps around at its edges
+	size_t mapWidth = static_cast<size_t>(tilemapHorizontalCount()) * 32 * dimensions;
+	size_t mapHeight = static_cast<size_t>(tilemapVerticalCount()) * 32 * dimensions;
+	std::array<Byte, 16> tileRow;
+
+	size_t mapY = (line + verticalScroll) % mapHeight;
+	size_t tileY = mapY / dimensions;
+	size_t fineY = mapY % dimensions;
+
+	// walk the line one tile at a time; only the tiles that are actually visible are fetched
+	size_t x = 0;
+	while (x < static_cast<size_t>(Blaze::snesWidth)) {
+		size_t mapX = (x + horizontalScroll) % mapWidth;
+		size_t tileX = mapX / dimensions;
+		size_t fineX = mapX % dimensions;
+		size_t count = std::min(dimensions - fineX, static_cast<size_t>(Blaze::snesWidth) - x);
+
+		constexpr size_t TILEMAP_WORDS = 32 * 32;
+		size_t screen = ((tileY / 32) * tilemapHorizontalCount()) + (tileX / 32);
+		auto entry = PPU::readTilemapEntry(vram, tilemapWordAddress() + (screen * TILEMAP_WORDS), tileX % 32, tileY % 32);
+		const uint32_t* subpalette = &palette[paletteBase + (entry.paletteGroup * subpaletteSize)];
+		Byte priority = entry.highPriority ? 2 : 1;
+
+		auto row = static_cast<Byte>(entry.flipVertically ? (dimensions - 1 - fineY) : fineY);
+		PPU::readTileRow(vram, chrBaseWordAddress() + (entry.tileIndex * tileFormatWordSize(tileFormat)), dimensions, row, tileFormat, tileRow.data());
+
+		for (size_t i = 0; i < count; ++i) {
+			size_t column = fineX + i;
+			if (entry.flipHorizontally) {
+				column = dimensions - 1 - column;
+			}
+
+			const auto& subpaletteIndex = tileRow[column];
+			assert(subpaletteIndex < subpaletteSize);
+
+			// color 0 is transparent
+			if (subpaletteIndex != 0) {
+				output.color[x + i] = subpalette[subpaletteIndex];
+				output.priority[x + i] = priority;
+			}
+		}
+
+		x += count;
+	}
+};
+
+void Blaze::PPU::updatePalette() {
+	for (size_t index = 0; index < _palette.size(); ++index) {
+		_palette[index] = (*_colorTable)[_cgram[index]];
+	}
+};
+
+void Blaze::PPU::updateSprite(Byte index) {
+	auto sprite = readSprite(_oamData.data(), index);
+
+	_spriteTable.x[index] = sprite.x;
+	_spriteTable.y[index] = sprite.y;
+	_spriteTable.tileIndex[index] = sprite.tileIndex;
+	_spriteTable.paletteGroup[index] = sprite.paletteGroup;
+	_spriteTable.priority[index] = sprite.priority;
+	_spriteTable.large[index] = sprite.large;
+	_spriteTable.secondTilePage[index] = sprite.secondTilePage;
+	_spriteTable.flipVertically[index] = sprite.flipVertically;
+	_spriteTable.flipHorizontally[index] = sprite.flipHorizontally;
+};
+
+void Blaze::PPU::evaluateSprites() {
+	_spriteRangeOver = false;
+	_spriteTimeOver = false;
+
+	// with priority rotation enabled, the sprite selected by OAMADD has the highest priority
+	Byte firstSprite = _oamPriorityRotation ? ((_oamByteAddress >> 2) & 0x7f) : 0;
+	auto [smallWidth, smallHeight] = spriteSizeForType(spriteSize(), false);
+	auto [largeWidth, largeHeight] = spriteSizeForType(spriteSize(), true);
+
+	for (size_t line = 0; line < static_cast<size_t>(Blaze::snesHeight); ++line) {
+		auto& spriteLine = _spriteLines[line];
+		spriteLine.count = 0;
+
+		// range: the first 32 sprites that intersect this line
+		for (size_t i = 0; i < SPRITE_COUNT; ++i) {
+			Byte index = (firstSprite + i) % SPRITE_COUNT;
+			bool large = _spriteTable.large[index];
+			int width = large ? largeWidth : smallWidth;
+			int height = large ? largeHeight : smallHeight;
+			int x = _spriteTable.x[index];
+
+			// sprites wrap around vertically
+			Byte lineInSprite = static_cast<Byte>(line - _spriteTable.y[index]);
+			if (lineInSprite >= height) {
+				continue;
+			}
+
+			// hardware quirk: sprites at X = -256 count as being in range even though they're invisible
+			if (x != -256 && (x + width <= 0 || x >= Blaze::snesWidth)) {
+				continue;
+			}
+
+			if (spriteLine.count == MAX_SPRITES_PER_LINE) {
+				_spriteRangeOver = true;
+				break;
+			}
+
+			spriteLine.sprites[spriteLine.count++] = index;
+		}
+
+		// time: the PPU fetches the visible 8x1 slivers of the sprites in range starting from the last one,
+		// and runs out of time after 34 of them. for simplicity, a sprite that doesn't fit entirely gets dropped
+		// along with all the sprites before it (which would've been fetched afterwards).
+		size_t tileCount = 0;
+		size_t firstKept = 0;
+		for (size_t i = spriteLine.count; i > 0; --i) {
+			Byte index = spriteLine.sprites[i - 1];
+			int width = _spriteTable.large[index] ? largeWidth : smallWidth;
+			int x = _spriteTable.x[index];
+			size_t visibleTiles = 0;
+
+			for (int tileX = x; tileX < x + width; tileX += 8) {
+				if (tileX > -8 && tileX < Blaze::snesWidth) {
+					++visibleTiles;
+				}
+			}
+
+			if (tileCount + visibleTiles > MAX_SPRITE_TILES_PER_LINE) {
+				_spriteTimeOver = true;
+				firstKept = i;
+				break;
+			}
+
+			tileCount += visibleTiles;
+		}
+
+		if (firstKept > 0) {
+			std::copy(spriteLine.sprites.begin() + firstKept, spriteLine.sprites.begin() + spriteLine.count, spriteLine.sprites.begin());
+			spriteLine.count -= firstKept;
+		}
+	}
+};
+
+void Blaze::PPU::renderSpriteLine(size_t line, LayerLine& output) {
+	output.priority.fill(0);
+
+	Word firstPage = nameBaseWordAddress();
+	Word secondPage = firstPage + nameSelectWordOffset();
+
+	// sprites use the second half of CGRAM
+	const uint32_t* palette = &_palette[0x80];
+	const auto& spriteLine = _spriteLines[line];
+	std::array<Byte, 64> spriteRow;
+
+	// we render from back to front (so that the sprite with the highest priority ends up on top,
+	// no matter what its own priority relative to the backgrounds is; this matches the hardware)
+	for (size_t i = spriteLine.count; i > 0; --i) {
+		Byte index = spriteLine.sprites[i - 1];
+
+		Byte paletteGroup = _spriteTable.paletteGroup[index];
+		const uint32_t* subpalette = &palette[paletteGroup * 16];
+		Byte priority = _spriteTable.priority[index] + 1;
+		auto page = _spriteTable.secondTilePage[index] ? secondPage : firstPage;
+		auto [width, height] = spriteSizeForType(spriteSize(), _spriteTable.large[index]);
+		int x = _spriteTable.x[index];
+
+		Byte row = static_cast<Byte>(line - _spriteTable.y[index]);
+		if (_spriteTable.flipVertically[index]) {
+			row = height - 1 - row;
+		}
+
+		readTileRow(_vram, page + (_spriteTable.tileIndex[index] * tileFormatWordSize(TileFormat::_4bpp)), width, row, TileFormat::_4bpp, spriteRow.data());
+
+		for (int column = 0; column < width; ++column) {
+			int targetX = x + column;
+			if (targetX < 0 || targetX >= Blaze::snesWidth) {
+				continue;
+			}
+
+			const auto& subpaletteIndex = spriteRow[_spriteTable.flipHorizontally[index] ? (width - 1 - column) : column];
+
+			// color 0 is transparent
+			if (subpaletteIndex != 0) {
+				output.color[targetX] = subpalette[subpaletteIndex];
+				output.priority[targetX] = priority;
+				output.colorMath[targetX] = paletteGroup >= 4;
+			}
+		}
+	}
+};
+
+// sign-extends one of the 13-bit mode 7 registers (the center and scroll registers)
+static inline int32_t signExtend13(Blaze::Word value) {
+	return static_cast<int32_t>(static_cast<int16_t>(value << 3)) >> 3;
+};
+
+void Blaze::PPU::renderMode7Line(size_t line, LayerLine& background1, LayerLine* background2) {
+	background1.priority.fill(0);
+	if (background2 != nullptr) {
+		background2->priority.fill(0);
+	}
+
+	int32_t a = static_cast<int16_t>(_mode7A);
+	int32_t b = static_cast<int16_t>(_mode7B);
+	int32_t c = static_cast<int16_t>(_mode7C);
+	int32_t d = static_cast<int16_t>(_mode7D);
+	int32_t centerX = signExtend13(_mode7CenterX);
+	int32_t centerY = signExtend13(_mode7CenterY);
+
+	// the scroll offsets relative to the center are clipped to 10 bits (keeping their sign)
+	auto clip = [](int32_t value) {
+		return ((value & 0x2000) != 0) ? (value | ~0x3ff) : (value & 0x3ff);
+	};
+
+	int32_t offsetX = clip(signExtend13(_mode7HorizontalScroll) - centerX);
+	int32_t offsetY = clip(signExtend13(_mode7VerticalScroll) - centerY);
+	int32_t screenY = mode7FlipVertically() ? (255 - static_cast<int32_t>(line)) : static_cast<int32_t>(line);
+
+	// the affine transform is only computed once per line (like the hardware does, with the same truncation);
+	// after that, every pixel is just one step of A and C further along (in 8.8 fixed point)
+	int32_t startX = ((a * offsetX) & ~63) + ((b * offsetY) & ~63) + ((b * screenY) & ~63) + (centerX * 256);
+	int32_t startY = ((c * offsetX) & ~63) + ((d * offsetY) & ~63) + ((d * screenY) & ~63) + (centerY * 256);
+	int32_t stepX = a;
+	int32_t stepY = c;
+
+	if (mode7FlipHorizontally()) {
+		startX += a * 255;
+		startY += c * 255;
+		stepX = -a;
+		stepY = -c;
+	}
+
+	Byte screenOver = mode7ScreenOver();
+	bool directColor = enableDirectColor();
+
+	// pixels are processed in blocks of 8: first the coordinates and addresses for the whole block are computed
+	// (branch-free, so the compiler can vectorize it), then the tile numbers and pixels are gathered from VRAM.
+	// the gathers themselves are scalar since VRAM is paged.
+	constexpr size_t BLOCK_SIZE = 8;
+
+	for (size_t blockStart = 0; blockStart < LINE_WIDTH; blockStart += BLOCK_SIZE) {
+		std::array<int32_t, BLOCK_SIZE> pixelX;
+		std::array<int32_t, BLOCK_SIZE> pixelY;
+		std::array<bool, BLOCK_SIZE> outside;
+		std::array<Word, BLOCK_SIZE> tilemapAddress;
+		std::array<Byte, BLOCK_SIZE> pixels;
+
+		for (size_t lane = 0; lane < BLOCK_SIZE; ++lane) {
+			int32_t x = static_cast<int32_t>(blockStart + lane);
+			pixelX[lane] = (startX + (stepX * x)) >> 8;
+			pixelY[lane] = (startY + (stepY * x)) >> 8;
+			outside[lane] = ((pixelX[lane] | pixelY[lane]) & ~0x3ff) != 0;
+			pixelX[lane] &= 0x3ff;
+			pixelY[lane] &= 0x3ff;
+
+			// the tilemap is 128x128 tiles (in the low bytes of the first 16K words)
+			tilemapAddress[lane] = static_cast<Word>(((pixelY[lane] >> 3) << 7) | (pixelX[lane] >> 3));
+		}
+
+		for (size_t lane = 0; lane < BLOCK_SIZE; ++lane) {
+			Byte tile = 0;
+
+			if (outside[lane]) {
+				if (screenOver == 2) {
+					pixels[lane] = 0;
+					continue;
+				} else if (screenOver != 3) {
+					tile = lo8(_vram[tilemapAddress[lane]]);
+				}
+			} else {
+				tile = lo8(_vram[tilemapAddress[lane]]);
+			}
+
+			// each tile is 8x8 pixels of 8 bits each (in the high bytes)
+			Word pixelAddress = (static_cast<Word>(tile) << 6) | ((pixelY[lane] & 7) << 3) | (pixelX[lane] & 7);
+			pixels[lane] = hi8(_vram[pixelAddress], true);
+		}
+
+		for (size_t lane = 0; lane < BLOCK_SIZE; ++lane) {
+			size_t x = blockStart + lane;
+			Byte pixel = pixels[lane];
+
+			if (pixel != 0) {
+				if (directColor) {
+					// BBGGGRRR
+					Word bgr555 = ((pixel & 7) << 2) | (((pixel >> 3) & 7) << 7) | (((pixel >> 6) & 3) << 13);
+					background1.color[x] = (*_colorTable)[bgr555];
+				} else {
+					background1.color[x] = _palette[pixel];
+				}
+				background1.priority[x] = 1;
+			}
+
+			// EXTBG: BG2 uses the same pixels, but with the top bit as the priority
+			if (background2 != nullptr && (pixel & 0x7f) != 0) {
+				background2->color[x] = _palette[pixel & 0x7f];
+				background2->priority[x] = (pixel >> 7) + 1;
+			}
+		}
+	}
+};
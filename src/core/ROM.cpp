@@ -37,24 +37,26 @@ Blaze::ROM::Type Blaze::ROM::type() const {
 };
 
 size_t Blaze::ROM::byteSize() const {
-	if (_memory.empty()) {
+	if (!_memory) {
 		return 0;
 	}
 
-	return (static_cast<size_t>(1) << _memory[headerOffset() + HeaderFieldOffset::Size]) * 1024;
+	return (static_cast<size_t>(1) << (*_memory)[headerOffset() + HeaderFieldOffset::Size]) * 1024;
 };
 
 size_t Blaze::ROM::sramByteSize() const {
-	if (_memory.empty()) {
+	if (!_memory) {
 		return 0;
 	}
 
-	switch (static_cast<CartridgeType>(_memory[headerOffset() + HeaderFieldOffset::CartridgeType])) {
+	const auto& memory = *_memory;
+
+	switch (static_cast<CartridgeType>(memory[headerOffset() + HeaderFieldOffset::CartridgeType])) {
 		case CartridgeType::ROM_RAM:
 		case CartridgeType::ROM_RAM_Battery:
 		case CartridgeType::ROM_SA1_RAM:
 		case CartridgeType::ROM_SA1_RAM_Battery:
-			return (static_cast<size_t>(1) << _memory[headerOffset() + HeaderFieldOffset::RAMSize]) * 1024;
+			return (static_cast<size_t>(1) << memory[headerOffset() + HeaderFieldOffset::RAMSize]) * 1024;
 
 		default:
 			return 0;
@@ -62,20 +64,22 @@ size_t Blaze::ROM::sramByteSize() const {
 };
 
 std::string Blaze::ROM::name() const {
-	if (_memory.empty()) {
+	if (!_memory) {
 		return {};
 	}
 
 	std::string result;
 	result.resize(TITLE_SIZE, ' ');
 
-	memcpy(result.data(), &_memory[headerOffset() + HeaderFieldOffset::GameTitle], TITLE_SIZE);
+	memcpy(result.data(), &(*_memory)[headerOffset() + HeaderFieldOffset::GameTitle], TITLE_SIZE);
 
 	return result;
 };
 
 void Blaze::ROM::load(const std::string& path) {
-	_memory.clear();
+	std::vector<Byte> memory;
+
+	_memory.reset();
 
 	// open the file in binary mode and open it at the end (ATE) of the file to get the size
 	std::ifstream file(path, std::ios::binary | std::ios::ate);
@@ -84,36 +88,58 @@ void Blaze::ROM::load(const std::string& path) {
 	// move the file back to the beginning
 	file.seekg(0, std::ios::beg);
 
-	_memory.resize(size);
+	memory.resize(size);
 
-	if (!file.read(reinterpret_cast<char*>(_memory.data()), size)) {
+	if (!file.read(reinterpret_cast<char*>(memory.data()), size)) {
 		throw std::runtime_error("failed to read ROM");
 	}
 
 	// determine the ROM type
 
-	if (_memory.size() < MIN_ROM_SIZE) {
+	if (memory.size() < MIN_ROM_SIZE) {
 		// this is an invalid ROM
 		throw std::runtime_error("ROM TOO SMALL: " + std::to_string(size));
-		_memory.clear();
-		_type = Type::INVALID;
-		return;
 	}
 
 	// try to see if the LoROM header is valid
-	if (_memory[LOROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE || _memory[LOROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE_ALTERNATIVE) {
+	if (memory[LOROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE || memory[LOROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE_ALTERNATIVE) {
 		_type = Type::LoROM;
 	}
 	// try to see if the HiROM header is valid
-	else if (_memory[HIROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE || _memory[LOROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE_ALTERNATIVE) {
+	else if (memory[HIROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE || memory[LOROM_FIXED_VALUE_OFFSET] == ROM_FIXED_VALUE_ALTERNATIVE) {
 		_type = Type::HiROM;
 	} else {
 		// invalid ROM
-		_memory.clear();
 		_type = Type::INVALID;
 	}
 
+	if (_type != Type::INVALID) {
+		_memory = std::make_shared<const std::vector<Byte>>(std::move(memory));
+	}
+
 	_bus->sram.setSize(sramByteSize());
+
+	// the memory map depends on the ROM type
+	_bus->updatePageTable();
+};
+
+void Blaze::ROM::shareFrom(const ROM& other) {
+	_memory = other._memory;
+	_type = other._type;
+};
+
+const Blaze::Byte* Blaze::ROM::data(Address offset, size_t byteCount) const {
+	if (!_memory) {
+		return nullptr;
+	}
+
+	offset %= byteSize();
+
+	if (offset + byteCount > _memory->size()) {
+		return nullptr;
+	}
+
+	return _memory->data() + offset;
 };
 
 Blaze::Byte Blaze::ROM::registerSize(Address offset, Byte attemptedAccessSize) {
@@ -121,7 +147,7 @@ Blaze::Byte Blaze::ROM::registerSize(Address offset, Byte attemptedAccessSize) {
 };
 
 Blaze::Address Blaze::ROM::read(Address offset, Byte bitSize) {
-	if (_memory.empty()) {
+	if (!_memory) {
 		// no ROM loaded
 		return 0;
 	}
@@ -130,7 +156,7 @@ Blaze::Address Blaze::ROM::read(Address offset, Byte bitSize) {
 
 	offset %= byteSize();
 
-	return _memory[offset];
+	return (*_memory)[offset];
 };
 
 void Blaze::ROM::write(Address offset, Byte bitSize, Address value) {
@@ -140,7 +166,11 @@ void Blaze::ROM::write(Address offset, Byte bitSize, Address value) {
 };
 
 void Blaze::ROM::reset(Bus* bus) {
-	_memory.clear();
+	_memory.reset();
 	_type = Type::INVALID;
 	_bus = bus;
+
+	if (_bus != nullptr) {
+		_bus->updatePageTable();
+	}
 };
@@ -1,14 +1,14 @@
 #include <blaze/CPU.hpp>
 
-bool Blaze::CPU::Register::using8BitMode() const {
+bool Blaze::CPUBase::Register::using8BitMode() const {
 	return (_flags & _mask) != 0;
 };
 
-void Blaze::CPU::Register::reset() {
+void Blaze::CPUBase::Register::reset() {
 	_value = 0;
 };
 
-Blaze::Word Blaze::CPU::Register::load() const {
+Blaze::Word Blaze::CPUBase::Register::load() const {
 	if (using8BitMode()) {
 		return _value & 0xff;
 	} else {
@@ -16,7 +16,7 @@ Blaze::Word Blaze::CPU::Register::load() const {
 	}
 };
 
-void Blaze::CPU::Register::store(Word value) {
+void Blaze::CPUBase::Register::store(Word value) {
 	if (using8BitMode()) {
 		if (_mask == flags::m) {
 			// the accumulator preserves the high byte
@@ -30,15 +30,15 @@ void Blaze::CPU::Register::store(Word value) {
 	}
 };
 
-Blaze::Word Blaze::CPU::Register::forceLoadFull() const {
+Blaze::Word Blaze::CPUBase::Register::forceLoadFull() const {
 	return _value;
 };
 
-void Blaze::CPU::Register::forceStoreFull(Word value) {
+void Blaze::CPUBase::Register::forceStoreFull(Word value) {
 	_value = value;
 };
 
-bool Blaze::CPU::Register::mostSignificantBit() const {
+bool Blaze::CPUBase::Register::mostSignificantBit() const {
 	if (using8BitMode()) {
 		return (_value & (1u << 7)) != 0;
 	} else {
@@ -46,106 +46,106 @@ bool Blaze::CPU::Register::mostSignificantBit() const {
 	}
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator+=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator+=(Word rhs) {
 	store(load() + rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator-=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator-=(Word rhs) {
 	store(load() - rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator*=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator*=(Word rhs) {
 	store(load() * rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator/=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator/=(Word rhs) {
 	store(load() / rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator&=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator&=(Word rhs) {
 	store(load() & rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator|=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator|=(Word rhs) {
 	store(load() | rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator^=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator^=(Word rhs) {
 	store(load() ^ rhs);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator++() {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator++() {
 	store(load() + 1);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator++(int) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator++(int) {
 	store(load() + 1);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator--() {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator--() {
 	store(load() - 1);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator--(int) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator--(int) {
 	store(load() - 1);
 	return *this;
 };
 
-Blaze::CPU::Register& Blaze::CPU::Register::operator=(Word rhs) {
+Blaze::CPUBase::Register& Blaze::CPUBase::Register::operator=(Word rhs) {
 	store(rhs);
 	return *this;
 };
 
-bool Blaze::CPU::Register::operator==(Word rhs) const {
+bool Blaze::CPUBase::Register::operator==(Word rhs) const {
 	return load() == rhs;
 };
 
-bool Blaze::CPU::Register::operator!=(Word rhs) const {
+bool Blaze::CPUBase::Register::operator!=(Word rhs) const {
 	return load() != rhs;
 };
 
-bool Blaze::CPU::Register::operator>=(Word rhs) const {
+bool Blaze::CPUBase::Register::operator>=(Word rhs) const {
 	return load() >= rhs;
 };
 
-bool Blaze::CPU::Register::operator<=(Word rhs) const {
+bool Blaze::CPUBase::Register::operator<=(Word rhs) const {
 	return load() <= rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator+(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator+(Word rhs) const {
 	return load() + rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator-(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator-(Word rhs) const {
 	return load() - rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator*(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator*(Word rhs) const {
 	return load() * rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator/(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator/(Word rhs) const {
 	return load() / rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator&(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator&(Word rhs) const {
 	return load() & rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator|(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator|(Word rhs) const {
 	return load() | rhs;
 };
 
-Blaze::Word Blaze::CPU::Register::operator^(Word rhs) const {
+Blaze::Word Blaze::CPUBase::Register::operator^(Word rhs) const {
 	return load() ^ rhs;
 };
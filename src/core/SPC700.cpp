@@ -0,0 +1,780 @@
+#include <blaze/SPC700.hpp>
+#include <blaze/util.hpp>
+
+#include <algorithm>
+
+namespace Blaze {
+	static constexpr std::array<Byte, SPC700::IPL_ROM_SIZE> IPL_ROM = {
+		0xcd, 0xef, 0xbd, 0xe8, 0x00, 0xc6, 0x1d, 0xd0, 0xfc, 0x8f, 0xaa, 0xf4, 0x8f, 0xbb, 0xf5, 0x78,
+		0xcc, 0xf4, 0xd0, 0xfb, 0x2f, 0x19, 0xeb, 0xf4, 0xd0, 0xfc, 0x7e, 0xf4, 0xd0, 0x0b, 0xe4, 0xf5,
+		0xcb, 0xf4, 0xd7, 0x00, 0xfc, 0xd0, 0xf3, 0xab, 0x01, 0x10, 0xef, 0x7e, 0xf4, 0x10, 0xeb, 0xba,
+		0xf6, 0xda, 0x00, 0xba, 0xf4, 0xc4, 0xf4, 0xdd, 0x5d, 0xd0, 0xdb, 0x1f, 0x00, 0x00, 0xc0, 0xff,
+	};
+
+	// the base number of cycles each opcode takes; branches add 2 more cycles when they're taken
+	static constexpr std::array<Byte, 256> CYCLE_COUNTS = {
+		2, 8, 4, 5, 3, 4, 3, 6, 2, 6, 5, 4, 5, 4, 6, 8,
+		2, 8, 4, 5, 4, 5, 5, 6, 5, 5, 6, 5, 2, 2, 4, 6,
+		2, 8, 4, 5, 3, 4, 3, 6, 2, 6, 5, 4, 5, 4, 5, 4,
+		2, 8, 4, 5, 4, 5, 5, 6, 5, 5, 6, 5, 2, 2, 3, 8,
+		2, 8, 4, 5, 3, 4, 3, 6, 2, 6, 4, 4, 5, 4, 6, 6,
+		2, 8, 4, 5, 4, 5, 5, 6, 5, 5, 4, 5, 2, 2, 4, 3,
+		2, 8, 4, 5, 3, 4, 3, 6, 2, 6, 4, 4, 5, 4, 5, 5,
+		2, 8, 4, 5, 4, 5, 5, 6, 5, 5, 5, 5, 2, 2, 3, 6,
+		2, 8, 4, 5, 3, 4, 3, 6, 2, 6, 5, 4, 5, 2, 4, 5,
+		2, 8, 4, 5, 4, 5, 5, 6, 5, 5, 5, 5, 2, 2, 12, 5,
+		3, 8, 4, 5, 3, 4, 3, 6, 2, 6, 4, 4, 5, 2, 4, 4,
+		2, 8, 4, 5, 4, 5, 5, 6, 5, 5, 5, 5, 2, 2, 3, 4,
+		3, 8, 4, 5, 4, 5, 4, 7, 2, 5, 6, 4, 5, 2, 4, 9,
+		2, 8, 4, 5, 5, 6, 6, 7, 4, 5, 5, 5, 2, 2, 6, 3,
+		2, 8, 4, 5, 3, 4, 3, 6, 2, 4, 5, 3, 4, 3, 4, 3,
+		2, 8, 4, 5, 4, 5, 5, 6, 3, 4, 5, 4, 2, 2, 4, 3,
+	};
+
+	// the timers are clocked at 64 kHz (timer 2) and 8 kHz (timers 0 and 1)
+	static constexpr unsigned FAST_TIMER_PERIOD = 16;
+	static constexpr Byte SLOW_TIMER_DIVIDER = 8;
+
+	struct SPC700Registers {
+		enum IgnoreMe: Word {
+			TEST    = 0xf0,
+			CONTROL = 0xf1,
+			DSPADDR = 0xf2,
+			DSPDATA = 0xf3,
+			CPUIO0  = 0xf4,
+			CPUIO3  = 0xf7,
+			T0TARGET = 0xfa,
+			T2TARGET = 0xfc,
+			T0OUT    = 0xfd,
+			T2OUT    = 0xff,
+		};
+	};
+
+	// the operations of the OR/AND/EOR/CMP/ADC/SBC instruction group, in opcode order
+	struct ALUOperation {
+		enum IgnoreMe: Byte {
+			OR,
+			AND,
+			EOR,
+			CMP,
+			ADC,
+			SBC,
+		};
+	};
+
+	// the operations of the ASL/ROL/LSR/ROR/DEC/INC instruction group, in opcode order
+	struct ShiftOperation {
+		enum IgnoreMe: Byte {
+			ASL,
+			ROL,
+			LSR,
+			ROR,
+			DEC,
+			INC,
+		};
+	};
+} // namespace Blaze
+
+Blaze::SPC700::SPC700() {
+	reset();
+};
+
+void Blaze::SPC700::reset() {
+	control = 0x80;
+	dspAddress = 0;
+	dsp.reset();
+	_dspPhase = 0;
+	std::fill(portsFromCPU.begin(), portsFromCPU.end(), 0);
+	std::fill(portsToCPU.begin(), portsToCPU.end(), 0);
+	std::fill(timers.begin(), timers.end(), Timer());
+	_timerPhase = 0;
+	_timerDivider = 0;
+
+	A = 0;
+	X = 0;
+	Y = 0;
+	SP = 0xef;
+	PSW = 0;
+	PC = read16(0xfffe);
+
+	stopped = false;
+	cycles = 0;
+};
+
+void Blaze::SPC700::tickTimer(Timer& timer) {
+	if (!timer.enabled) {
+		return;
+	}
+
+	// a target of 0 wraps around after 256 ticks, which is exactly what the 8-bit stage counter does by itself
+	if (++timer.stage == timer.target) {
+		timer.stage = 0;
+		timer.counter = (timer.counter + 1) & 0x0f;
+	}
+};
+
+void Blaze::SPC700::advanceTimers(unsigned elapsedCycles) {
+	_timerPhase += elapsedCycles;
+
+	while (_timerPhase >= FAST_TIMER_PERIOD) {
+		_timerPhase -= FAST_TIMER_PERIOD;
+
+		tickTimer(timers[2]);
+
+		if (++_timerDivider == SLOW_TIMER_DIVIDER) {
+			_timerDivider = 0;
+			tickTimer(timers[0]);
+			tickTimer(timers[1]);
+		}
+	}
+};
+
+void Blaze::SPC700::advanceClock(unsigned elapsedCycles) {
+	cycles += elapsedCycles;
+	advanceTimers(elapsedCycles);
+
+	_dspPhase += elapsedCycles;
+	while (_dspPhase >= DSP::CYCLES_PER_SAMPLE) {
+		_dspPhase -= DSP::CYCLES_PER_SAMPLE;
+		dsp.generateSample(aram);
+	}
+};
+
+Blaze::Byte Blaze::SPC700::read(Word address) {
+	if (address >= SPC700Registers::TEST && address <= SPC700Registers::T2OUT) {
+		switch (address) {
+			case SPC700Registers::DSPADDR:
+				return dspAddress;
+
+			case SPC700Registers::DSPDATA:
+				// $80-$FF mirror $00-$7F on reads
+				return dsp.readRegister(dspAddress & 0x7f);
+
+			case SPC700Registers::CPUIO0 + 0:
+			case SPC700Registers::CPUIO0 + 1:
+			case SPC700Registers::CPUIO0 + 2:
+			case SPC700Registers::CPUIO0 + 3:
+				return portsFromCPU[address - SPC700Registers::CPUIO0];
+
+			case SPC700Registers::T0OUT + 0:
+			case SPC700Registers::T0OUT + 1:
+			case SPC700Registers::T0OUT + 2: {
+				auto& timer = timers[address - SPC700Registers::T0OUT];
+				Byte value = timer.counter;
+				timer.counter = 0;
+				return value;
+			}
+
+			case SPC700Registers::TEST:
+			case SPC700Registers::CONTROL:
+			case SPC700Registers::T0TARGET + 0:
+			case SPC700Registers::T0TARGET + 1:
+			case SPC700Registers::T0TARGET + 2:
+				// write-only
+				return 0;
+
+			default:
+				// $F8 and $F9 are plain RAM
+				break;
+		}
+	}
+
+	if (address >= IPL_ROM_ADDRESS && iplRomEnabled()) {
+		return IPL_ROM[address - IPL_ROM_ADDRESS];
+	}
+
+	return aram[address];
+};
+
+void Blaze::SPC700::write(Word address, Byte value) {
+	if (address >= SPC700Registers::TEST && address <= SPC700Registers::T2OUT) {
+		switch (address) {
+			case SPC700Registers::CONTROL:
+				for (size_t i = 0; i < timers.size(); ++i) {
+					bool enable = (value & (1 << i)) != 0;
+
+					// enabling a timer restarts it
+					if (enable && !timers[i].enabled) {
+						timers[i].stage = 0;
+						timers[i].counter = 0;
+					}
+
+					timers[i].enabled = enable;
+				}
+
+				if ((value & (1 << 4)) != 0) {
+					portsFromCPU[0] = 0;
+					portsFromCPU[1] = 0;
+				}
+
+				if ((value & (1 << 5)) != 0) {
+					portsFromCPU[2] = 0;
+					portsFromCPU[3] = 0;
+				}
+
+				control = value;
+				break;
+
+			case SPC700Registers::DSPADDR:
+				dspAddress = value;
+				break;
+
+			case SPC700Registers::DSPDATA:
+				// $80-$FF are read-only
+				if (dspAddress < DSP::REGISTER_COUNT) {
+					dsp.writeRegister(dspAddress, value);
+				}
+				break;
+
+			case SPC700Registers::CPUIO0 + 0:
+			case SPC700Registers::CPUIO0 + 1:
+			case SPC700Registers::CPUIO0 + 2:
+			case SPC700Registers::CPUIO0 + 3:
+				portsToCPU[address - SPC700Registers::CPUIO0] = value;
+				break;
+
+			case SPC700Registers::T0TARGET + 0:
+			case SPC700Registers::T0TARGET + 1:
+			case SPC700Registers::T0TARGET + 2:
+				timers[address - SPC700Registers::T0TARGET].target = value;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	// writes always go through to RAM (even when they hit the I/O registers or the IPL ROM)
+	aram[address] = value;
+	dsp.aramWritten(address);
+};
+
+Blaze::Word Blaze::SPC700::read16(Word address) {
+	Byte lo = read(address);
+	Byte hi = read(address + 1);
+	return concat16(hi, lo);
+};
+
+Blaze::Word Blaze::SPC700::readDirect16(Byte offset) {
+	Byte lo = readDirect(offset);
+	Byte hi = readDirect(offset + 1);
+	return concat16(hi, lo);
+};
+
+void Blaze::SPC700::writeDirect16(Byte offset, Word value) {
+	writeDirect(offset, value & 0xff);
+	writeDirect(offset + 1, value >> 8);
+};
+
+Blaze::Byte Blaze::SPC700::fetch() {
+	return read(PC++);
+};
+
+Blaze::Word Blaze::SPC700::fetch16() {
+	Byte lo = fetch();
+	Byte hi = fetch();
+	return concat16(hi, lo);
+};
+
+void Blaze::SPC700::push(Byte value) {
+	write(0x100 | SP, value);
+	--SP;
+};
+
+Blaze::Byte Blaze::SPC700::pop() {
+	++SP;
+	return read(0x100 | SP);
+};
+
+void Blaze::SPC700::push16(Word value) {
+	push(value >> 8);
+	push(value & 0xff);
+};
+
+Blaze::Word Blaze::SPC700::pop16() {
+	Byte lo = pop();
+	Byte hi = pop();
+	return concat16(hi, lo);
+};
+
+Blaze::Word Blaze::SPC700::aluOperandAddress(Byte opcode) {
+	bool oddRow = ((opcode >> 4) & 1) != 0;
+
+	switch (opcode & 0x0f) {
+		case 0x4: return oddRow ? directPage(fetch() + X) : directPage(fetch());
+		case 0x5: return oddRow ? fetch16() + X : fetch16();
+		case 0x6: return oddRow ? fetch16() + Y : directPage(X);
+		case 0x7: return oddRow ? readDirect16(fetch()) + Y : readDirect16(fetch() + X);
+		default:  return 0;
+	}
+};
+
+Blaze::Byte Blaze::SPC700::adc(Byte lhs, Byte rhs) {
+	unsigned result = lhs + rhs + (getFlag(flags::c) ? 1 : 0);
+	setFlag(flags::v, (~(lhs ^ rhs) & (lhs ^ result) & 0x80) != 0);
+	setFlag(flags::h, ((lhs ^ rhs ^ result) & 0x10) != 0);
+	setFlag(flags::c, result > 0xff);
+	return setNZ(result & 0xff);
+};
+
+Blaze::Byte Blaze::SPC700::sbc(Byte lhs, Byte rhs) {
+	return adc(lhs, ~rhs);
+};
+
+void Blaze::SPC700::compare(Byte lhs, Byte rhs) {
+	int result = lhs - rhs;
+	setFlag(flags::c, result >= 0);
+	setNZ(result & 0xff);
+};
+
+Blaze::Byte Blaze::SPC700::alu(Byte operation, Byte lhs, Byte rhs) {
+	switch (operation) {
+		case ALUOperation::OR:  return setNZ(lhs | rhs);
+		case ALUOperation::AND: return setNZ(lhs & rhs);
+		case ALUOperation::EOR: return setNZ(lhs ^ rhs);
+		case ALUOperation::ADC: return adc(lhs, rhs);
+		case ALUOperation::SBC: return sbc(lhs, rhs);
+
+		case ALUOperation::CMP:
+		default:
+			compare(lhs, rhs);
+			return lhs;
+	}
+};
+
+Blaze::Byte Blaze::SPC700::shift(Byte operation, Byte value) {
+	Byte carry = getFlag(flags::c) ? 1 : 0;
+
+	switch (operation) {
+		case ShiftOperation::ASL:
+			setFlag(flags::c, (value & 0x80) != 0);
+			return setNZ(value << 1);
+
+		case ShiftOperation::ROL:
+			setFlag(flags::c, (value & 0x80) != 0);
+			return setNZ((value << 1) | carry);
+
+		case ShiftOperation::LSR:
+			setFlag(flags::c, (value & 0x01) != 0);
+			return setNZ(value >> 1);
+
+		case ShiftOperation::ROR:
+			setFlag(flags::c, (value & 0x01) != 0);
+			return setNZ((value >> 1) | (carry << 7));
+
+		case ShiftOperation::DEC:
+			return setNZ(value - 1);
+
+		case ShiftOperation::INC:
+		default:
+			return setNZ(value + 1);
+	}
+};
+
+void Blaze::SPC700::fetchMemoryBit(Word& address, Byte& bit) {
+	Word operand = fetch16();
+	address = operand & 0x1fff;
+	bit = operand >> 13;
+};
+
+unsigned Blaze::SPC700::branch(bool condition) {
+	auto offset = static_cast<int8_t>(fetch());
+
+	if (!condition) {
+		return 0;
+	}
+
+	PC += offset;
+	return 2;
+};
+
+void Blaze::SPC700::runUntil(uint64_t cycle) {
+	while (cycles < cycle) {
+		step();
+	}
+};
+
+unsigned Blaze::SPC700::step() {
+	if (stopped) {
+		// the clock keeps running (and so do the timers and the DSP), but nothing else happens
+		advanceClock(2);
+		return 2;
+	}
+
+	Byte opcode = fetch();
+	Byte row = opcode >> 4;
+	Byte column = opcode & 0x0f;
+	unsigned elapsed = CYCLE_COUNTS[opcode];
+
+	if (row <= 0xb && column >= 0x4 && column <= 0x9) {
+		// OR/AND/EOR/CMP/ADC/SBC
+		Byte operation = row >> 1;
+
+		if (column == 0x9 || (column == 0x8 && (row & 1) != 0)) {
+			// memory-to-memory (`dd,ds`, `d,#i`, and `(X),(Y)`)
+			Byte source;
+			Word destination;
+
+			if (column == 0x8) {
+				source = fetch();
+				destination = directPage(fetch());
+			} else if ((row & 1) == 0) {
+				source = readDirect(fetch());
+				destination = directPage(fetch());
+			} else {
+				source = readDirect(Y);
+				destination = directPage(X);
+			}
+
+			Byte result = alu(operation, read(destination), source);
+
+			if (operation != ALUOperation::CMP) {
+				write(destination, result);
+			}
+		} else {
+			Byte operand = (column == 0x8) ? fetch() : read(aluOperandAddress(opcode));
+			A = alu(operation, A, operand);
+		}
+	} else if (row <= 0xb && (column == 0xb || column == 0xc)) {
+		// ASL/ROL/LSR/ROR/DEC/INC
+		Byte operation = row >> 1;
+
+		if (column == 0xc && (row & 1) != 0) {
+			A = shift(operation, A);
+		} else {
+			Word address;
+
+			if (column == 0xc) {
+				address = fetch16();
+			} else if ((row & 1) == 0) {
+				address = directPage(fetch());
+			} else {
+				address = directPage(fetch() + X);
+			}
+
+			write(address, shift(operation, read(address)));
+		}
+	} else if (column == 0x1) {
+		// TCALL n
+		push16(PC);
+		PC = read16(0xffde - (row * 2));
+	} else if (column == 0x2) {
+		// SET1/CLR1 d.b
+		Byte offset = fetch();
+		Byte mask = 1 << (row >> 1);
+		Byte value = readDirect(offset);
+		writeDirect(offset, (row & 1) == 0 ? (value | mask) : (value & ~mask));
+	} else if (column == 0x3) {
+		// BBS/BBC d.b,r
+		Byte mask = 1 << (row >> 1);
+		bool set = (readDirect(fetch()) & mask) != 0;
+		elapsed += branch((row & 1) == 0 ? set : !set);
+	} else {
+		switch (opcode) {
+			// flags
+			case 0x00: break; // NOP
+			case 0x20: setFlag(flags::p, false); break; // CLRP
+			case 0x40: setFlag(flags::p, true); break; // SETP
+			case 0x60: setFlag(flags::c, false); break; // CLRC
+			case 0x80: setFlag(flags::c, true); break; // SETC
+			case 0xa0: setFlag(flags::i, true); break; // EI
+			case 0xc0: setFlag(flags::i, false); break; // DI
+			case 0xe0: setFlag(flags::v, false); setFlag(flags::h, false); break; // CLRV
+			case 0xed: setFlag(flags::c, !getFlag(flags::c)); break; // NOTC
+
+			// branches
+			case 0x10: elapsed += branch(!getFlag(flags::n)); break; // BPL
+			case 0x30: elapsed += branch(getFlag(flags::n)); break; // BMI
+			case 0x50: elapsed += branch(!getFlag(flags::v)); break; // BVC
+			case 0x70: elapsed += branch(getFlag(flags::v)); break; // BVS
+			case 0x90: elapsed += branch(!getFlag(flags::c)); break; // BCC
+			case 0xb0: elapsed += branch(getFlag(flags::c)); break; // BCS
+			case 0xd0: elapsed += branch(!getFlag(flags::z)); break; // BNE
+			case 0xf0: elapsed += branch(getFlag(flags::z)); break; // BEQ
+			case 0x2f: branch(true); break; // BRA (its cycle count already includes the branch)
+
+			case 0x2e: { // CBNE d,r
+				Byte value = readDirect(fetch());
+				elapsed += branch(A != value);
+				break;
+			}
+			case 0xde: { // CBNE d+X,r
+				Byte value = readDirect(fetch() + X);
+				elapsed += branch(A != value);
+				break;
+			}
+			case 0x6e: { // DBNZ d,r
+				Byte offset = fetch();
+				Byte value = readDirect(offset) - 1;
+				writeDirect(offset, value);
+				elapsed += branch(value != 0);
+				break;
+			}
+			case 0xfe: // DBNZ Y,r
+				--Y;
+				elapsed += branch(Y != 0);
+				break;
+
+			// jumps and calls
+			case 0x5f: PC = fetch16(); break; // JMP !a
+			case 0x1f: PC = read16(fetch16() + X); break; // JMP [!a+X]
+			case 0x3f: { // CALL !a
+				Word address = fetch16();
+				push16(PC);
+				PC = address;
+				break;
+			}
+			case 0x4f: { // PCALL u
+				Byte offset = fetch();
+				push16(PC);
+				PC = 0xff00 | offset;
+				break;
+			}
+			case 0x6f: PC = pop16(); break; // RET
+			case 0x7f: // RETI
+				PSW = pop();
+				PC = pop16();
+				break;
+			case 0x0f: // BRK
+				push16(PC);
+				push(PSW);
+				setFlag(flags::b, true);
+				setFlag(flags::i, false);
+				PC = read16(0xffde);
+				break;
+
+			// stack
+			case 0x0d: push(PSW); break; // PUSH PSW
+			case 0x2d: push(A); break; // PUSH A
+			case 0x4d: push(X); break; // PUSH X
+			case 0x6d: push(Y); break; // PUSH Y
+			case 0x8e: PSW = pop(); break; // POP PSW
+			case 0xae: A = pop(); break; // POP A
+			case 0xce: X = pop(); break; // POP X
+			case 0xee: Y = pop(); break; // POP Y
+
+			// comparisons with X and Y
+			case 0xc8: compare(X, fetch()); break; // CMP X,#i
+			case 0x3e: compare(X, readDirect(fetch())); break; // CMP X,d
+			case 0x1e: compare(X, read(fetch16())); break; // CMP X,!a
+			case 0xad: compare(Y, fetch()); break; // CMP Y,#i
+			case 0x7e: compare(Y, readDirect(fetch())); break; // CMP Y,d
+			case 0x5e: compare(Y, read(fetch16())); break; // CMP Y,!a
+
+			// loads
+			case 0xe8: A = setNZ(fetch()); break; // MOV A,#i
+			case 0xe4: A = setNZ(readDirect(fetch())); break; // MOV A,d
+			case 0xf4: A = setNZ(readDirect(fetch() + X)); break; // MOV A,d+X
+			case 0xe5: A = setNZ(read(fetch16())); break; // MOV A,!a
+			case 0xf5: A = setNZ(read(fetch16() + X)); break; // MOV A,!a+X
+			case 0xf6: A = setNZ(read(fetch16() + Y)); break; // MOV A,!a+Y
+			case 0xe6: A = setNZ(readDirect(X)); break; // MOV A,(X)
+			case 0xbf: A = setNZ(readDirect(X++)); break; // MOV A,(X)+
+			case 0xe7: A = setNZ(read(readDirect16(fetch() + X))); break; // MOV A,[d+X]
+			case 0xf7: A = setNZ(read(readDirect16(fetch()) + Y)); break; // MOV A,[d]+Y
+			case 0xcd: X = setNZ(fetch()); break; // MOV X,#i
+			case 0xf8: X = setNZ(readDirect(fetch())); break; // MOV X,d
+			case 0xf9: X = setNZ(readDirect(fetch() + Y)); break; // MOV X,d+Y
+			case 0xe9: X = setNZ(read(fetch16())); break; // MOV X,!a
+			case 0x8d: Y = setNZ(fetch()); break; // MOV Y,#i
+			case 0xeb: Y = setNZ(readDirect(fetch())); break; // MOV Y,d
+			case 0xfb: Y = setNZ(readDirect(fetch() + X)); break; // MOV Y,d+X
+			case 0xec: Y = setNZ(read(fetch16())); break; // MOV Y,!a
+
+			// stores
+			case 0xc4: writeDirect(fetch(), A); break; // MOV d,A
+			case 0xd4: writeDirect(fetch() + X, A); break; // MOV d+X,A
+			case 0xc5: write(fetch16(), A); break; // MOV !a,A
+			case 0xd5: write(fetch16() + X, A); break; // MOV !a+X,A
+			case 0xd6: write(fetch16() + Y, A); break; // MOV !a+Y,A
+			case 0xc6: writeDirect(X, A); break; // MOV (X),A
+			case 0xaf: writeDirect(X++, A); break; // MOV (X)+,A
+			case 0xc7: write(readDirect16(fetch() + X), A); break; // MOV [d+X],A
+			case 0xd7: write(readDirect16(fetch()) + Y, A); break; // MOV [d]+Y,A
+			case 0xd8: writeDirect(fetch(), X); break; // MOV d,X
+			case 0xd9: writeDirect(fetch() + Y, X); break; // MOV d+Y,X
+			case 0xc9: write(fetch16(), X); break; // MOV !a,X
+			case 0xcb: writeDirect(fetch(), Y); break; // MOV d,Y
+			case 0xdb: writeDirect(fetch() + X, Y); break; // MOV d+X,Y
+			case 0xcc: write(fetch16(), Y); break; // MOV !a,Y
+			case 0xfa: { // MOV dd,ds
+				Byte value = readDirect(fetch());
+				writeDirect(fetch(), value);
+				break;
+			}
+			case 0x8f: { // MOV d,#i
+				Byte value = fetch();
+				writeDirect(fetch(), value);
+				break;
+			}
+
+			// transfers
+			case 0x5d: X = setNZ(A); break; // MOV X,A
+			case 0x7d: A = setNZ(X); break; // MOV A,X
+			case 0xdd: A = setNZ(Y); break; // MOV A,Y
+			case 0xfd: Y = setNZ(A); break; // MOV Y,A
+			case 0x9d: X = setNZ(SP); break; // MOV X,SP
+			case 0xbd: SP = X; break; // MOV SP,X
+
+			// X and Y increments/decrements
+			case 0x1d: X = setNZ(X - 1); break; // DEC X
+			case 0x3d: X = setNZ(X + 1); break; // INC X
+			case 0xdc: Y = setNZ(Y - 1); break; // DEC Y
+			case 0xfc: Y = setNZ(Y + 1); break; // INC Y
+
+			// 16-bit operations
+			case 0x1a: // DECW d
+			case 0x3a: { // INCW d
+				Byte offset = fetch();
+				Word value = readDirect16(offset) + (opcode == 0x3a ? 1 : -1);
+				writeDirect16(offset, value);
+				setFlag(flags::n, (value & 0x8000) != 0);
+				setFlag(flags::z, value == 0);
+				break;
+			}
+			case 0xba: { // MOVW YA,d
+				Word value = readDirect16(fetch());
+				A = value & 0xff;
+				Y = value >> 8;
+				setFlag(flags::n, (value & 0x8000) != 0);
+				setFlag(flags::z, value == 0);
+				break;
+			}
+			case 0xda: // MOVW d,YA
+				writeDirect16(fetch(), concat16(Y, A));
+				break;
+			case 0x5a: { // CMPW YA,d
+				int result = concat16(Y, A) - readDirect16(fetch());
+				setFlag(flags::c, result >= 0);
+				setFlag(flags::n, (result & 0x8000) != 0);
+				setFlag(flags::z, (result & 0xffff) == 0);
+				break;
+			}
+			case 0x7a: // ADDW YA,d
+			case 0x9a: { // SUBW YA,d
+				// these are just two chained 8-bit additions/subtractions (which is also where the flags come from)
+				Word value = readDirect16(fetch());
+				bool subtract = opcode == 0x9a;
+				setFlag(flags::c, subtract);
+				A = subtract ? sbc(A, value & 0xff) : adc(A, value & 0xff);
+				Y = subtract ? sbc(Y, value >> 8) : adc(Y, value >> 8);
+				setFlag(flags::z, A == 0 && Y == 0);
+				break;
+			}
+
+			// multiplication and division
+			case 0xcf: { // MUL YA
+				Word result = Y * A;
+				A = result & 0xff;
+				Y = setNZ(result >> 8);
+				break;
+			}
+			case 0x9e: { // DIV YA,X
+				unsigned dividend = concat16(Y, A);
+				setFlag(flags::v, Y >= X);
+				setFlag(flags::h, (Y & 0x0f) >= (X & 0x0f));
+
+				if (Y < (X << 1)) {
+					A = dividend / X;
+					Y = dividend % X;
+				} else {
+					// the quotient doesn't fit into 9 bits; this is what the hardware's division algorithm produces in that case
+					A = 255 - (dividend - (X << 9)) / (256 - X);
+					Y = X + (dividend - (X << 9)) % (256 - X);
+				}
+
+				setNZ(A);
+				break;
+			}
+
+			// decimal adjustment
+			case 0xdf: // DAA
+				if (getFlag(flags::c) || A > 0x99) {
+					A += 0x60;
+					setFlag(flags::c, true);
+				}
+				if (getFlag(flags::h) || (A & 0x0f) > 0x09) {
+					A += 0x06;
+				}
+				setNZ(A);
+				break;
+			case 0xbe: // DAS
+				if (!getFlag(flags::c) || A > 0x99) {
+					A -= 0x60;
+					setFlag(flags::c, false);
+				}
+				if (!getFlag(flags::h) || (A & 0x0f) > 0x09) {
+					A -= 0x06;
+				}
+				setNZ(A);
+				break;
+
+			case 0x9f: A = setNZ((A >> 4) | (A << 4)); break; // XCN
+
+			// test-and-set/clear
+			case 0x0e: // TSET1 !a
+			case 0x4e: { // TCLR1 !a
+				Word address = fetch16();
+				Byte value = read(address);
+				setNZ(A - value);
+				write(address, opcode == 0x0e ? (value | A) : (value & ~A));
+				break;
+			}
+
+			// single-bit operations
+			case 0x0a: // OR1 C,m.b
+			case 0x2a: // OR1 C,/m.b
+			case 0x4a: // AND1 C,m.b
+			case 0x6a: // AND1 C,/m.b
+			case 0x8a: // EOR1 C,m.b
+			case 0xaa: { // MOV1 C,m.b
+				Word address;
+				Byte bit;
+				fetchMemoryBit(address, bit);
+				bool value = (read(address) & (1 << bit)) != 0;
+				bool carry = getFlag(flags::c);
+
+				switch (opcode) {
+					case 0x0a: carry = carry || value; break;
+					case 0x2a: carry = carry || !value; break;
+					case 0x4a: carry = carry && value; break;
+					case 0x6a: carry = carry && !value; break;
+					case 0x8a: carry = carry != value; break;
+					default:   carry = value; break;
+				}
+
+				setFlag(flags::c, carry);
+				break;
+			}
+			case 0xca: // MOV1 m.b,C
+			case 0xea: { // NOT1 m.b
+				Word address;
+				Byte bit;
+				fetchMemoryBit(address, bit);
+				Byte value = read(address);
+
+				if (opcode == 0xea) {
+					value ^= (1 << bit);
+				} else if (getFlag(flags::c)) {
+					value |= (1 << bit);
+				} else {
+					value &= ~(1 << bit);
+				}
+
+				write(address, value);
+				break;
+			}
+
+			case 0xef: // SLEEP
+			case 0xff: // STOP
+				stopped = true;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	advanceClock(elapsed);
+	return elapsed;
+};
@@ -0,0 +1,129 @@
+#include <blaze/SPCSnapshot.hpp>
+#include <blaze/SPC700.hpp>
+#include <blaze/util.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Blaze {
+	static constexpr char SPC_SIGNATURE[] = "SNES-SPC700 Sound File Data";
+	static constexpr size_t SPC_SIGNATURE_SIZE = sizeof(SPC_SIGNATURE) - 1;
+
+	// the value of the "has ID666" byte when there is a tag
+	static constexpr Byte ID666_PRESENT = 26;
+	static constexpr size_t ID666_TITLE_SIZE = 32;
+
+	struct SnapshotRegisters {
+		enum IgnoreMe: Word {
+			CONTROL  = 0xf1,
+			DSPADDR  = 0xf2,
+			DSPDATA  = 0xf3,
+			CPUIO0   = 0xf4,
+			T0TARGET = 0xfa,
+			T0OUT    = 0xfd,
+
+			// in the DSP
+			KON = 0x4c,
+		};
+	};
+
+	// bits 4 and 5 of CONTROL aren't state, they clear the input ports when they're written
+	static constexpr Byte CONTROL_STATE_MASK = 0x87;
+
+	static std::string readTitle(const std::vector<Byte>& file, size_t offset) {
+		auto begin = reinterpret_cast<const char*>(file.data() + offset);
+		return std::string(begin, std::find(begin, begin + ID666_TITLE_SIZE, '\0'));
+	};
+} // namespace Blaze
+
+void Blaze::SPCSnapshot::load(const std::string& path) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+	if (!file.is_open()) {
+		throw std::runtime_error("failed to open SPC file: " + path);
+	}
+
+	size_t size = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	std::vector<Byte> contents(size);
+
+	if (!file.read(reinterpret_cast<char*>(contents.data()), size)) {
+		throw std::runtime_error("failed to read SPC file: " + path);
+	}
+
+	if (size < MINIMUM_SIZE) {
+		throw std::runtime_error("SPC file too small: " + std::to_string(size));
+	}
+
+	if (std::memcmp(contents.data() + HeaderOffset::Signature, SPC_SIGNATURE, SPC_SIGNATURE_SIZE) != 0) {
+		throw std::runtime_error("not an SPC file: " + path);
+	}
+
+	PC = concat16(contents[HeaderOffset::PC + 1], contents[HeaderOffset::PC]);
+	A = contents[HeaderOffset::A];
+	X = contents[HeaderOffset::X];
+	Y = contents[HeaderOffset::Y];
+	PSW = contents[HeaderOffset::PSW];
+	SP = contents[HeaderOffset::SP];
+
+	std::copy_n(contents.begin() + ARAM_OFFSET, aram.size(), aram.begin());
+	std::copy_n(contents.begin() + DSP_REGISTERS_OFFSET, dspRegisters.size(), dspRegisters.begin());
+
+	songTitle.clear();
+	gameTitle.clear();
+
+	if (contents[HeaderOffset::HasID666] == ID666_PRESENT) {
+		songTitle = readTitle(contents, HeaderOffset::SongTitle);
+		gameTitle = readTitle(contents, HeaderOffset::GameTitle);
+	}
+};
+
+void Blaze::SPCSnapshot::restore(SPC700& spc) const {
+	spc.reset();
+
+	// the I/O registers are restored by writing them, just like the SPC700 would
+	Byte control = aram[SnapshotRegisters::CONTROL] & CONTROL_STATE_MASK;
+
+	for (size_t i = 0; i < spc.timers.size(); ++i) {
+		spc.write(SnapshotRegisters::T0TARGET + i, aram[SnapshotRegisters::T0TARGET + i]);
+	}
+
+	spc.write(SnapshotRegisters::CONTROL, control);
+
+	// (enabling the timers cleared their counters)
+	for (size_t i = 0; i < spc.timers.size(); ++i) {
+		spc.timers[i].counter = aram[SnapshotRegisters::T0OUT + i] & 0x0f;
+	}
+
+	// KON goes last so that the voices it keys on start with the rest of their registers already in place
+	for (size_t address = 0; address < dspRegisters.size(); ++address) {
+		if (address != SnapshotRegisters::KON) {
+			spc.write(SnapshotRegisters::DSPADDR, address);
+			spc.write(SnapshotRegisters::DSPDATA, dspRegisters[address]);
+		}
+	}
+
+	spc.write(SnapshotRegisters::DSPADDR, SnapshotRegisters::KON);
+	spc.write(SnapshotRegisters::DSPDATA, dspRegisters[SnapshotRegisters::KON]);
+
+	spc.write(SnapshotRegisters::DSPADDR, aram[SnapshotRegisters::DSPADDR]);
+
+	for (size_t i = 0; i < spc.portsFromCPU.size(); ++i) {
+		spc.portsFromCPU[i] = aram[SnapshotRegisters::CPUIO0 + i];
+	}
+
+	// the register writes above went through to ARAM, so this has to come after them.
+	// the DSP hasn't generated anything since it was reset, so its BRR cache is still empty.
+	spc.aram = aram;
+
+	spc.A = A;
+	spc.X = X;
+	spc.Y = Y;
+	spc.PSW = PSW;
+	spc.SP = SP;
+	spc.PC = PC;
+};
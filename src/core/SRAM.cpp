@@ -4,7 +4,8 @@
 #include <cassert>
 
 void Blaze::SRAM::setSize(size_t size) {
-	_data.resize(size, 0);
+	_data.resize(size);
+	_dirty.resize(size);
 };
 
 Blaze::Byte Blaze::SRAM::registerSize(Address offset, Byte attemptedAccessSize) {
@@ -14,19 +15,35 @@ Blaze::Byte Blaze::SRAM::registerSize(Address offset, Byte attemptedAccessSize)
 Blaze::Address Blaze::SRAM::read(Address offset, Byte bitSize) {
 	assert(bitSize == 8);
 
+	if (_data.size() == 0) {
+		// no SRAM on this cartridge
+		return 0;
+	}
+
 	offset %= _data.size();
 
-	return _data[offset];
+	return _data.read(offset);
 };
 
 void Blaze::SRAM::write(Address offset, Byte bitSize, Address value) {
 	assert(bitSize == 8);
 
+	if (_data.size() == 0) {
+		return;
+	}
+
 	offset %= _data.size();
 
-	_data[offset] = value;
+	_data.write(offset, value);
+	_dirty.mark(offset);
 };
 
 void Blaze::SRAM::reset(Bus* bus) {
-	std::fill(_data.begin(), _data.end(), 0);
+	_data.fill(0);
+	_dirty.clear();
+};
+
+void Blaze::SRAM::shareFrom(const SRAM& other) {
+	_data.shareFrom(other._data);
+	_dirty.resize(_data.size());
 };
@@ -0,0 +1,64 @@
+#include <blaze/Scheduler.hpp>
+#include <blaze/Bus.hpp>
+
+#include <algorithm>
+
+Blaze::Byte Blaze::Scheduler::advance(Bus& bus, uint64_t cycles) {
+	_position += cycles;
+
+	// this has to see every instruction (even the ones in interrupt handlers)
+	if (_idleLoopDetector.check(bus)) {
+		// nothing the CPU can see changes before the next event (a timer IRQ, hblank, or the next scanline), so skip straight to it
+		uint64_t nextEvent = std::min<uint64_t>(bus.interrupts.nextEvent(), MASTER_CLOCKS_PER_SCANLINE);
+
+		if (_position < InterruptController::HBLANK_START) {
+			nextEvent = std::min<uint64_t>(nextEvent, InterruptController::HBLANK_START);
+		}
+
+		if (_position < nextEvent) {
+			bus.cpu.cycleCounter += nextEvent - _position;
+			_position = nextEvent;
+		}
+	}
+
+	if (_position < MASTER_CLOCKS_PER_SCANLINE) {
+		bus.interrupts.advance(_position);
+		return 0;
+	}
+
+	// finish off this scanline (in case there's a timer right at its end) before moving on to the next one
+	bus.interrupts.advance(MASTER_CLOCKS_PER_SCANLINE - 1);
+
+	Byte events = Events::NEW_SCANLINE;
+
+	// whatever the instruction took past the end of the scanline counts towards the next one
+	_position -= MASTER_CLOCKS_PER_SCANLINE;
+	_scanline = (_scanline + 1) % SCANLINES;
+
+	bus.interrupts.beginScanline(_scanline);
+
+	if (_scanline == 0) {
+		bus.interrupts.endVBlank();
+		events |= Events::VBLANK_END;
+	}
+
+	if (_scanline == vblankFirstScanline()) {
+		bus.interrupts.beginVBlank();
+		events |= Events::VBLANK_START;
+
+		if (bus.interrupts.autoJoypadRead()) {
+			bus.joypads.autoRead();
+			bus.interrupts.beginAutoJoypadRead();
+		}
+	}
+
+	bus.interrupts.advance(_position);
+
+	return events;
+};
+
+void Blaze::Scheduler::reset() {
+	_scanline = 0;
+	_position = 0;
+	_idleLoopDetector.reset();
+};
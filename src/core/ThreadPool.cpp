@@ -0,0 +1,89 @@
+#include <blaze/ThreadPool.hpp>
+
+Blaze::ThreadPool::ThreadPool(size_t threadCount) {
+	_threads.reserve(threadCount);
+
+	for (size_t i = 0; i < threadCount; ++i) {
+		_threads.emplace_back(&ThreadPool::threadMain, this, i + 1);
+	}
+};
+
+Blaze::ThreadPool::~ThreadPool() {
+	{
+		std::unique_lock lock(_mutex);
+		_stop = true;
+	}
+	_startCondVar.notify_all();
+
+	for (auto& thread: _threads) {
+		thread.join();
+	}
+};
+
+void Blaze::ThreadPool::run(size_t taskCount, const Job& job) {
+	if (_threads.empty() || taskCount <= 1) {
+		for (size_t task = 0; task < taskCount; ++task) {
+			job(task, 0);
+		}
+		return;
+	}
+
+	{
+		std::unique_lock lock(_mutex);
+		_job = &job;
+		_taskCount = taskCount;
+		_nextTask = 0;
+		_busyThreads = _threads.size();
+		++_generation;
+	}
+	_startCondVar.notify_all();
+
+	work(job, taskCount, 0);
+
+	// every thread has to check in before we return, even the ones that didn't get a task;
+	// otherwise, a straggler could still be looking at this job when the next one starts
+	std::unique_lock lock(_mutex);
+	_doneCondVar.wait(lock, [&]() {
+		return _busyThreads == 0;
+	});
+	_job = nullptr;
+};
+
+void Blaze::ThreadPool::work(const Job& job, size_t taskCount, size_t worker) {
+	for (size_t task = _nextTask++; task < taskCount; task = _nextTask++) {
+		job(task, worker);
+	}
+};
+
+void Blaze::ThreadPool::threadMain(size_t worker) {
+	size_t generation = 0;
+
+	while (true) {
+		const Job* job = nullptr;
+		size_t taskCount = 0;
+
+		{
+			std::unique_lock lock(_mutex);
+			_startCondVar.wait(lock, [&]() {
+				return _stop || _generation != generation;
+			});
+
+			if (_stop) {
+				return;
+			}
+
+			generation = _generation;
+			job = _job;
+			taskCount = _taskCount;
+		}
+
+		work(*job, taskCount, worker);
+
+		{
+			std::unique_lock lock(_mutex);
+			if (--_busyThreads == 0) {
+				_doneCondVar.notify_all();
+			}
+		}
+	}
+};
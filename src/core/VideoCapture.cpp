@@ -0,0 +1,178 @@
+#include <blaze/VideoCapture.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+Blaze::VideoCapture::VideoCapture(const std::string& path, Format format, size_t width, size_t height, size_t queueDepth):
+	_format(format),
+	_width(width),
+	_height(height)
+{
+	if (path == "-") {
+		_file = stdout;
+	} else {
+		_file = std::fopen(path.c_str(), "wb");
+		_ownsFile = true;
+	}
+
+	if (_file == nullptr) {
+		throw std::runtime_error("failed to open capture file: " + path);
+	}
+
+	queueDepth = std::max<size_t>(queueDepth, 1);
+
+	_buffers.resize(queueDepth, std::vector<uint32_t>(width * height));
+	_freeBuffers.reserve(queueDepth);
+	_queue.resize(queueDepth);
+
+	for (size_t i = 0; i < queueDepth; ++i) {
+		_freeBuffers.push_back(i);
+	}
+
+	// big enough for either format (4 bytes per pixel for raw RGBA, 3 for 4:4:4 YUV)
+	_encoded.resize(width * height * 4);
+
+	if (_format == Format::Y4M) {
+		// NTSC runs at (just about) 60.0988 frames per second
+		auto header = "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) + " F60099:1000 Ip A1:1 C444\n";
+		std::fwrite(header.data(), 1, header.size(), _file);
+	}
+
+	_writerThread = std::thread(&VideoCapture::writerThreadMain, this);
+};
+
+Blaze::VideoCapture::~VideoCapture() {
+	finish();
+};
+
+void Blaze::VideoCapture::finish() {
+	if (_file == nullptr) {
+		return;
+	}
+
+	{
+		std::unique_lock lock(_mutex);
+		_stop = true;
+	}
+	_queuedCondVar.notify_all();
+	_writerThread.join();
+
+	std::fflush(_file);
+
+	if (_ownsFile) {
+		std::fclose(_file);
+	}
+
+	_file = nullptr;
+};
+
+Blaze::VideoCapture::Format Blaze::VideoCapture::formatForPath(const std::string& path) {
+	static const std::string extension = ".y4m";
+
+	if (path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+		return Format::Y4M;
+	}
+
+	return Format::RawRGBA;
+};
+
+void Blaze::VideoCapture::submit(const uint32_t* pixels) {
+	size_t index = 0;
+
+	{
+		std::unique_lock lock(_mutex);
+
+		if (_freeBuffers.empty()) {
+			++_overflows;
+			_freedCondVar.wait(lock, [&]() {
+				return !_freeBuffers.empty();
+			});
+		}
+
+		index = _freeBuffers.back();
+		_freeBuffers.pop_back();
+	}
+
+	// the buffer belongs to us until it's queued, so this copy doesn't need the lock
+	std::copy(pixels, pixels + (_width * _height), _buffers[index].begin());
+
+	{
+		std::unique_lock lock(_mutex);
+		_queue[(_queueHead + _queueSize) % _queue.size()] = index;
+		++_queueSize;
+	}
+	_queuedCondVar.notify_one();
+};
+
+void Blaze::VideoCapture::writerThreadMain() {
+	while (true) {
+		size_t index = 0;
+
+		{
+			std::unique_lock lock(_mutex);
+			_queuedCondVar.wait(lock, [&]() {
+				return _queueSize > 0 || _stop;
+			});
+
+			// finish writing everything that's been queued before stopping
+			if (_queueSize == 0) {
+				break;
+			}
+
+			index = _queue[_queueHead];
+			_queueHead = (_queueHead + 1) % _queue.size();
+			--_queueSize;
+		}
+
+		encode(_buffers[index]);
+
+		{
+			std::unique_lock lock(_mutex);
+			_freeBuffers.push_back(index);
+		}
+		_freedCondVar.notify_one();
+
+		size_t size = (_format == Format::Y4M ? 3 : 4) * _width * _height;
+
+		if (_format == Format::Y4M) {
+			static constexpr char frameHeader[] = "FRAME\n";
+			std::fwrite(frameHeader, 1, sizeof(frameHeader) - 1, _file);
+		}
+
+		if (std::fwrite(_encoded.data(), 1, size, _file) != size) {
+			_writeFailed = true;
+		} else {
+			++_framesWritten;
+		}
+	}
+};
+
+void Blaze::VideoCapture::encode(const std::vector<uint32_t>& frame) {
+	size_t pixelCount = _width * _height;
+
+	if (_format == Format::RawRGBA) {
+		for (size_t i = 0; i < pixelCount; ++i) {
+			auto pixel = frame[i];
+			_encoded[(i * 4) + 0] = (pixel >> 24) & 0xff;
+			_encoded[(i * 4) + 1] = (pixel >> 16) & 0xff;
+			_encoded[(i * 4) + 2] = (pixel >>  8) & 0xff;
+			_encoded[(i * 4) + 3] = (pixel >>  0) & 0xff;
+		}
+		return;
+	}
+
+	// BT.601 (limited range), one plane after another
+	auto* yPlane = _encoded.data();
+	auto* uPlane = yPlane + pixelCount;
+	auto* vPlane = uPlane + pixelCount;
+
+	for (size_t i = 0; i < pixelCount; ++i) {
+		int32_t r = (frame[i] >> 24) & 0xff;
+		int32_t g = (frame[i] >> 16) & 0xff;
+		int32_t b = (frame[i] >>  8) & 0xff;
+
+		yPlane[i] = static_cast<uint8_t>(((( 66 * r) + (129 * g) + ( 25 * b) + 128) >> 8) +  16);
+		uPlane[i] = static_cast<uint8_t>((((-38 * r) - ( 74 * g) + (112 * b) + 128) >> 8) + 128);
+		vPlane[i] = static_cast<uint8_t>((((112 * r) - ( 94 * g) - ( 18 * b) + 128) >> 8) + 128);
+	}
+};
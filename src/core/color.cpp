@@ -0,0 +1,89 @@
+#include <blaze/color.hpp>
+
+#include <mutex>
+
+// these are basically magic values that have been adapted from SDL.
+// the idea is to try to map the range of 5-bit values onto the full range of 8-bit values
+// and distribute them more-or-less evenly.
+static constexpr std::array<std::uint8_t, 32> RANGE_CONVERSION_5_TO_8_BIT = {
+	0,
+	8,
+	16,
+	24,
+	32,
+	41,
+	49,
+	57,
+	65,
+	74,
+	82,
+	90,
+	98,
+	106,
+	115,
+	123,
+	131,
+	139,
+	148,
+	156,
+	164,
+	172,
+	180,
+	189,
+	197,
+	205,
+	213,
+	222,
+	230,
+	238,
+	246,
+	255,
+};
+
+Blaze::ColorTable::ColorTable(std::uint8_t brightness):
+	_brightness(brightness & 0x0f)
+{
+	rebuild();
+};
+
+std::shared_ptr<const Blaze::ColorTable> Blaze::ColorTable::shared(std::uint8_t brightness) {
+	static std::mutex mutex;
+	static std::array<std::shared_ptr<const ColorTable>, MAX_BRIGHTNESS + 1> tables;
+
+	brightness &= 0x0f;
+
+	std::unique_lock lock(mutex);
+	auto& table = tables[brightness];
+
+	if (!table) {
+		table = std::make_shared<const ColorTable>(brightness);
+	}
+
+	return table;
+};
+
+bool Blaze::ColorTable::setBrightness(std::uint8_t brightness) {
+	brightness &= 0x0f;
+
+	if (brightness == _brightness) {
+		return false;
+	}
+
+	_brightness = brightness;
+	rebuild();
+	return true;
+};
+
+void Blaze::ColorTable::rebuild() {
+	for (std::uint32_t value = 0; value < _entries.size(); ++value) {
+		_entries[value] = convert(value, _brightness).toRGBA8888();
+	}
+};
+
+Blaze::Color Blaze::ColorTable::convert(std::uint16_t bgr555, std::uint8_t brightness) {
+	auto scale = [&](std::uint8_t component) {
+		return static_cast<std::uint8_t>((static_cast<unsigned>(RANGE_CONVERSION_5_TO_8_BIT[component & 0x1f]) * brightness) / MAX_BRIGHTNESS);
+	};
+
+	return Color(scale(bgr555 >> 0), scale(bgr555 >> 5), scale(bgr555 >> 10));
+};
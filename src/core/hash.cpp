@@ -0,0 +1,186 @@
+#include <blaze/hash.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+	constexpr uint64_t PRIME_1 = 0x9e3779b185ebca87ull;
+	constexpr uint64_t PRIME_2 = 0xc2b2ae3d27d4eb4full;
+	constexpr uint64_t PRIME_3 = 0x165667b19e3779f9ull;
+	constexpr uint64_t PRIME_4 = 0x85ebca77c2b2ae63ull;
+	constexpr uint64_t PRIME_5 = 0x27d4eb2f165667c5ull;
+
+	inline uint64_t rotateLeft(uint64_t value, unsigned amount) {
+		return (value << amount) | (value >> (64 - amount));
+	};
+
+	// note that these assume a little-endian host (like the rest of the emulator)
+	inline uint64_t read64(const uint8_t* data) {
+		uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	};
+
+	inline uint32_t read32(const uint8_t* data) {
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	};
+
+	inline uint64_t hashRound(uint64_t accumulator, uint64_t input) {
+		accumulator += input * PRIME_2;
+		accumulator = rotateLeft(accumulator, 31);
+		return accumulator * PRIME_1;
+	};
+
+	inline uint64_t mergeRound(uint64_t accumulator, uint64_t lane) {
+		accumulator ^= hashRound(0, lane);
+		return (accumulator * PRIME_1) + PRIME_4;
+	};
+};
+
+Blaze::Hash64::Hash64(uint64_t seed):
+	_seed(seed)
+{
+	_lanes[0] = seed + PRIME_1 + PRIME_2;
+	_lanes[1] = seed + PRIME_2;
+	_lanes[2] = seed;
+	_lanes[3] = seed - PRIME_1;
+};
+
+void Blaze::Hash64::consumeStripe(const uint8_t* stripe) {
+	_lanes[0] = hashRound(_lanes[0], read64(stripe +  0));
+	_lanes[1] = hashRound(_lanes[1], read64(stripe +  8));
+	_lanes[2] = hashRound(_lanes[2], read64(stripe + 16));
+	_lanes[3] = hashRound(_lanes[3], read64(stripe + 24));
+};
+
+void Blaze::Hash64::update(const void* data, size_t size) {
+	auto* input = static_cast<const uint8_t*>(data);
+
+	_totalSize += size;
+
+	// top off a partial stripe left over from last time
+	if (_bufferSize > 0) {
+		size_t count = std::min(size, sizeof(_buffer) - _bufferSize);
+
+		std::memcpy(_buffer + _bufferSize, input, count);
+		_bufferSize += count;
+		input += count;
+		size -= count;
+
+		if (_bufferSize < sizeof(_buffer)) {
+			return;
+		}
+
+		consumeStripe(_buffer);
+		_bufferSize = 0;
+	}
+
+	for (; size >= sizeof(_buffer); input += sizeof(_buffer), size -= sizeof(_buffer)) {
+		consumeStripe(input);
+	}
+
+	std::memcpy(_buffer, input, size);
+	_bufferSize = size;
+};
+
+uint64_t Blaze::Hash64::digest() const {
+	uint64_t result = 0;
+
+	if (_totalSize >= sizeof(_buffer)) {
+		result = rotateLeft(_lanes[0], 1) + rotateLeft(_lanes[1], 7) + rotateLeft(_lanes[2], 12) + rotateLeft(_lanes[3], 18);
+
+		for (auto lane: _lanes) {
+			result = mergeRound(result, lane);
+		}
+	} else {
+		result = _seed + PRIME_5;
+	}
+
+	result += _totalSize;
+
+	const uint8_t* tail = _buffer;
+	size_t remaining = _bufferSize;
+
+	for (; remaining >= 8; tail += 8, remaining -= 8) {
+		result ^= hashRound(0, read64(tail));
+		result = (rotateLeft(result, 27) * PRIME_1) + PRIME_4;
+	}
+
+	if (remaining >= 4) {
+		result ^= static_cast<uint64_t>(read32(tail)) * PRIME_1;
+		result = (rotateLeft(result, 23) * PRIME_2) + PRIME_3;
+		tail += 4;
+		remaining -= 4;
+	}
+
+	for (; remaining > 0; ++tail, --remaining) {
+		result ^= *tail * PRIME_5;
+		result = rotateLeft(result, 11) * PRIME_1;
+	}
+
+	// avalanche
+	result ^= result >> 33;
+	result *= PRIME_2;
+	result ^= result >> 29;
+	result *= PRIME_3;
+	result ^= result >> 32;
+
+	return result;
+};
+
+uint64_t Blaze::Hash64::hash(const void* data, size_t size, uint64_t seed) {
+	Hash64 hasher(seed);
+	hasher.update(data, size);
+	return hasher.digest();
+};
+
+std::string Blaze::FrameHashes::toString() const {
+	char line[80];
+	std::snprintf(line, sizeof(line), "%" PRIu64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64, frame, framebuffer, wram, vram);
+	return line;
+};
+
+bool Blaze::FrameHashes::parse(const std::string& line, FrameHashes& output) {
+	char trailing = 0;
+	return std::sscanf(line.c_str(), "%" SCNu64 " %" SCNx64 " %" SCNx64 " %" SCNx64 " %c", &output.frame, &output.framebuffer, &output.wram, &output.vram, &trailing) == 4;
+};
+
+Blaze::FrameHashChecker::FrameHashChecker(std::istream& golden) {
+	std::string line;
+
+	while (std::getline(golden, line)) {
+		if (line.empty()) {
+			continue;
+		}
+
+		auto& hashes = _golden.emplace_back();
+
+		if (!FrameHashes::parse(line, hashes)) {
+			throw std::runtime_error("invalid frame hash line: " + line);
+		}
+	}
+};
+
+bool Blaze::FrameHashChecker::check(const FrameHashes& hashes) {
+	if (_failed) {
+		return false;
+	}
+
+	if (finished()) {
+		// frames past the end of the golden file aren't checked
+		return true;
+	}
+
+	if (hashes != _golden[_next]) {
+		_failed = true;
+		return false;
+	}
+
+	++_next;
+	return true;
+};
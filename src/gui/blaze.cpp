@@ -15,10 +15,19 @@
 #include <mutex>
 #include <blaze/PPU.hpp>
 #include <blaze/APU.hpp>
+#include <blaze/VideoCapture.hpp>
+#include <blaze/AudioRing.hpp>
+#include <blaze/AudioResampler.hpp>
+#include <blaze/hash.hpp>
+#include <blaze/Scheduler.hpp>
 #include <blaze/debug.hpp>
 #include <shared_mutex>
 #include <condition_variable>
 #include <chrono>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <type_traits>
 
 // Define SNES key constants
 #define SNES_KEY_UP      0
@@ -49,13 +58,10 @@ namespace Blaze {
 	static constexpr Color defaultWindowColor { 0, 0, 0 };
 	static constexpr int snesWidth = 256;
 	static constexpr int snesHeight = 224;
-	static constexpr auto snesMasterClock = std::chrono::duration_cast<std::chrono::milliseconds>(1s) / 21447000;
+	static constexpr auto snesMasterClock = std::chrono::duration<double, std::nano>(1s) / 21447000;
 	static constexpr auto snesFrameTime = snesMasterClock * 357368;
-	static constexpr auto snesScanlineMasterClockCycles = 1364;
+	static constexpr auto snesScanlineMasterClockCycles = Scheduler::MASTER_CLOCKS_PER_SCANLINE;
 	static constexpr auto snesScanlineTime = snesMasterClock * snesScanlineMasterClockCycles;
-	static constexpr auto snesVblankFirstScanline = 225;
-	static constexpr auto snesVblankFirstScanlineOverscan = 240;
-	static constexpr auto snesScanlines = 262;
 	static constexpr size_t maxConsoleChars = 5000;
 
 #ifdef _WIN32
@@ -108,11 +114,41 @@ namespace Blaze {
 	static std::shared_mutex continuousExecutionMutex;
 	static std::condition_variable_any continuousExecutionCondVar;
 	static Bus bus;
-	static Address breakpoint = UINT32_MAX;
+
+	// breakpoints only work with the debugger's instrumentation (see `BLAZE_GUI_DEBUGGER` in `CMakeLists.txt`)
+	static constexpr Address noBreakpoint = Instrumentation::None::NO_BREAKPOINT;
 	static bool romLoaded = false;
 	static std::condition_variable_any romLoadedCondVar;
 	static std::shared_mutex romLoadedMutex;
 	static bool running = true;
+
+	// multiples of real time that fast-forward can run at (cycled through with F7); 0 means unthrottled
+	static constexpr std::array<unsigned, 4> fastForwardSpeeds { 2, 4, 8, 0 };
+	static size_t fastForwardSpeedIndex = 1;
+
+	// when running unthrottled, only one out of this many frames gets rendered
+	static constexpr unsigned unthrottledRenderInterval = 10;
+
+	// the current multiple of real time to run at (with the same meaning as `fastForwardSpeeds`)
+	static std::atomic<unsigned> emulationSpeed = 1;
+
+	// audio goes from the CPU thread to the audio device through this ring; at normal speed, the CPU thread waits
+	// for the device to drain it down to half full after every frame, which makes the audio device the pacing clock.
+	static constexpr int audioDeviceRate = 48000;
+	static constexpr int audioDeviceBufferSize = 512;
+	static AudioRing audioRing(4096);
+	static std::atomic<bool> audioPacing = false;
+
+	// per-frame hashes for regression checks (`--hash-output <path>` and/or `--hash-golden <path>`)
+	struct FrameHashing {
+		bool enabled = false;
+		std::ofstream output;
+		std::unique_ptr<FrameHashChecker> checker;
+		uint64_t frame = 0;
+		uint64_t framebufferHash = 0;
+		bool mismatch = false;
+	};
+	static FrameHashing frameHashing;
 } // namespace Blaze
 
 static void updateBreakpoint(Blaze::Address address, bool shouldUpdateTextField = true);
@@ -322,13 +358,13 @@ static HWND win32DebugConsoleTextWindow = nullptr;
 static HWND win32BreakpointAddressInput = nullptr;
 
 static void updateBreakpoint(Blaze::Address address, bool shouldUpdateTextField) {
-	Blaze::breakpoint = address;
+	Blaze::bus.cpu.instrumentation.setBreakpoint(address);
 
 	if (!shouldUpdateTextField) {
 		return;
 	}
 
-	if (Blaze::breakpoint == UINT32_MAX) {
+	if (address == Blaze::noBreakpoint) {
 		Edit_SetText(win32BreakpointAddressInput, TEXT(""));
 	} else {
 		auto contents = Blaze::valueToHexString(address, 6);
@@ -573,7 +609,7 @@ static LRESULT CALLBACK debuggerWindowProc(HWND hwnd, UINT uMsg, WPARAM wParam,
 #endif
 
 						if (contents.empty()) {
-							updateBreakpoint(UINT32_MAX, false);
+							updateBreakpoint(Blaze::noBreakpoint, false);
 						} else {
 							updateBreakpoint(std::stoul(contents, nullptr, 16), false);
 						}
@@ -685,6 +721,8 @@ static LRESULT CALLBACK debugConsoleWindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
 };
 #else // !_WIN32
 static void updateBreakpoint(Blaze::Address address, bool shouldUpdateTextField) {
+	Blaze::bus.cpu.instrumentation.setBreakpoint(address);
+
 	#warning TODO
 };
 
@@ -707,16 +745,98 @@ static void setContinuousExecution(bool continuousExecution) {
 };
 #endif
 
+static void setEmulationSpeed(Blaze::PPU& ppu, unsigned speed) {
+	Blaze::emulationSpeed = speed;
+
+	// frames we can't present anyways don't need to be rendered (unless we need their hashes)
+	if (!Blaze::frameHashing.enabled) {
+		ppu.setFrameSkip(speed == 0 ? Blaze::unthrottledRenderInterval - 1 : speed - 1);
+	}
+};
+
+template<typename T, size_t PageSize>
+static uint64_t hashPagedMemory(const Blaze::PagedMemory<T, PageSize>& memory) {
+	Blaze::Hash64 hasher;
+
+	for (size_t page = 0; page < memory.pageCount(); ++page) {
+		hasher.update(memory.pageData(page), sizeof(T) * std::min(PageSize, memory.size() - (page * PageSize)));
+	}
+
+	return hasher.digest();
+};
+
+// called at the start of every vblank (once the frame has been rendered) when frame hashing is enabled
+static void recordFrameHashes(const Blaze::Bus& bus, const Blaze::PPU& ppu) {
+	auto& hashing = Blaze::frameHashing;
+
+	Blaze::FrameHashes hashes;
+	hashes.frame = hashing.frame++;
+	hashes.framebuffer = hashing.framebufferHash;
+	hashes.wram = hashPagedMemory(bus.ram.memory());
+	hashes.vram = hashPagedMemory(ppu.vram());
+
+	if (hashing.output.is_open()) {
+		hashing.output << hashes.toString() << '\n';
+	}
+
+	if (hashing.checker && !hashing.checker->check(hashes)) {
+		Blaze::printLine("hash", "Frame " + std::to_string(hashes.frame) + " doesn't match the golden file:\n  expected: " + hashing.checker->expected().toString() + "\n  got:      " + hashes.toString());
+
+		// there's no point in going any further
+		hashing.mismatch = true;
+		Blaze::running = false;
+		Blaze::romLoadedCondVar.notify_all();
+		Blaze::continuousExecutionCondVar.notify_all();
+	}
+};
+
+static void audioCallback(void* userdata, Uint8* stream, int length) {
+	auto& resampler = *static_cast<Blaze::AudioResampler*>(userdata);
+	resampler.render(reinterpret_cast<Blaze::AudioResampler::Sample*>(stream), length / sizeof(Blaze::AudioResampler::Sample));
+};
+
+// sleeps until it's time to start the next frame (according to the current emulation speed)
+static void waitForNextFrame(std::chrono::steady_clock::time_point& deadline) {
+	auto speed = Blaze::emulationSpeed.load();
+	auto now = std::chrono::steady_clock::now();
+
+	if (speed == 0) {
+		deadline = now;
+		return;
+	}
+
+	if (speed == 1 && Blaze::audioPacing) {
+		// the audio device consumes samples in real time, so waiting for it to catch up keeps us in real time too
+		while (Blaze::running && Blaze::audioRing.size() > Blaze::audioRing.capacity() / 2) {
+			std::this_thread::sleep_for(1ms);
+		}
+
+		deadline = std::chrono::steady_clock::now();
+		return;
+	}
+
+	deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(Blaze::snesFrameTime / speed);
+
+	if (deadline > now) {
+		std::this_thread::sleep_until(deadline);
+	} else if (now - deadline > Blaze::snesFrameTime) {
+		// we're too far behind to catch up (e.g. we were paused), so just start over from now
+		deadline = now;
+	}
+};
+
 static void cpuThreadMain(SDL_Window* window) {
 	Blaze::Bus& bus = Blaze::bus;
-	auto totalScanlineTime = 0us;
 	auto& ppu = *dynamic_cast<Blaze::PPU*>(bus.ppu);
-	size_t scanline = 0;
-	size_t totalMasterClockCycles = 0;
+	auto& apu = *dynamic_cast<Blaze::APU*>(bus.apu);
+	Blaze::Scheduler scheduler;
+	auto frameDeadline = std::chrono::steady_clock::now();
+	std::vector<Blaze::DSP::Sample> audioSamples;
 
 	while (Blaze::running) {
-		if (Blaze::concat24(bus.cpu.PBR, bus.cpu.PC) == Blaze::breakpoint) {
-			updateBreakpoint(UINT32_MAX);
+		// this compiles to nothing unless the debugger's instrumentation is in use
+		if (bus.cpu.instrumentation.atBreakpoint(Blaze::concat24(bus.cpu.PBR, bus.cpu.PC))) {
+			updateBreakpoint(Blaze::noBreakpoint);
 			setContinuousExecution(false);
 			updateDisassembly();
 		}
@@ -728,46 +848,51 @@ static void cpuThreadMain(SDL_Window* window) {
 			break;
 		}
 
-		auto beginTime = std::chrono::steady_clock::now();
 		auto beginCycle = bus.cpu.cycleCounter;
 
 		{
 			std::shared_lock lock(Blaze::continuousExecutionMutex);
 
 			if (getRomLoaded() && Blaze::continuousExecution) {
+				// interrupts are only taken between instructions
+				bus.interrupts.service(bus.cpu);
+
 				// execute a single instruction
 				bus.cpu.execute();
 			}
 		}
 
-		auto endTime = std::chrono::steady_clock::now();
 		auto endCycle = bus.cpu.cycleCounter;
 
-		// don't increment clock cycles while in an interrupt
-		if (bus.cpu._interruptStack.empty()) {
-			totalScanlineTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - beginTime);
-			totalMasterClockCycles += (endCycle - beginCycle) * 64;
-		}
+		// the beam keeps moving while an interrupt handler runs (handlers can poll HVBJOY, too)
+		scheduler.setOverscan(ppu.overscan());
+		auto events = scheduler.advance(bus, endCycle - beginCycle);
 
-		if (totalMasterClockCycles >= Blaze::snesScanlineMasterClockCycles) {
-			totalScanlineTime = 0us;
-			totalMasterClockCycles = 0;
-			++scanline;
+		if ((events & Blaze::Scheduler::Events::NEW_SCANLINE) != 0) {
+			// only notify the PPU when we actually move on to a new scanline
+			auto scanline = scheduler.scanline();
 
-			if (scanline >= Blaze::snesScanlines) {
-				scanline = 0;
+			if ((events & Blaze::Scheduler::Events::VBLANK_END) != 0) {
+				ppu.endVBlank();
 			}
-		}
 
-		if (
-			(ppu.overscan() && scanline == Blaze::snesVblankFirstScanlineOverscan) ||
-			(!ppu.overscan() && scanline == Blaze::snesVblankFirstScanline)
-		) {
-			ppu.beginVBlank();
-		}
+			if ((events & Blaze::Scheduler::Events::VBLANK_START) != 0) {
+				ppu.beginVBlank();
+				apu.endFrame();
+
+				// whatever doesn't fit (e.g. when fast-forwarding) gets dropped
+				apu.takeSamples(audioSamples);
+				Blaze::audioRing.push(audioSamples.data(), audioSamples.size());
+				audioSamples.clear();
 
-		if (scanline == 0) {
-			ppu.endVBlank();
+				if (Blaze::frameHashing.enabled) {
+					recordFrameHashes(bus, ppu);
+				}
+
+				waitForNextFrame(frameDeadline);
+			} else if (scanline < scheduler.vblankFirstScanline()) {
+				ppu.beginScanline(scanline);
+			}
 		}
 	}
 };
@@ -822,12 +947,18 @@ int main(int argc, char** argv) {
 	bool holdingRightShift = false;
 	SDL_Renderer* renderer = nullptr;
 	std::thread cpuThread;
+
+	// this needs to outlive the PPU, since the PPU's render thread feeds it frames
+	std::unique_ptr<Blaze::VideoCapture> videoCapture;
 	Blaze::PPU ppu;
 	Blaze::APU apu;
 	SDL_Texture* renderTexture = nullptr;
+	SDL_AudioDeviceID audioDevice = 0;
+	std::unique_ptr<Blaze::AudioResampler> audioResampler;
 
 	bus.ppu = &ppu;
 	bus.apu = &apu;
+	bus.updatePageTable();
 
 #ifdef _WIN32
 	HWND win32MainWindow = nullptr;
@@ -957,11 +1088,14 @@ int main(int argc, char** argv) {
 
 	setContinuousExecution(true);
 
-	bus.cpu.putCharacterHook = [&](char character) {
+	// every instrumentation policy the GUI is built with reports these (see `BLAZE_GUI_DEBUGGER` in `CMakeLists.txt`)
+	static_assert(std::is_base_of_v<Blaze::Instrumentation::Console, Blaze::Bus::Instrumentation>, "the GUI needs at least the console's instrumentation");
+
+	bus.cpu.instrumentation.putCharacter = [&](char character) {
 		Blaze::print("user-code", std::string(1, character));
 	};
 
-	bus.invalidAccess = [&](Blaze::Address address, Blaze::Byte bitSize, bool forWrite, Blaze::Address valueWhenWriting) {
+	bus.cpu.instrumentation.invalidAccess = [&](Blaze::Address address, Blaze::Byte bitSize, bool forWrite, Blaze::Address valueWhenWriting) {
 		std::string output = "Invalid " + std::to_string(bitSize) + "-bit bus access to " + Blaze::valueToHexString(address, 6, "$") + " for ";
 		if (forWrite) {
 			output += "writing " + Blaze::valueToHexString(valueWhenWriting, 6, "$");
@@ -971,8 +1105,81 @@ int main(int argc, char** argv) {
 		Blaze::printLine("bus", output);
 	};
 
-	if (argc > 1) {
-		std::string path = argv[1];
+	std::string romPath;
+	std::string capturePath;
+	std::string hashOutputPath;
+	std::string hashGoldenPath;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+
+		if (arg == "--capture" && i + 1 < argc) {
+			// `--capture <path>`: stream every rendered frame to a file (Y4M if it ends with `.y4m`, otherwise raw RGBA)
+			capturePath = argv[++i];
+		} else if (arg == "--hash-output" && i + 1 < argc) {
+			// `--hash-output <path>`: write the hashes of the framebuffer, WRAM, and VRAM at every vblank to a file
+			hashOutputPath = argv[++i];
+		} else if (arg == "--hash-golden" && i + 1 < argc) {
+			// `--hash-golden <path>`: compare those hashes against a file written by `--hash-output` and stop at the first mismatch
+			hashGoldenPath = argv[++i];
+		} else {
+			romPath = arg;
+		}
+	}
+
+	if (!capturePath.empty()) {
+		try {
+			videoCapture = std::make_unique<Blaze::VideoCapture>(capturePath, Blaze::VideoCapture::formatForPath(capturePath), Blaze::PPU::LINE_WIDTH, Blaze::PPU::FRAME_HEIGHT);
+
+		} catch (const std::runtime_error& e) {
+			Blaze::printLine("capture", e.what());
+		}
+	}
+
+	if (!hashOutputPath.empty()) {
+		Blaze::frameHashing.output.open(hashOutputPath);
+
+		if (!Blaze::frameHashing.output) {
+			Blaze::printLine("hash", "Failed to open hash output file: " + hashOutputPath);
+		} else {
+			Blaze::frameHashing.enabled = true;
+		}
+	}
+
+	if (!hashGoldenPath.empty()) {
+		std::ifstream golden(hashGoldenPath);
+
+		try {
+			if (!golden) {
+				throw std::runtime_error("failed to open golden hash file: " + hashGoldenPath);
+			}
+
+			Blaze::frameHashing.checker = std::make_unique<Blaze::FrameHashChecker>(golden);
+			Blaze::frameHashing.enabled = true;
+		} catch (const std::runtime_error& e) {
+			Blaze::printLine("hash", e.what());
+		}
+	}
+
+	if (videoCapture || Blaze::frameHashing.enabled) {
+		ppu.setFrameListener([&](const Blaze::PPU::Frame& frame) {
+			if (videoCapture) {
+				videoCapture->submit(frame.data());
+			}
+
+			if (Blaze::frameHashing.enabled) {
+				Blaze::frameHashing.framebufferHash = Blaze::Hash64::hash(frame.data(), sizeof(frame));
+			}
+		});
+	}
+
+	if (Blaze::frameHashing.enabled) {
+		// these runs are about getting through frames, not watching them
+		Blaze::emulationSpeed = 0;
+	}
+
+	if (!romPath.empty()) {
+		std::string path = romPath;
 		std::stringstream output;
 		bool romSuccessfullyLoaded = false;
 
@@ -1014,6 +1221,42 @@ int main(int argc, char** argv) {
 		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render texture: %s", SDL_GetError());
 	}
 
+	// render frames on their own thread so the CPU thread can get started on the next one.
+	// hashing needs every frame to be finished by the time its vblank starts, though.
+	if (!Blaze::frameHashing.enabled) {
+		ppu.setAsyncRendering(true);
+	}
+
+	// hashing runs don't need to be heard (and aren't paced anyways)
+	if (!Blaze::frameHashing.enabled) {
+		if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize audio: %s", SDL_GetError());
+		} else {
+			SDL_AudioSpec desired {};
+			SDL_AudioSpec obtained {};
+
+			desired.freq = Blaze::audioDeviceRate;
+			desired.format = AUDIO_S16SYS;
+			desired.channels = 2;
+			desired.samples = Blaze::audioDeviceBufferSize;
+			desired.callback = audioCallback;
+
+			audioResampler = std::make_unique<Blaze::AudioResampler>(Blaze::audioRing, Blaze::DSP::SAMPLE_RATE, desired.freq);
+			desired.userdata = audioResampler.get();
+
+			audioDevice = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+
+			if (audioDevice == 0) {
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open audio device: %s", SDL_GetError());
+			} else {
+				// the device starts out paused, so the callback can't be running yet
+				audioResampler->setOutputRate(obtained.freq);
+				Blaze::audioPacing = true;
+				SDL_PauseAudioDevice(audioDevice, 0);
+			}
+		}
+	}
+
 	// create the CPU thread
 	cpuThread = std::thread(cpuThreadMain, mainWindow);
 
@@ -1080,6 +1323,15 @@ int main(int argc, char** argv) {
 #else
 						#warning TODO
 #endif
+					} else if (event.key.keysym.sym == SDLK_TAB) {
+						// hold tab -> fast-forward
+						setEmulationSpeed(ppu, Blaze::fastForwardSpeeds[Blaze::fastForwardSpeedIndex]);
+					} else if (event.key.keysym.sym == SDLK_F7 && event.key.repeat == 0) {
+						// F7 -> change the fast-forward speed
+						Blaze::fastForwardSpeedIndex = (Blaze::fastForwardSpeedIndex + 1) % Blaze::fastForwardSpeeds.size();
+
+						auto speed = Blaze::fastForwardSpeeds[Blaze::fastForwardSpeedIndex];
+						Blaze::printLine("gui", "Fast-forward speed: " + (speed == 0 ? std::string("unthrottled") : std::to_string(speed) + "x"));
 					} else if (event.key.keysym.sym == SDLK_F5) {
 						// F5 -> continue
 #if _WIN32
@@ -1119,6 +1371,7 @@ int main(int argc, char** argv) {
 						case SDLK_RCTRL: holdingRightControl = false; break;
 						case SDLK_LSHIFT: holdingLeftShift = false; break;
 						case SDLK_RSHIFT: holdingRightShift = false; break;
+						case SDLK_TAB: setEmulationSpeed(ppu, 1); break;
 					}
 					snesKey = mapSDLToSNES(event.key.keysym.sym);
 					// update emulator state
@@ -1260,17 +1513,12 @@ int main(int argc, char** argv) {
 			static_cast<int>(windowWidth), static_cast<int>(windowHeight),
 		};
 
-		ppu.renderSurface([&](SDL_Surface* surface) {
-			SDL_Surface* destSurface = nullptr;
-			if (SDL_LockTextureToSurface(renderTexture, &rect, &destSurface) == 0) {
-				if (SDL_BlitSurface(surface, &rect, destSurface, &rect) != 0) {
-					SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to blit surface: %s", SDL_GetError());
-				}
-				SDL_UnlockTexture(renderTexture);
-			} else {
-				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to lock texture: %s", SDL_GetError());
+		// upload the latest frame straight from the PPU's buffer (if there's a new one); this never blocks the PPU
+		if (auto* frame = ppu.latestFrame()) {
+			if (SDL_UpdateTexture(renderTexture, &rect, frame->data(), static_cast<int>(Blaze::PPU::LINE_WIDTH * sizeof(uint32_t))) != 0) {
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to update texture: %s", SDL_GetError());
 			}
-		});
+		}
 
 		SDL_RenderCopy(renderer, renderTexture, &rect, &windowRect);
 		SDL_RenderPresent(renderer);
@@ -1278,11 +1526,27 @@ int main(int argc, char** argv) {
 
 	cpuThread.join();
 
+	if (audioDevice != 0) {
+		SDL_CloseAudioDevice(audioDevice);
+		Blaze::printLine("audio", "The audio ring ran dry " + std::to_string(audioResampler->underrunCount()) + " times");
+	}
+
+	if (videoCapture) {
+		// make sure the last frames make it to the capture before reporting on it
+		ppu.setAsyncRendering(false);
+		videoCapture->finish();
+		Blaze::printLine("capture", "Captured " + std::to_string(videoCapture->framesWritten()) + " frames (the queue overflowed " + std::to_string(videoCapture->overflowCount()) + " times)");
+	}
+
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyTexture(renderTexture);
 	SDL_DestroyWindow(mainWindow);
 
 	SDL_Quit();
 
+	if (Blaze::frameHashing.mismatch) {
+		return 1;
+	}
+
 	return 0;
 };
@@ -0,0 +1,158 @@
+// headless SPC player: runs a `.spc` snapshot on the APU alone, as fast as possible, and optionally writes the output to a WAV file.
+//
+// usage: blaze-spc <file.spc> [--seconds <n>] [--output <file.wav>]
+
+#include <blaze/SPC700.hpp>
+#include <blaze/SPCSnapshot.hpp>
+#include <blaze/debug.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr double DEFAULT_SECONDS = 30;
+
+// samples are collected this often (in SPC700 cycles); this has to be well under the DSP's buffering limit
+static constexpr uint64_t CHUNK_CYCLES = Blaze::SPC700::CLOCK_RATE / 100;
+
+void Blaze::clear() {
+	// noop
+};
+
+void Blaze::print(const std::string& subsystem, const std::string& message) {
+	std::fprintf(stderr, "%s", message.c_str());
+};
+
+void Blaze::printLine(const std::string& subsystem, const std::string& message) {
+	Blaze::print(subsystem, message + '\n');
+};
+
+static void writeLE(std::ofstream& file, uint32_t value, size_t byteCount) {
+	for (size_t i = 0; i < byteCount; ++i) {
+		file.put(static_cast<char>((value >> (i * 8)) & 0xff));
+	}
+};
+
+// 16-bit stereo PCM at the DSP's sample rate
+static void writeWAV(const std::string& path, const std::vector<Blaze::DSP::Sample>& samples) {
+	std::ofstream file(path, std::ios::binary);
+
+	if (!file.is_open()) {
+		throw std::runtime_error("failed to open WAV file: " + path);
+	}
+
+	constexpr uint32_t channels = 2;
+	constexpr uint32_t bytesPerSample = 2;
+	constexpr uint32_t blockAlign = channels * bytesPerSample;
+	uint32_t dataSize = static_cast<uint32_t>(samples.size() * blockAlign);
+
+	file.write("RIFF", 4);
+	writeLE(file, 36 + dataSize, 4);
+	file.write("WAVE", 4);
+
+	file.write("fmt ", 4);
+	writeLE(file, 16, 4);
+	writeLE(file, 1, 2); // PCM
+	writeLE(file, channels, 2);
+	writeLE(file, Blaze::DSP::SAMPLE_RATE, 4);
+	writeLE(file, Blaze::DSP::SAMPLE_RATE * blockAlign, 4);
+	writeLE(file, blockAlign, 2);
+	writeLE(file, bytesPerSample * 8, 2);
+
+	file.write("data", 4);
+	writeLE(file, dataSize, 4);
+
+	for (const auto& sample: samples) {
+		writeLE(file, static_cast<uint16_t>(sample.left), 2);
+		writeLE(file, static_cast<uint16_t>(sample.right), 2);
+	}
+
+	if (!file) {
+		throw std::runtime_error("failed to write WAV file: " + path);
+	}
+};
+
+int main(int argc, char** argv) {
+	std::string spcPath;
+	std::string outputPath;
+	double seconds = DEFAULT_SECONDS;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+
+		if (arg == "--seconds" && i + 1 < argc) {
+			// `--seconds <n>`: how much emulated time to run for
+			seconds = std::stod(argv[++i]);
+		} else if (arg == "--output" && i + 1 < argc) {
+			// `--output <path>`: write what was played to a WAV file
+			outputPath = argv[++i];
+		} else {
+			spcPath = arg;
+		}
+	}
+
+	if (spcPath.empty() || seconds <= 0) {
+		std::fprintf(stderr, "usage: %s <file.spc> [--seconds <n>] [--output <file.wav>]\n", argv[0]);
+		return 1;
+	}
+
+	Blaze::SPCSnapshot snapshot;
+	Blaze::SPC700 spc;
+
+	try {
+		snapshot.load(spcPath);
+	} catch (const std::exception& e) {
+		Blaze::printLine("spc", e.what());
+		return 1;
+	}
+
+	if (!snapshot.songTitle.empty() || !snapshot.gameTitle.empty()) {
+		Blaze::printLine("spc", snapshot.songTitle + " (" + snapshot.gameTitle + ")");
+	}
+
+	snapshot.restore(spc);
+
+	uint64_t totalCycles = static_cast<uint64_t>(seconds * Blaze::SPC700::CLOCK_RATE);
+	std::vector<Blaze::DSP::Sample> samples;
+	samples.reserve(totalCycles / Blaze::DSP::CYCLES_PER_SAMPLE + 1);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (uint64_t cycle = 0; cycle < totalCycles;) {
+		cycle = std::min(cycle + CHUNK_CYCLES, totalCycles);
+		spc.runUntil(cycle);
+		spc.dsp.takeSamples(samples);
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (spc.stopped) {
+		Blaze::printLine("spc", "The SPC700 stopped (SLEEP or STOP) before the end");
+	}
+
+	double samplesPerSecond = samples.size() / elapsed.count();
+	char summary[256];
+	std::snprintf(summary, sizeof(summary), "%zu samples (%.1f s) in %.3f s: %.0f samples/s, %.1fx realtime",
+		samples.size(),
+		static_cast<double>(samples.size()) / Blaze::DSP::SAMPLE_RATE,
+		elapsed.count(),
+		samplesPerSecond,
+		samplesPerSecond / Blaze::DSP::SAMPLE_RATE
+	);
+	Blaze::printLine("spc", summary);
+
+	if (!outputPath.empty()) {
+		try {
+			writeWAV(outputPath, samples);
+		} catch (const std::exception& e) {
+			Blaze::printLine("spc", e.what());
+			return 1;
+		}
+	}
+
+	return 0;
+};
@@ -0,0 +1,114 @@
+#include <blaze/AudioRing.hpp>
+#include <blaze/AudioResampler.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace Blaze;
+
+static std::vector<AudioRing::Sample> makeSamples(size_t count, int16_t first) {
+	std::vector<AudioRing::Sample> samples(count);
+	for (size_t i = 0; i < count; ++i) {
+		samples[i].left = static_cast<int16_t>(first + i);
+		samples[i].right = static_cast<int16_t>(-(first + static_cast<int>(i)));
+	}
+	return samples;
+};
+
+TEST_CASE("Audio ring", "[audio]") {
+	AudioRing ring(100);
+
+	SECTION("Capacity is rounded up to a power of 2") {
+		REQUIRE(ring.capacity() == 128);
+	}
+
+	SECTION("Samples come out in order across the wrap-around") {
+		std::vector<AudioRing::Sample> output(128);
+
+		for (int16_t round = 0; round < 10; ++round) {
+			auto input = makeSamples(50, round * 50);
+			REQUIRE(ring.push(input.data(), input.size()) == input.size());
+			REQUIRE(ring.size() == 50);
+			REQUIRE(ring.pop(output.data(), output.size()) == 50);
+
+			for (size_t i = 0; i < input.size(); ++i) {
+				REQUIRE(output[i].left == input[i].left);
+				REQUIRE(output[i].right == input[i].right);
+			}
+		}
+	}
+
+	SECTION("Pushing into a full ring drops the rest") {
+		auto input = makeSamples(200, 0);
+		REQUIRE(ring.push(input.data(), input.size()) == 128);
+		REQUIRE(ring.push(input.data(), input.size()) == 0);
+	}
+
+	SECTION("A producer and a consumer can run concurrently") {
+		constexpr int16_t total = 20000;
+		std::vector<AudioRing::Sample> received;
+
+		std::thread producer([&]() {
+			auto input = makeSamples(total, 0);
+			size_t sent = 0;
+			while (sent < input.size()) {
+				sent += ring.push(input.data() + sent, std::min<size_t>(37, input.size() - sent));
+			}
+		});
+
+		std::vector<AudioRing::Sample> chunk(53);
+		while (received.size() < total) {
+			size_t count = ring.pop(chunk.data(), chunk.size());
+			received.insert(received.end(), chunk.begin(), chunk.begin() + count);
+		}
+
+		producer.join();
+
+		for (int16_t i = 0; i < total; ++i) {
+			REQUIRE(received[i].left == i);
+		}
+	}
+}
+
+TEST_CASE("Audio resampling", "[audio]") {
+	AudioRing ring(4096);
+
+	SECTION("A half-full ring is resampled at the nominal ratio") {
+		auto input = makeSamples(2048, 0);
+		ring.push(input.data(), input.size());
+
+		// 32 kHz to 48 kHz: 3 output samples for every 2 input samples
+		AudioResampler resampler(ring, 32000, 48000);
+		std::vector<AudioRing::Sample> output(300);
+		resampler.render(output.data(), output.size());
+
+		REQUIRE(ring.size() > 2048 - 256 - 200);
+		REQUIRE(resampler.underrunCount() == 0);
+
+		// the input is a ramp, so the output should be one too (at 2/3 the slope)
+		for (size_t i = 10; i < output.size(); ++i) {
+			REQUIRE(output[i].left - output[i - 3].left == 2);
+		}
+	}
+
+	SECTION("Fuller rings are drained faster") {
+		auto input = makeSamples(4000, 0);
+		ring.push(input.data(), input.size());
+
+		AudioResampler resampler(ring, 32000, 32000);
+		std::vector<AudioRing::Sample> output(1000);
+		resampler.render(output.data(), output.size());
+
+		// at the same rate, these would be 1000 samples apart
+		REQUIRE(output.back().left - output.front().left > 999);
+	}
+
+	SECTION("Running dry is counted") {
+		AudioResampler resampler(ring, 32000, 48000);
+		std::vector<AudioRing::Sample> output(16);
+		resampler.render(output.data(), output.size());
+		REQUIRE(resampler.underrunCount() == 1);
+	}
+}
@@ -7,8 +7,8 @@
 
 namespace Blaze::Testing {
 	// a testing mock replacement for the Bus struct to test memory access
-	// at arbitrary indices
-	class Bus: public Blaze::BusInterface {
+	// at arbitrary indices. the CPU tests use `BasicCPU<Testing::Bus>`.
+	class Bus {
 	public:
 		using ReadHook = std::function<Address(Address address, Byte bitSize)>;
 		using WriteHook = std::function<void(Address address, Address value, Byte bitSize)>;
@@ -25,22 +25,22 @@ namespace Blaze::Testing {
 			_write(std::move(write))
 			{};
 
-		void write(Address addr, Byte data) override {
+		void write(Address addr, Byte data) {
 			_write(addr, data, 8);
 		};
-		void write(Address addr, Word data) override {
+		void write(Address addr, Word data) {
 			_write(addr, data, 16);
 		};
-		void write(Address addr, Address data) override {
+		void write(Address addr, Address data) {
 			_write(addr, data, 24);
 		};
-		Byte read8(Address addr) override {
+		Byte read8(Address addr) {
 			return _read(addr, 8);
 		};
-		Word read16(Address addr) override {
+		Word read16(Address addr) {
 			return _read(addr, 16);
 		};
-		Address read24(Address addr) override {
+		Address read24(Address addr) {
 			return _read(addr, 24);
 		};
 	};
@@ -59,7 +59,8 @@ namespace Blaze::Testing {
 			{};
 	};
 
-	class PreconfiguredBus: public Blaze::BusInterface {
+	// a mock bus that expects a given list of accesses
+	class PreconfiguredBus: public Bus {
 	private:
 		bool _ordered;
 		std::vector<BusAccess> _accesses;
@@ -119,27 +120,19 @@ namespace Blaze::Testing {
 		PreconfiguredBus(bool ordered, std::vector<BusAccess> accesses):
 			_ordered(ordered),
 			_accesses(std::move(accesses))
-			{};
-
-		void write(Address addr, Byte data) override {
-			testWrite(addr, data, 8);
-		};
-		void write(Address addr, Word data) override {
-			testWrite(addr, data, 16);
-		};
-		void write(Address addr, Address data) override {
-			testWrite(addr, data, 24);
-		};
-		Byte read8(Address addr) override {
-			return testRead(addr, 8);
-		};
-		Word read16(Address addr) override {
-			return testRead(addr, 16);
-		};
-		Address read24(Address addr) override {
-			return testRead(addr, 24);
+		{
+			_read = [this](Address address, Byte bitSize) {
+				return testRead(address, bitSize);
+			};
+			_write = [this](Address address, Address value, Byte bitSize) {
+				testWrite(address, value, bitSize);
+			};
 		};
 
+		// the hooks point back at this bus
+		PreconfiguredBus(const PreconfiguredBus&) = delete;
+		PreconfiguredBus& operator=(const PreconfiguredBus&) = delete;
+
 		void finalize() {
 			if (_ordered && _index != _accesses.size()) {
 				FAIL("Not all expected bus accesses were completed before finalization");
@@ -1,9 +1,13 @@
 #include <blaze/color.hpp>
+#include <blaze/ColorMath.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/generators/catch_generators_adapters.hpp>
 #include <catch2/generators/catch_generators_random.hpp>
 
+#include <array>
+#include <random>
+
 TEST_CASE("Color", "[color]") {
 	auto gen = GENERATE(take(10, chunk(4, random(0, 255))));
 
@@ -22,3 +26,93 @@ TEST_CASE("Color", "[color]") {
 		REQUIRE(color.a == gen[3]);
 	}
 }
+
+TEST_CASE("Color table", "[color]") {
+	Blaze::ColorTable table;
+
+	SECTION("Full brightness covers the full range") {
+		REQUIRE(table[0x0000] == 0x000000ff);
+		REQUIRE(table[0x7fff] == 0xffffffff);
+		REQUIRE(table[0x001f] == 0xff0000ff);
+		REQUIRE(table[0x03e0] == 0x00ff00ff);
+		REQUIRE(table[0x7c00] == 0x0000ffff);
+
+		// the unused top bit is ignored
+		REQUIRE(table[0xffff] == table[0x7fff]);
+	}
+
+	SECTION("Brightness scales every component") {
+		REQUIRE_FALSE(table.setBrightness(Blaze::ColorTable::MAX_BRIGHTNESS));
+
+		REQUIRE(table.setBrightness(0));
+		REQUIRE(table[0x7fff] == 0x000000ff);
+
+		REQUIRE(table.setBrightness(5));
+		REQUIRE(table[0x7fff] == 0x555555ff);
+		REQUIRE(table[0x7fff] == Blaze::ColorTable::convert(0x7fff, 5).toRGBA8888());
+	}
+}
+
+TEST_CASE("Color math", "[color]") {
+	constexpr uint32_t ON = 0xffffffff;
+	constexpr uint32_t OFF = 0;
+
+	SECTION("Known values") {
+		std::array<uint32_t, 4> main   = { 0x804020ff, 0x804020ff, 0x804020ff, 0x804020ff };
+		std::array<uint32_t, 4> addend = { 0x90ff10ff, 0x90ff10ff, 0x90ff10ff, 0x90ff10ff };
+		std::array<uint32_t, 4> enable = { ON, ON, ON, OFF };
+		std::array<uint32_t, 4> half   = { OFF, ON, OFF, ON };
+
+		auto added = main;
+		Blaze::ColorMath::apply(added.data(), addend.data(), enable.data(), half.data(), added.size(), false);
+		REQUIRE(added[0] == 0xffff30ff);
+		REQUIRE(added[1] == 0x889f18ff);
+		REQUIRE(added[3] == main[3]);
+
+		auto subtracted = main;
+		Blaze::ColorMath::apply(subtracted.data(), addend.data(), enable.data(), half.data(), subtracted.size(), true);
+		REQUIRE(subtracted[0] == 0x000010ff);
+		REQUIRE(subtracted[1] == 0x000008ff);
+		REQUIRE(subtracted[3] == main[3]);
+	}
+
+	SECTION("Brightness scales the result the same way the color table does") {
+		Blaze::ColorTable fullBrightness;
+
+		for (std::uint8_t brightness = 0; brightness <= Blaze::ColorTable::MAX_BRIGHTNESS; ++brightness) {
+			Blaze::ColorTable table(brightness);
+
+			for (std::uint16_t bgr555: { 0x0000, 0x001f, 0x03e0, 0x7c00, 0x1234, 0x7fff }) {
+				auto pixel = fullBrightness[bgr555];
+				Blaze::ColorMath::applyBrightness(&pixel, 1, brightness);
+				REQUIRE(pixel == table[bgr555]);
+			}
+		}
+	}
+
+	SECTION("The vectorized path matches the scalar one") {
+		constexpr size_t PIXELS = 256 + 7;
+		std::mt19937 rng(1234);
+		std::array<uint32_t, PIXELS> main;
+		std::array<uint32_t, PIXELS> addend;
+		std::array<uint32_t, PIXELS> enable;
+		std::array<uint32_t, PIXELS> half;
+
+		for (size_t i = 0; i < PIXELS; ++i) {
+			main[i] = rng() | 0xff;
+			addend[i] = rng() | 0xff;
+			enable[i] = (rng() % 4 != 0) ? ON : OFF;
+			half[i] = (rng() % 2 != 0) ? ON : OFF;
+		}
+
+		for (bool subtract: { false, true }) {
+			auto vectorized = main;
+			auto scalar = main;
+
+			Blaze::ColorMath::apply(vectorized.data(), addend.data(), enable.data(), half.data(), PIXELS, subtract);
+			Blaze::ColorMath::applyScalar(scalar.data(), addend.data(), enable.data(), half.data(), PIXELS, subtract);
+
+			REQUIRE(vectorized == scalar);
+		}
+	}
+}
@@ -7,9 +7,15 @@
 #include <sstream>
 #include <blaze/util.hpp>
 
+#include <blaze/CPUImpl.hpp>
+
 #include "bus-mock.hpp"
 
 using namespace Blaze;
+
+// the CPU under test talks to a mock bus instead of a real one
+template struct Blaze::BasicCPU<Blaze::Testing::Bus>;
+using TestCPU = BasicCPU<Testing::Bus>;
 using Instruction = Blaze::CPU::Instruction;
 using Opcode = Blaze::CPU::Opcode;
 using AddressingMode = Blaze::CPU::AddressingMode;
@@ -274,11 +280,11 @@ static constexpr std::array<Instruction, 256> OPCODE_INFO {
 	/* FF */ Instruction(Opcode::SBC, 4, 0, AddressingMode::AbsoluteLongIndexedX),
 };
 
-static void testInstruction(CPU::Opcode opcode, AddressingMode addressingMode, std::function<void(CPU&, std::vector<Testing::BusAccess>&)> addExpectedBusAccesses, std::function<void(CPU&)> setup, std::function<void(CPU&)> test) {
+static void testInstruction(CPU::Opcode opcode, AddressingMode addressingMode, std::function<void(TestCPU&, std::vector<Testing::BusAccess>&)> addExpectedBusAccesses, std::function<void(TestCPU&)> setup, std::function<void(TestCPU&)> test) {
 	static constexpr Address INSTRUCTION_ADDRESS = 0x8000;
 	static constexpr Word STACK_POINTER = 0x01f0;
 
-	CPU cpu;
+	TestCPU cpu;
 	Byte rawOpcode = 0;
 	Address pcWhileExecuting = INSTRUCTION_ADDRESS;
 	std::vector<Testing::BusAccess> busAccesses;
@@ -310,7 +316,7 @@ static void testInstruction(CPU::Opcode opcode, AddressingMode addressingMode, s
 	test(cpu);
 };
 
-static void testInstructionWithOperand(CPU::Opcode opcode, Byte operandBitSize, Address operand, const std::initializer_list<AddressingMode>& addressingModes, std::function<void(CPU&, std::vector<Testing::BusAccess>&)> addExpectedBusAccesses, std::function<void(CPU&)> setup, std::function<void(CPU&)> test) {
+static void testInstructionWithOperand(CPU::Opcode opcode, Byte operandBitSize, Address operand, const std::initializer_list<AddressingMode>& addressingModes, std::function<void(TestCPU&, std::vector<Testing::BusAccess>&)> addExpectedBusAccesses, std::function<void(TestCPU&)> setup, std::function<void(TestCPU&)> test) {
 	static constexpr Address INSTRUCTION_ADDRESS = 0x8000;
 	static constexpr Address OPERAND_ADDRESS = 0x8100;
 	static constexpr Address INDIRECT_OPERAND_ADDRESS = 0x8200;
@@ -324,7 +330,7 @@ static void testInstructionWithOperand(CPU::Opcode opcode, Byte operandBitSize,
 
 	for (const auto& addressingMode: addressingModes) {
 		SECTION(CPU::ADDRESSING_MODE_NAMES[static_cast<uint8_t>(addressingMode)]) {
-			CPU cpu;
+			TestCPU cpu;
 			Byte rawOpcode = 0;
 			Address pcWhileExecuting = INSTRUCTION_ADDRESS;
 			std::vector<Testing::BusAccess> busAccesses;
@@ -520,8 +526,8 @@ static void testInstructionWithOperand(CPU::Opcode opcode, Byte operandBitSize,
 	}
 };
 
-static void noopTestStep(CPU& cpu) {};
-static void noopAddBusAccesses(CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {};
+static void noopTestStep(TestCPU& cpu) {};
+static void noopAddBusAccesses(TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {};
 
 TEST_CASE("Instruction decoding", "[cpu]") {
 	Byte opcodeByte;
@@ -584,13 +590,13 @@ TEST_CASE("ADC", "[cpu][instruction]") {
 				AddressingMode::AbsoluteLongIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 				cpu.setFlag(CPU::flags::c, hasCarry);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == result);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -609,17 +615,17 @@ TEST_CASE("PHA", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHA, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP - (memoryAndAccumulatorAre8Bit ? 0 : 1), memoryAndAccumulatorAre8Bit ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				// the store is already verified by the bus access list
 				//
 				// we just need to check the stack pointer here
@@ -637,16 +643,16 @@ TEST_CASE("PLA", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PLA, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(false, initialSP + 1, memoryAndAccumulatorAre8Bit ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == val);
 				REQUIRE(cpu.SP == initialSP + (memoryAndAccumulatorAre8Bit ? 1 : 2));
 			}
@@ -662,16 +668,16 @@ TEST_CASE("PHD", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHD, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP - (usingEmulatorMode ? 0 : 1), usingEmulatorMode ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.DR = val;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 	
 				REQUIRE(cpu.SP == initialSP - (usingEmulatorMode ? 1 : 2));
 			}
@@ -688,15 +694,15 @@ TEST_CASE("PLD", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PLD, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(false, initialSP + 1, usingEmulatorMode ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.DR == val);
 				REQUIRE(cpu.SP == initialSP + (usingEmulatorMode ? 1 : 2));
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
@@ -714,17 +720,17 @@ TEST_CASE("PHX", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHX, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP - (indexRegistersAre8Bit ? 0 : 1), indexRegistersAre8Bit ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.X.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::x,indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.SP == initialSP - (indexRegistersAre8Bit ? 1 : 2));
 			}
 		);
@@ -740,16 +746,16 @@ TEST_CASE("PLX", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PLX, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(false, initialSP + 1,indexRegistersAre8Bit ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == val);
 				REQUIRE(cpu.SP == initialSP + (indexRegistersAre8Bit ? 1 : 2));
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
@@ -767,17 +773,17 @@ TEST_CASE("PHY", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHY, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP - (indexRegistersAre8Bit ? 0 : 1), indexRegistersAre8Bit ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.Y.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::x,indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.SP == initialSP - (indexRegistersAre8Bit ? 1 : 2));
 			}
 		);
@@ -793,16 +799,16 @@ TEST_CASE("PLY", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PLY, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(false, initialSP + 1,indexRegistersAre8Bit ? 8 : 16, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.Y.load() == val);
 				REQUIRE(cpu.SP == initialSP + (indexRegistersAre8Bit ? 1 : 2));
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
@@ -819,16 +825,16 @@ TEST_CASE("PHB", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHB, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP, 8, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.DBR = val;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.SP == initialSP - 1);
 			}
 		);
@@ -843,15 +849,15 @@ TEST_CASE("PLB", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PLB, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(false, initialSP + 1, 8, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.DBR == val);
 				REQUIRE(cpu.SP == initialSP + 1);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
@@ -868,16 +874,16 @@ TEST_CASE("PHK", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHK, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP, 8, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.PBR = val;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.SP == initialSP - 1);
 			}
 		);
@@ -891,16 +897,16 @@ TEST_CASE("PHP", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PHP, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(true, initialSP, 8, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.P = val;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.SP == initialSP - 1);
 			}
 		);
@@ -914,17 +920,17 @@ TEST_CASE("PLP", "[cpu][instruction]") {
 		Word initialSP = 0;
 
 		testInstruction(Opcode::PLP, AddressingMode::Stack,
-			/*addExpectedBusAccesses=*/[&](CPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
+			/*addExpectedBusAccesses=*/[&](TestCPU& cpu, std::vector<Testing::BusAccess>& busAccesses) {
 				initialSP = cpu.SP;
 
 				busAccesses.emplace_back(false, initialSP + 1, 8, val);
 			},
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::m, usingEmulatorMode);
 				cpu.setFlag(CPU::flags::x, usingEmulatorMode);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				auto expectedVal = val | (usingEmulatorMode ? (CPU::flags::m | CPU::flags::x) : 0);
 				REQUIRE(cpu.P == expectedVal);
 				REQUIRE(cpu.SP == initialSP + 1);
@@ -940,11 +946,11 @@ TEST_CASE("TCS", "[cpu][instruction]") {
 	DYNAMIC_SECTION((memoryAndAccumulatorAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TCS, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.SP == cpu.A.forceLoadFull());
 			}
 		);
@@ -958,11 +964,11 @@ TEST_CASE("TSC", "[cpu][instruction]") {
 	DYNAMIC_SECTION((memoryAndAccumulatorAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TSC, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.SP = val;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.forceLoadFull() == cpu.SP);
 			}
 		);
@@ -976,11 +982,11 @@ TEST_CASE("TAX", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TAX, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == cpu.A.load());
 			}
 		);
@@ -994,11 +1000,11 @@ TEST_CASE("TXA", "[cpu][instruction]") {
 	DYNAMIC_SECTION((memoryAndAccumulatorAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TXA, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.X.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == cpu.X.load());
 			}
 		);
@@ -1012,11 +1018,11 @@ TEST_CASE("TAY", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TAY, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.Y.load() == cpu.A.load());
 			}
 		);
@@ -1030,11 +1036,11 @@ TEST_CASE("TYA", "[cpu][instruction]") {
 	DYNAMIC_SECTION((memoryAndAccumulatorAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TYA, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.Y.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == cpu.Y.load());
 			}
 		);
@@ -1048,11 +1054,11 @@ TEST_CASE("TXY", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TXY, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.X.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.Y.load() == cpu.X.load());
 			}
 		);
@@ -1066,11 +1072,11 @@ TEST_CASE("TYX", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TYX, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.Y.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == cpu.Y.load());
 			}
 		);
@@ -1084,12 +1090,12 @@ TEST_CASE("TSX", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TSX, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.SP = val;
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == cpu.SP);
 			}
 		);
@@ -1103,11 +1109,11 @@ TEST_CASE("TXS", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TXS, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.X.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				auto expectedVal = cpu.X.load() | (usingEmulatorMode ? 0x0100 : 0);
 				REQUIRE(cpu.SP == expectedVal);
 			}
@@ -1122,11 +1128,11 @@ TEST_CASE("TDC", "[cpu][instruction]") {
 	DYNAMIC_SECTION((memoryAndAccumulatorAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TDC, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.DR = val;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.forceLoadFull() == cpu.DR);
 			}
 		);
@@ -1140,11 +1146,11 @@ TEST_CASE("TCD", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::TCD, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.A.forceStoreFull(val);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.DR == cpu.A.forceLoadFull());	
 			}
 		);
@@ -1179,12 +1185,12 @@ TEST_CASE("AND", "[cpu][instruction]") {
 				AddressingMode::AbsoluteLongIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == result);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1221,12 +1227,12 @@ TEST_CASE("ORA", "[cpu][instruction]") {
 				AddressingMode::AbsoluteLongIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == result);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1263,12 +1269,12 @@ TEST_CASE("EOR", "[cpu][instruction]") {
 				AddressingMode::AbsoluteLongIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == result);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1307,12 +1313,12 @@ TEST_CASE("CMP", "[cpu][instruction][!mayfail]") {
 				AddressingMode::AbsoluteLongIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
 				REQUIRE(cpu.getFlag(CPU::flags::c) == resultHasCarry);
@@ -1347,11 +1353,11 @@ TEST_CASE("LDA", "[cpu][instruction]") {
 				AddressingMode::AbsoluteLongIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == val);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1376,11 +1382,11 @@ TEST_CASE("LDX", "[cpu][instruction]") {
 				AddressingMode::AbsoluteIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == val);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1405,11 +1411,11 @@ TEST_CASE("LDY", "[cpu][instruction]") {
 				AddressingMode::AbsoluteIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.Y.load() == val);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1435,12 +1441,12 @@ TEST_CASE("CPX", "[cpu][instruction]") {
 				AddressingMode::Absolute,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.X.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
 				REQUIRE(cpu.getFlag(CPU::flags::c) == resultHasCarry);
@@ -1466,12 +1472,12 @@ TEST_CASE("CPY", "[cpu][instruction]") {
 				AddressingMode::Absolute,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.Y.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
 				REQUIRE(cpu.getFlag(CPU::flags::c) == resultHasCarry);
@@ -1499,12 +1505,12 @@ TEST_CASE("BIT", "[cpu][instruction]") {
 				AddressingMode::AbsoluteIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
 				REQUIRE(cpu.getFlag(CPU::flags::v) == resultHasOverflow);
@@ -1532,12 +1538,12 @@ TEST_CASE("INC", "[cpu][instruction][!mayfail]") {
 				AddressingMode::AbsoluteIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == result);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1564,13 +1570,13 @@ TEST_CASE("DEC", "[cpu][instruction][!mayfail]") {
 				AddressingMode::AbsoluteIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.A.load() == result);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
 				REQUIRE(cpu.getFlag(CPU::flags::n) == resultIsNegative);
@@ -1587,12 +1593,12 @@ TEST_CASE("INX", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::INX, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.X.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == result);
 			}
 		);
@@ -1607,12 +1613,12 @@ TEST_CASE("INY", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::INY, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.Y.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.Y.load() == result);
 			}
 		);
@@ -1627,12 +1633,12 @@ TEST_CASE("DEX", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::DEX, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.X.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.X.load() == result);
 			}
 		);
@@ -1647,12 +1653,12 @@ TEST_CASE("DEY", "[cpu][instruction]") {
 	DYNAMIC_SECTION((indexRegistersAre8Bit ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::DEY, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.Y.forceStoreFull(val);
 				cpu.setFlag(CPU::flags::x, indexRegistersAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.Y.load() == result);
 			}
 		);
@@ -1665,11 +1671,11 @@ TEST_CASE("CLV", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::CLV, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::v, false);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::v) == false);
 			}
 		);
@@ -1682,11 +1688,11 @@ TEST_CASE("CLC", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::CLC, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::c, false);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::c) == false);
 			}
 		);
@@ -1699,11 +1705,11 @@ TEST_CASE("CLI", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::CLI, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::i, false);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::i) == false);
 			}
 		);
@@ -1716,11 +1722,11 @@ TEST_CASE("CLD", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::CLD, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::d, false);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::d) == false);
 			}
 		);
@@ -1733,11 +1739,11 @@ TEST_CASE("SEC", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::SEC, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::c, true);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::c) == true);
 			}
 		);
@@ -1750,11 +1756,11 @@ TEST_CASE("SED", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::SED, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::d, true);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::d) == true);
 			}
 		);
@@ -1767,11 +1773,11 @@ TEST_CASE("SEI", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::SEI, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.setFlag(CPU::flags::i, true);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.getFlag(CPU::flags::i) == true);
 			}
 		);
@@ -1790,7 +1796,7 @@ TEST_CASE("REP", "[cpu][instruction]") {
 			AddressingMode::Immediate,
 		},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.P = valP;
 				if (usingEmulatorMode) {
@@ -1798,7 +1804,7 @@ TEST_CASE("REP", "[cpu][instruction]") {
 					cpu.setFlag(CPU::flags::x, true);
 				}
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				auto expectedVal = result | (usingEmulatorMode ? (CPU::flags::m | CPU::flags::x) : 0);
 				REQUIRE(cpu.P == expectedVal);
 			}
@@ -1818,11 +1824,11 @@ TEST_CASE("SEP", "[cpu][instruction]") {
 			AddressingMode::Immediate,
 		},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.P = valP;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.P == result);
 			}
 		);
@@ -1844,13 +1850,13 @@ TEST_CASE("TRB", "[cpu][instruction][!mayfail]") {
 				AddressingMode::Absolute,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 				
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				auto expectedVal = rhs & ~cpu.A.load();
 				REQUIRE(expectedVal == finalResult);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
@@ -1874,13 +1880,13 @@ TEST_CASE("TSB", "[cpu][instruction][!mayfail]") {
 				AddressingMode::Absolute,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.A.forceStoreFull(lhs);
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 				
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				auto expectedVal = rhs | cpu.A.load();
 				REQUIRE(expectedVal == finalResult);
 				REQUIRE(cpu.getFlag(CPU::flags::z) == resultIsZero);
@@ -1902,11 +1908,11 @@ TEST_CASE("STZ", "[cpu][instruction][!mayfail]") {
 				AddressingMode::AbsoluteIndexedX,
 			},
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = 0;
 				cpu.setFlag(CPU::flags::m, memoryAndAccumulatorAre8Bit);
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 			REQUIRE(rhs == 0);	
 			}
 		);
@@ -1919,11 +1925,11 @@ TEST_CASE("STP", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::STP, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 				cpu.stopped = false;
 			},
-			/*test=*/[&](CPU& cpu) {
+			/*test=*/[&](TestCPU& cpu) {
 				REQUIRE(cpu.stopped);	
 			}
 		);
@@ -1936,10 +1942,10 @@ TEST_CASE("NOP", "[cpu][instruction]") {
 	DYNAMIC_SECTION((usingEmulatorMode ? 8 : 16) << "-bit") {
 		testInstruction(Opcode::NOP, AddressingMode::Implied,
 			/*addExpectedBusAccesses=*/noopAddBusAccesses,
-			/*setup=*/[&](CPU& cpu) {
+			/*setup=*/[&](TestCPU& cpu) {
 				cpu.e = usingEmulatorMode ? 1 : 0;
 			},
-			/*test=*/[&](CPU& cpu) {}
+			/*test=*/[&](TestCPU& cpu) {}
 		);
 	}
 }
@@ -0,0 +1,123 @@
+#include <blaze/DSP.hpp>
+#include <blaze/SPC700.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace Blaze;
+
+TEST_CASE("DSP kernels", "[dsp]") {
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<int> sample(-32768, 32767);
+	std::uniform_int_distribution<int> coefficient(-128, 127);
+	std::uniform_int_distribution<int> mask(0, 255);
+
+	SECTION("The vector FIR filter matches the scalar one") {
+		for (size_t i = 0; i < 1000; ++i) {
+			std::array<int16_t, DSP::FIR_TAPS> history;
+			std::array<int16_t, DSP::FIR_TAPS> coefficients;
+
+			for (size_t tap = 0; tap < DSP::FIR_TAPS; ++tap) {
+				// the echo history holds 15-bit samples
+				history[tap] = sample(random) >> 1;
+				coefficients[tap] = coefficient(random);
+			}
+
+			REQUIRE(DSP::fir(history.data(), coefficients.data()) == DSP::firScalar(history.data(), coefficients.data()));
+		}
+	}
+
+	SECTION("The vector mix matches the scalar one") {
+		for (size_t i = 0; i < 1000; ++i) {
+			std::array<int16_t, DSP::VOICE_COUNT> outputs;
+			std::array<int16_t, DSP::VOICE_COUNT> volumes;
+
+			// quieter mixes don't overflow, so mix both quiet and loud ones to cover both paths
+			int scale = (i % 2 == 0) ? 1 : 16;
+
+			for (size_t voice = 0; voice < DSP::VOICE_COUNT; ++voice) {
+				outputs[voice] = sample(random) / scale;
+				volumes[voice] = coefficient(random);
+			}
+
+			Byte enabled = mask(random);
+			REQUIRE(DSP::mix(outputs.data(), volumes.data(), enabled) == DSP::mixScalar(outputs.data(), volumes.data(), enabled));
+		}
+
+		// the running total is clamped after each voice, so the order matters
+		std::array<int16_t, DSP::VOICE_COUNT> outputs { 32000, 32000, -32000, 0, 0, 0, 0, 0 };
+		std::array<int16_t, DSP::VOICE_COUNT> volumes { 127, 127, 127, 0, 0, 0, 0, 0 };
+		REQUIRE(DSP::mix(outputs.data(), volumes.data(), 0xff) == 32767 - ((32000 * 127) >> 7));
+	}
+}
+
+TEST_CASE("DSP voices", "[dsp]") {
+	SPC700 spc;
+
+	auto writeRegister = [&](Byte address, Byte value) {
+		spc.write(0xf2, address);
+		spc.write(0xf3, value);
+	};
+
+	auto run = [&](size_t samples) {
+		std::vector<DSP::Sample> output;
+		for (size_t i = 0; i < samples; ++i) {
+			spc.dsp.generateSample(spc.aram);
+		}
+		spc.dsp.takeSamples(output);
+		return output;
+	};
+
+	// the sample directory is at $0200, and sample 0 is a single looping block at $0300
+	spc.write(0x0200, 0x00);
+	spc.write(0x0201, 0x03);
+	spc.write(0x0202, 0x00);
+	spc.write(0x0203, 0x03);
+
+	// shift 12, filter 0, loop + end
+	spc.write(0x0300, 0xc3);
+	for (Word address = 0x0301; address < 0x0309; ++address) {
+		spc.write(address, 0x77);
+	}
+
+	writeRegister(0x5d, 0x02); // DIR
+	writeRegister(0x6c, 0x20); // FLG: no reset, unmuted, echo writes disabled
+	writeRegister(0x0c, 0x7f); // MVOLL
+	writeRegister(0x1c, 0x7f); // MVOLR
+	writeRegister(0x00, 0x40); // VOLL
+	writeRegister(0x01, 0x40); // VOLR
+	writeRegister(0x02, 0x00); // PITCHL
+	writeRegister(0x03, 0x10); // PITCHH: one sample per sample
+	writeRegister(0x04, 0x00); // SRCN
+	writeRegister(0x05, 0x8f); // ADSR1: ADSR, fastest attack
+	writeRegister(0x06, 0xe0); // ADSR2: sustain at the top
+	writeRegister(0x4c, 0x01); // KON
+
+	SECTION("A keyed on voice plays its sample") {
+		auto output = run(64);
+
+		REQUIRE(output.size() == 64);
+		REQUIRE(output.back().left > 0);
+		REQUIRE(output.back().left == output.back().right);
+
+		spc.write(0xf2, 0x7c);
+		REQUIRE((spc.read(0xf3) & 0x01) != 0); // ENDX: the end of the sample was reached
+
+		spc.write(0xf2, 0x08);
+		REQUIRE(spc.read(0xf3) == 0x7f); // ENVX
+	}
+
+	SECTION("Changing the sample in ARAM is picked up") {
+		run(64);
+
+		for (Word address = 0x0301; address < 0x0309; ++address) {
+			spc.write(address, 0x00);
+		}
+
+		auto output = run(64);
+		REQUIRE(output.back().left == 0);
+		REQUIRE(output.back().right == 0);
+	}
+}
@@ -0,0 +1,77 @@
+#include <blaze/hash.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Blaze;
+
+TEST_CASE("64-bit hash", "[hash]") {
+	SECTION("Known values") {
+		REQUIRE(Hash64::hash("", 0) == 0xef46db3751d8e999ull);
+		REQUIRE(Hash64::hash("abc", 3) == 0x44bc2cf5ad770999ull);
+
+		std::string longer = "Nobody inspects the spammish repetition";
+		REQUIRE(Hash64::hash(longer.data(), longer.size()) == 0xfbcea83c8a378bf1ull);
+	}
+
+	SECTION("Hashing in pieces matches hashing all at once") {
+		std::vector<uint8_t> data(1000);
+		for (size_t i = 0; i < data.size(); ++i) {
+			data[i] = static_cast<uint8_t>((i * 37) ^ (i >> 3));
+		}
+
+		auto expected = Hash64::hash(data.data(), data.size(), 1234);
+
+		for (size_t pieceSize: { 1, 3, 31, 32, 33, 100 }) {
+			Hash64 hasher(1234);
+
+			for (size_t offset = 0; offset < data.size(); offset += pieceSize) {
+				hasher.update(data.data() + offset, std::min(pieceSize, data.size() - offset));
+			}
+
+			REQUIRE(hasher.digest() == expected);
+		}
+	}
+}
+
+TEST_CASE("Frame hash checking", "[hash]") {
+	FrameHashes first { 0, 0x0123456789abcdefull, 1, 2 };
+	FrameHashes second { 1, 3, 0xfedcba9876543210ull, 4 };
+
+	SECTION("Lines round-trip") {
+		FrameHashes parsed;
+		REQUIRE(FrameHashes::parse(second.toString(), parsed));
+		REQUIRE(parsed == second);
+		REQUIRE_FALSE(FrameHashes::parse("1 2 3", parsed));
+		REQUIRE_FALSE(FrameHashes::parse("1 2 3 4 5", parsed));
+	}
+
+	SECTION("Checking stops at the first mismatch") {
+		std::istringstream golden(first.toString() + "\n" + second.toString() + "\n");
+		FrameHashChecker checker(golden);
+
+		auto wrong = second;
+		wrong.vram = 5;
+
+		REQUIRE(checker.check(first));
+		REQUIRE_FALSE(checker.check(wrong));
+		REQUIRE(checker.failed());
+		REQUIRE(checker.expected() == second);
+
+		// once failed, it stays failed
+		REQUIRE_FALSE(checker.check(second));
+	}
+
+	SECTION("Frames past the end of the golden file pass") {
+		std::istringstream golden(first.toString() + "\n");
+		FrameHashChecker checker(golden);
+
+		REQUIRE(checker.check(first));
+		REQUIRE(checker.finished());
+		REQUIRE(checker.check(second));
+		REQUIRE_FALSE(checker.failed());
+	}
+}
@@ -0,0 +1,96 @@
+#include <blaze/Bus.hpp>
+#include <blaze/IdleLoopDetector.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+using namespace Blaze;
+
+// without a ROM, the CPU starts executing at $00:0000, which is mirrored from RAM
+static void loadProgram(Bus& bus, const std::vector<Byte>& program) {
+	for (Address i = 0; i < program.size(); ++i) {
+		bus.ram.write(i, 8, program[i]);
+	}
+};
+
+// executes instructions until the detector says the CPU is idle, returning how many instructions that took
+static size_t runUntilIdle(Bus& bus, IdleLoopDetector& detector, size_t limit = 100) {
+	for (size_t i = 0; i < limit; ++i) {
+		bus.cpu.execute();
+
+		if (detector.check(bus)) {
+			return i + 1;
+		}
+	}
+
+	return 0;
+};
+
+TEST_CASE("Idle loop detection", "[cpu][idle]") {
+	Bus bus;
+	IdleLoopDetector detector;
+
+	SECTION("Polling a RAM variable") {
+		loadProgram(bus, {
+			0xa5, 0x10, // -: LDA $10
+			0xf0, 0xfc, //    BEQ -
+		});
+
+		// the first trip around sets the state, the second one confirms it doesn't change
+		REQUIRE(runUntilIdle(bus, detector) == 4);
+		REQUIRE(bus.cpu.PC == 0);
+
+		// once the variable changes (e.g. in an NMI handler), the loop exits
+		bus.ram.write(0x10, 8, 1);
+		REQUIRE(runUntilIdle(bus, detector, 2) == 0);
+		REQUIRE(bus.cpu.PC == 4);
+	}
+
+	SECTION("Polling RDNMI") {
+		loadProgram(bus, {
+			0xad, 0x10, 0x42, // -: LDA $4210
+			0x29, 0x80,       //    AND #$80
+			0xf0, 0xf9,       //    BEQ -
+		});
+
+		REQUIRE(runUntilIdle(bus, detector) == 6);
+	}
+
+	SECTION("Branching to itself") {
+		loadProgram(bus, {
+			0x80, 0xfe, // -: BRA -
+		});
+
+		REQUIRE(runUntilIdle(bus, detector) == 2);
+	}
+
+	SECTION("Loops that change something aren't idle") {
+		loadProgram(bus, {
+			0xe8,       // -: INX
+			0xd0, 0xfd, //    BNE -
+			0x80, 0xfe, // -: BRA -
+		});
+
+		// the counting loop takes 256 trips before it gets to the infinite loop
+		REQUIRE(runUntilIdle(bus, detector, 1000) == 512 + 2);
+	}
+
+	SECTION("Loops that write aren't idle") {
+		loadProgram(bus, {
+			0xa5, 0x10, // -: LDA $10
+			0x85, 0x10, //    STA $10
+			0xf0, 0xfa, //    BEQ -
+		});
+
+		REQUIRE(runUntilIdle(bus, detector) == 0);
+	}
+
+	SECTION("Waiting for an interrupt") {
+		loadProgram(bus, {
+			0xcb, // WAI
+		});
+
+		REQUIRE(runUntilIdle(bus, detector) == 1);
+		REQUIRE(bus.cpu.waitingForInterrupt);
+	}
+}
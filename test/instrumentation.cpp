@@ -0,0 +1,186 @@
+#include <blaze/Bus.hpp>
+#include <blaze/Instrumentation.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace Blaze;
+
+TEST_CASE("Instrumentation policies", "[instrumentation]") {
+	SECTION("No instrumentation has no state at all") {
+		Instrumentation::None none;
+		none.setBreakpoint(0x008000);
+
+		REQUIRE(std::is_empty_v<Instrumentation::None>);
+		REQUIRE_FALSE(none.atBreakpoint(0x008000));
+	}
+
+	SECTION("The profiler counts everything") {
+		Instrumentation::Profiler profiler;
+
+		profiler.beforeExecute(0x008000);
+		profiler.onRead(0x008000, 8);
+		profiler.onRead(0x7e0000, 16);
+		profiler.onWrite(0x7e0000, 8, 0x12);
+		profiler.onInvalidAccess(0x002200, 8, false, 0);
+
+		REQUIRE(profiler.instructions == 1);
+		REQUIRE(profiler.reads == 2);
+		REQUIRE(profiler.writes == 1);
+		REQUIRE(profiler.invalidAccesses == 1);
+	}
+
+	SECTION("The tracer keeps the most recent instructions") {
+		Instrumentation::Tracer tracer;
+
+		for (Address i = 0; i < Instrumentation::Tracer::HISTORY_SIZE + 2; ++i) {
+			tracer.beforeExecute(0x008000 + i);
+		}
+
+		REQUIRE(tracer.executed == Instrumentation::Tracer::HISTORY_SIZE + 2);
+		REQUIRE(tracer.recent(0) == 0x008000 + Instrumentation::Tracer::HISTORY_SIZE + 1);
+		REQUIRE(tracer.recent(Instrumentation::Tracer::HISTORY_SIZE - 1) == 0x008002);
+	}
+
+	SECTION("The debugger stops at its breakpoint and reports watched accesses") {
+		Instrumentation::Debugger debugger;
+		std::vector<Address> hits;
+
+		debugger.setBreakpoint(0x008004);
+		debugger.watchpoints.push_back({ 0x7e0010, 0x7e0011, false, true });
+		debugger.watchpointHit = [&](Address address, bool forWrite, Address valueWhenWriting) {
+			REQUIRE(forWrite);
+			hits.push_back(address);
+		};
+
+		REQUIRE_FALSE(debugger.atBreakpoint(0x008000));
+		REQUIRE(debugger.atBreakpoint(0x008004));
+
+		debugger.onRead(0x7e0010, 8);
+		debugger.onWrite(0x7e000e, 16, 0x1234);
+		debugger.onWrite(0x7e000f, 16, 0x1234);
+		debugger.onWrite(0x7e0011, 8, 0x56);
+
+		REQUIRE(hits == std::vector<Address> { 0x7e000f, 0x7e0011 });
+
+		debugger.setBreakpoint(Instrumentation::Debugger::NO_BREAKPOINT);
+		REQUIRE_FALSE(debugger.atBreakpoint(0x008004));
+	}
+}
+
+// these are built against each instrumented core (see `CMakeLists.txt`), so the CPU and the bus below report to that core's policy
+#if defined(BLAZE_INSTRUMENTATION_CONSOLE) || defined(BLAZE_INSTRUMENTATION_PROFILER) || defined(BLAZE_INSTRUMENTATION_TRACER) || defined(BLAZE_INSTRUMENTATION_DEBUGGER)
+// without a ROM, the CPU starts executing at $00:0000, which is mirrored from RAM
+//   LDA #$48
+//   WDM #$80  ; prints the accumulator
+//   STA $0010
+//   LDA $0010
+//   LDA $2200 ; nothing is mapped here
+//   STP
+static const Byte program[] = { 0xa9, 0x48, 0x42, 0x80, 0x8d, 0x10, 0x00, 0xad, 0x10, 0x00, 0xad, 0x00, 0x22, 0xdb };
+static constexpr size_t PROGRAM_INSTRUCTIONS = 6;
+
+struct ConsoleOutput {
+	std::string output;
+	std::vector<Address> invalidAccesses;
+};
+
+static ConsoleOutput runProgram(Bus& bus) {
+	ConsoleOutput console;
+
+	for (Address i = 0; i < sizeof(program); ++i) {
+		bus.ram.write(i, 8, program[i]);
+	}
+
+	bus.cpu.instrumentation.invalidAccess = [&](Address address, Byte bitSize, bool forWrite, Address valueWhenWriting) {
+		console.invalidAccesses.push_back(address);
+	};
+	bus.cpu.instrumentation.putCharacter = [&](char character) {
+		console.output += character;
+	};
+
+	for (size_t i = 0; i < PROGRAM_INSTRUCTIONS; ++i) {
+		bus.cpu.execute();
+	}
+
+	REQUIRE(bus.cpu.stopped);
+
+	bus.cpu.instrumentation.invalidAccess = nullptr;
+	bus.cpu.instrumentation.putCharacter = nullptr;
+
+	return console;
+};
+
+TEST_CASE("Console hooks", "[instrumentation]") {
+	static_assert(std::is_base_of_v<Instrumentation::Console, Bus::Instrumentation>);
+
+	Bus bus;
+	auto console = runProgram(bus);
+
+	REQUIRE(console.output == "H");
+	REQUIRE(console.invalidAccesses == std::vector<Address> { 0x002200 });
+}
+#endif
+
+#if defined(BLAZE_INSTRUMENTATION_PROFILER)
+TEST_CASE("Profiler hooks", "[instrumentation]") {
+	static_assert(std::is_same_v<Bus::Instrumentation, Instrumentation::Profiler>);
+
+	Bus bus;
+	const auto& profiler = bus.cpu.instrumentation;
+
+	// resetting the CPU already read the reset vector
+	auto readsBefore = profiler.reads;
+
+	runProgram(bus);
+
+	// 6 opcodes, 5 operands, and the 2 loads
+	REQUIRE(profiler.instructions == PROGRAM_INSTRUCTIONS);
+	REQUIRE(profiler.reads - readsBefore == 13);
+	REQUIRE(profiler.writes == 1);
+	REQUIRE(profiler.invalidAccesses == 1);
+}
+#endif
+
+#if defined(BLAZE_INSTRUMENTATION_TRACER)
+TEST_CASE("Tracer hooks", "[instrumentation]") {
+	static_assert(std::is_same_v<Bus::Instrumentation, Instrumentation::Tracer>);
+
+	Bus bus;
+	runProgram(bus);
+
+	const auto& tracer = bus.cpu.instrumentation;
+
+	REQUIRE(tracer.executed == PROGRAM_INSTRUCTIONS);
+
+	const Address addresses[] = { 0x00000d, 0x00000a, 0x000007, 0x000004, 0x000002, 0x000000 };
+	for (size_t age = 0; age < PROGRAM_INSTRUCTIONS; ++age) {
+		REQUIRE(tracer.recent(age) == addresses[age]);
+	}
+}
+#endif
+
+#if defined(BLAZE_INSTRUMENTATION_DEBUGGER)
+TEST_CASE("Debugger hooks", "[instrumentation]") {
+	static_assert(std::is_same_v<Bus::Instrumentation, Instrumentation::Debugger>);
+
+	Bus bus;
+	auto& debugger = bus.cpu.instrumentation;
+
+	std::vector<std::pair<Address, bool>> accesses;
+
+	// the first opcode fetch, and everything that touches $0010
+	debugger.watchpoints.push_back({ 0x000000, 0x000000, true, false });
+	debugger.watchpoints.push_back({ 0x000010, 0x000010, true, true });
+	debugger.watchpointHit = [&](Address address, bool forWrite, Address valueWhenWriting) {
+		accesses.emplace_back(address, forWrite);
+	};
+
+	runProgram(bus);
+
+	REQUIRE(accesses == std::vector<std::pair<Address, bool>> { { 0x000000, false }, { 0x000010, true }, { 0x000010, false } });
+}
+#endif
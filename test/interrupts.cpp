@@ -0,0 +1,236 @@
+#include <blaze/Bus.hpp>
+#include <blaze/InterruptController.hpp>
+#include <blaze/Scheduler.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+using namespace Blaze;
+
+TEST_CASE("Interrupt controller", "[interrupts]") {
+	Bus bus;
+	auto& interrupts = bus.interrupts;
+
+	auto writeRegister = [&](Address address, Byte value) {
+		bus.write(address, value);
+	};
+
+	auto readRegister = [&](Address address) {
+		return bus.read8(address);
+	};
+
+	SECTION("The H timer fires on every scanline at HTIME") {
+		writeRegister(0x4207, 100);
+		writeRegister(0x4208, 0);
+		writeRegister(0x4200, InterruptController::NMITIMENFlags::H_IRQ);
+
+		for (uint16_t scanline = 0; scanline < 3; ++scanline) {
+			interrupts.beginScanline(scanline);
+			REQUIRE(interrupts.nextEvent() == 100 * InterruptController::MASTER_CLOCKS_PER_DOT);
+
+			interrupts.advance(399);
+			REQUIRE(!interrupts.irqAsserted());
+
+			interrupts.advance(400);
+			REQUIRE(interrupts.irqAsserted());
+			REQUIRE(interrupts.nextEvent() == InterruptController::NO_EVENT);
+
+			// reading TIMEUP acknowledges it
+			REQUIRE(readRegister(0x4211) == 0x80);
+			REQUIRE(!interrupts.irqAsserted());
+			REQUIRE(readRegister(0x4211) == 0x00);
+		}
+	}
+
+	SECTION("The V timer only fires on scanline VTIME") {
+		writeRegister(0x4209, 0x05);
+		writeRegister(0x420a, 0x01);
+		writeRegister(0x4200, InterruptController::NMITIMENFlags::V_IRQ);
+
+		interrupts.beginScanline(0x105 - 1);
+		REQUIRE(interrupts.nextEvent() == InterruptController::NO_EVENT);
+		REQUIRE(!interrupts.irqAsserted());
+
+		interrupts.beginScanline(0x105);
+		REQUIRE(interrupts.irqAsserted());
+
+		// turning the timer off acknowledges it, too
+		writeRegister(0x4200, 0);
+		REQUIRE(!interrupts.irqAsserted());
+	}
+
+	SECTION("A timer the beam already passed doesn't fire until the next scanline") {
+		interrupts.beginScanline(10);
+		interrupts.advance(800);
+
+		writeRegister(0x4207, 100);
+		writeRegister(0x4208, 0);
+		writeRegister(0x4200, InterruptController::NMITIMENFlags::H_IRQ);
+		REQUIRE(interrupts.nextEvent() == InterruptController::NO_EVENT);
+
+		interrupts.beginScanline(11);
+		REQUIRE(interrupts.nextEvent() == 400);
+	}
+
+	SECTION("NMIs are raised at the start of vblank and delivered between instructions") {
+		writeRegister(0x4200, InterruptController::NMITIMENFlags::NMI);
+
+		interrupts.beginVBlank();
+		REQUIRE(interrupts.nmiPending());
+		REQUIRE((readRegister(0x4212) & 0x80) != 0);
+
+		interrupts.service(bus.cpu);
+		REQUIRE(!interrupts.nmiPending());
+		REQUIRE(bus.cpu._interruptStack.size() == 1);
+
+		// the flag is cleared by reading it
+		REQUIRE(readRegister(0x4210) == 0x80);
+		REQUIRE(readRegister(0x4210) == 0x00);
+
+		interrupts.endVBlank();
+		REQUIRE((readRegister(0x4212) & 0x80) == 0);
+	}
+
+	SECTION("Enabling NMIs during vblank raises one right away") {
+		interrupts.beginVBlank();
+		REQUIRE(!interrupts.nmiPending());
+
+		writeRegister(0x4200, InterruptController::NMITIMENFlags::NMI);
+		REQUIRE(interrupts.nmiPending());
+	}
+
+	SECTION("Masked IRQs wake the CPU up without entering the handler") {
+		writeRegister(0x4207, 0);
+		writeRegister(0x4208, 0);
+		writeRegister(0x4200, InterruptController::NMITIMENFlags::H_IRQ);
+		interrupts.beginScanline(0);
+		REQUIRE(interrupts.irqAsserted());
+
+		bus.cpu.setFlag(CPU::flags::i, true);
+		bus.cpu.waitingForInterrupt = true;
+
+		interrupts.service(bus.cpu);
+		REQUIRE(!bus.cpu.waitingForInterrupt);
+		REQUIRE(bus.cpu._interruptStack.empty());
+
+		bus.cpu.setFlag(CPU::flags::i, false);
+		interrupts.service(bus.cpu);
+		REQUIRE(bus.cpu._interruptStack.size() == 1);
+	}
+}
+
+TEST_CASE("Scheduler", "[interrupts]") {
+	Bus bus;
+	Scheduler scheduler;
+
+	// without a ROM, every vector reads as zero, so the reset and IRQ handlers are both at $00:0000 (which is mirrored from RAM)
+	auto loadProgram = [&](Address address, const std::vector<Byte>& program) {
+		for (Address i = 0; i < program.size(); ++i) {
+			bus.ram.write(address + i, 8, program[i]);
+		}
+	};
+
+	// runs instructions the same way the GUI does
+	auto step = [&]() {
+		bus.interrupts.service(bus.cpu);
+
+		auto beginCycle = bus.cpu.cycleCounter;
+		bus.cpu.execute();
+
+		return scheduler.advance(bus, bus.cpu.cycleCounter - beginCycle);
+	};
+
+	SECTION("The beam keeps moving inside an interrupt handler") {
+		// the IRQ handler waits for hblank (by polling HVBJOY), acknowledges the timer, and counts how often it ran
+		loadProgram(0x0000, {
+			0xad, 0x12, 0x42, // LDA $4212
+			0x29, 0x40,       // AND #$40
+			0xf0, 0xf9,       // BEQ $0000
+			0xad, 0x11, 0x42, // LDA $4211
+			0xee, 0x10, 0x00, // INC $0010
+			0x40,             // RTI
+		});
+
+		// the main program just keeps interrupts enabled and waits
+		loadProgram(0x0100, {
+			0x58,       // CLI
+			0x80, 0xfd, // BRA $0100
+		});
+		bus.cpu.PC = 0x0100;
+		bus.cpu.SP = 0x01ff;
+
+		// an H-IRQ at dot 10 (well before hblank) on every scanline
+		bus.write(0x4207, Byte(10));
+		bus.write(0x4208, Byte(0));
+		bus.write(0x4200, Byte(InterruptController::NMITIMENFlags::H_IRQ));
+
+		size_t scanlines = 0;
+
+		for (size_t i = 0; i < 10000 && scanlines < 3; ++i) {
+			if ((step() & Scheduler::Events::NEW_SCANLINE) != 0) {
+				++scanlines;
+			}
+		}
+
+		REQUIRE(scanlines == 3);
+		REQUIRE(scheduler.scanline() == 3);
+
+		// the handler ran (and got out) once on each scanline
+		REQUIRE(bus.ram.read(0x0010, 8) == 3);
+		REQUIRE(bus.cpu._interruptStack.empty());
+	}
+
+	SECTION("Vblank starts and ends on the right scanlines") {
+		// STP; the CPU won't do anything, so every step skips straight to the next event
+		loadProgram(0x0000, { 0xdb });
+
+		uint64_t vblankStart = 0;
+		uint64_t vblankEnd = 0;
+
+		for (size_t i = 0; i < 10000 && vblankEnd == 0; ++i) {
+			auto events = step();
+
+			if ((events & Scheduler::Events::VBLANK_START) != 0) {
+				vblankStart = bus.cpu.cycleCounter;
+				REQUIRE(scheduler.scanline() == Scheduler::VBLANK_FIRST_SCANLINE);
+				REQUIRE((bus.interrupts.read(InterruptController::Registers::HVBJOY, 8) & 0x80) != 0);
+			}
+
+			if ((events & Scheduler::Events::VBLANK_END) != 0) {
+				vblankEnd = bus.cpu.cycleCounter;
+				REQUIRE(scheduler.scanline() == 0);
+				REQUIRE((bus.interrupts.read(InterruptController::Registers::HVBJOY, 8) & 0x80) == 0);
+			}
+		}
+
+		REQUIRE(vblankStart != 0);
+		REQUIRE(vblankEnd - vblankStart == (Scheduler::SCANLINES - Scheduler::VBLANK_FIRST_SCANLINE) * Scheduler::MASTER_CLOCKS_PER_SCANLINE);
+	}
+
+	SECTION("HVBJOY shows the automatic joypad read while it's in progress") {
+		loadProgram(0x0000, { 0xdb });
+
+		bus.write(0x4200, Byte(InterruptController::NMITIMENFlags::AUTO_JOYPAD));
+		bus.joypads.setButtons(0, Joypads::Buttons::START);
+
+		// whether the read was in progress at the start of each scanline
+		std::vector<bool> busy(Scheduler::SCANLINES, false);
+
+		for (size_t i = 0; i < 10000 && scheduler.scanline() < 230; ++i) {
+			if ((step() & Scheduler::Events::NEW_SCANLINE) != 0) {
+				busy[scheduler.scanline()] = (bus.interrupts.read(InterruptController::Registers::HVBJOY, 8) & 0x01) != 0;
+			}
+		}
+
+		auto first = Scheduler::VBLANK_FIRST_SCANLINE;
+
+		REQUIRE_FALSE(busy[first - 1]);
+		for (uint16_t line = first; line < first + InterruptController::AUTO_JOYPAD_READ_SCANLINES; ++line) {
+			REQUIRE(busy[line]);
+		}
+		REQUIRE_FALSE(busy[first + InterruptController::AUTO_JOYPAD_READ_SCANLINES]);
+
+		// once it's done, the buttons are in JOY1
+		REQUIRE(bus.read16(0x4218) == Joypads::Buttons::START);
+	}
+}
@@ -0,0 +1,344 @@
+#include <blaze/Bus.hpp>
+#include <blaze/Batch.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+using namespace Blaze;
+
+TEST_CASE("RAM pages are copied on write", "[memory]") {
+	MemRam original;
+	MemRam copy;
+
+	original.write(0x0123, 8, 0x45);
+	copy.shareFrom(original);
+
+	REQUIRE(copy.sharedPageCount() == MemRam::PAGE_COUNT);
+	REQUIRE(copy.read(0x0123, 8) == 0x45);
+
+	SECTION("writes to the copy are not visible in the original") {
+		copy.write(0x0123, 8, 0x67);
+
+		REQUIRE(copy.read(0x0123, 8) == 0x67);
+		REQUIRE(original.read(0x0123, 8) == 0x45);
+		REQUIRE(copy.sharedPageCount() == MemRam::PAGE_COUNT - 1);
+	}
+
+	SECTION("writes to the original are not visible in the copy") {
+		original.write(0x1ffff, 8, 0x89);
+
+		REQUIRE(original.read(0x1ffff, 8) == 0x89);
+		REQUIRE(copy.read(0x1ffff, 8) == 0x00);
+	}
+
+	SECTION("resetting one RAM doesn't clear the other") {
+		copy.reset(nullptr);
+
+		REQUIRE(copy.read(0x0123, 8) == 0x00);
+		REQUIRE(original.read(0x0123, 8) == 0x45);
+		REQUIRE(copy.sharedPageCount() == 0);
+	}
+}
+
+TEST_CASE("Batch execution", "[memory][batch]") {
+	Bus snapshot;
+
+	// without a ROM, the CPU starts executing at $00:0000, which is mirrored from RAM
+	//   LDA #$42
+	//   STA $1000
+	//   STP
+	const Byte program[] = { 0xa9, 0x42, 0x8d, 0x00, 0x10, 0xdb };
+	for (Address i = 0; i < sizeof(program); ++i) {
+		snapshot.ram.write(i, 8, program[i]);
+	}
+
+	Batch batch(snapshot, 4);
+
+	REQUIRE(batch.size() == 4);
+
+	SECTION("every machine executes one instruction per step") {
+		batch.step();
+
+		for (size_t i = 0; i < batch.size(); ++i) {
+			REQUIRE(batch[i].cpu.A.load() == 0x42);
+			REQUIRE(batch[i].cpu.PC == 2);
+		}
+
+		batch.step();
+		batch.step();
+
+		for (size_t i = 0; i < batch.size(); ++i) {
+			REQUIRE(batch[i].cpu.stopped);
+			REQUIRE(batch[i].ram.read(0x1000, 8) == 0x42);
+		}
+
+		// the snapshot itself is untouched
+		REQUIRE(snapshot.ram.read(0x1000, 8) == 0x00);
+		REQUIRE(snapshot.cpu.PC == 0);
+	}
+
+	SECTION("diverging machines are executed separately") {
+		// NOP
+		batch[3].ram.write(0, 8, 0xea);
+
+		batch.step();
+		REQUIRE(batch[0].cpu.A.load() == 0x42);
+		REQUIRE(batch[3].cpu.PC == 1);
+
+		// only machine 3 wrote to RAM, so the other machines still share all of their pages
+		REQUIRE(batch[0].ram.sharedPageCount() == MemRam::PAGE_COUNT);
+		REQUIRE(batch[3].ram.sharedPageCount() == MemRam::PAGE_COUNT - 1);
+	}
+}
+
+TEST_CASE("Batch execution with interrupts and input", "[memory][batch]") {
+	Bus snapshot;
+
+	// without a ROM, every vector reads as zero, so the NMI handler is at $00:0000 (which is mirrored from RAM).
+	// it adds the low byte of JOY1 to $0020 and counts frames in $0021:
+	//   LDA $4218
+	//   CLC
+	//   ADC $0020
+	//   STA $0020
+	//   INC $0021
+	//   RTI
+	const Byte handler[] = { 0xad, 0x18, 0x42, 0x18, 0x6d, 0x20, 0x00, 0x8d, 0x20, 0x00, 0xee, 0x21, 0x00, 0x40 };
+
+	// the main program enables NMIs and the automatic joypad read, then waits for interrupts forever:
+	//   LDA #$81
+	//   STA $4200
+	// wait:
+	//   WAI
+	//   BRA wait
+	const Byte program[] = { 0xa9, 0x81, 0x8d, 0x00, 0x42, 0xcb, 0x80, 0xfd };
+
+	for (Address i = 0; i < sizeof(handler); ++i) {
+		snapshot.ram.write(i, 8, handler[i]);
+	}
+	for (Address i = 0; i < sizeof(program); ++i) {
+		snapshot.ram.write(0x0100 + i, 8, program[i]);
+	}
+	snapshot.cpu.PC = 0x0100;
+	snapshot.cpu.SP = 0x01ff;
+
+	Batch batch(snapshot, 4);
+	const Word buttons[] = { 0, Joypads::Buttons::R, Joypads::Buttons::L, Joypads::Buttons::L | Joypads::Buttons::R };
+
+	for (size_t i = 0; i < batch.size(); ++i) {
+		batch.setButtons(i, 0, buttons[i]);
+	}
+
+	constexpr Byte FRAMES = 3;
+	auto framesDone = [&]() {
+		for (size_t i = 0; i < batch.size(); ++i) {
+			if (batch[i].ram.read(0x0021, 8) < FRAMES) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	for (size_t i = 0; i < 100000 && !framesDone(); ++i) {
+		batch.step();
+
+		// the machines only differ in their input, so they never leave lockstep
+		for (size_t j = 1; j < batch.size(); ++j) {
+			REQUIRE(batch[j].cpu.PC == batch[0].cpu.PC);
+		}
+	}
+
+	REQUIRE(framesDone());
+
+	for (size_t i = 0; i < batch.size(); ++i) {
+		REQUIRE(batch[i].ram.read(0x0021, 8) == FRAMES);
+		REQUIRE(batch[i].ram.read(0x0020, 8) == ((FRAMES * buttons[i]) & 0xff));
+		REQUIRE(batch.scheduler(i).scanline() == Scheduler::VBLANK_FIRST_SCANLINE);
+	}
+}
+
+TEST_CASE("Forking a machine", "[memory][fork]") {
+	Bus parent;
+
+	parent.write(static_cast<Address>(0x7e0100), static_cast<Byte>(0x12));
+	parent.cpu.A.forceStoreFull(0x3456);
+
+	auto child = parent.fork();
+
+	REQUIRE(child->cpu.A.forceLoadFull() == 0x3456);
+	REQUIRE(child->ram.sharedPageCount() == MemRam::PAGE_COUNT);
+
+	// RAM is mirrored into bank $00, so this goes through both the page table and the shared pages
+	REQUIRE(child->read8(0x000100) == 0x12);
+
+	SECTION("the child's writes are private") {
+		child->write(static_cast<Address>(0x000100), static_cast<Byte>(0x34));
+
+		REQUIRE(child->read8(0x7e0100) == 0x34);
+		REQUIRE(parent.read8(0x7e0100) == 0x12);
+		REQUIRE(parent.ram.sharedPageCount() == MemRam::PAGE_COUNT - 1);
+	}
+
+	SECTION("the parent's writes are private") {
+		parent.write(static_cast<Address>(0x7f0000), static_cast<Byte>(0x56));
+
+		REQUIRE(parent.read8(0x7f0000) == 0x56);
+		REQUIRE(child->read8(0x7f0000) == 0x00);
+	}
+
+	SECTION("multi-byte accesses see the same pages and mark the same blocks") {
+		child->write(static_cast<Address>(0x7e0200), static_cast<Word>(0xbeef));
+
+		REQUIRE(child->read16(0x000200) == 0xbeef);
+		REQUIRE(parent.read16(0x7e0200) == 0x0000);
+		REQUIRE(child->ram.dirtyBlocks().test(0x02));
+		REQUIRE_FALSE(parent.ram.dirtyBlocks().test(0x02));
+
+		Byte value = 0;
+		REQUIRE(child->peek8(0x7e0201, value));
+		REQUIRE(value == 0xbe);
+	}
+}
+
+TEST_CASE("Access speeds", "[memory][speed]") {
+	Bus bus;
+
+	REQUIRE(bus.accessSpeed(0x7e0000) == Bus::AccessSpeed::Slow);
+	REQUIRE(bus.accessSpeed(0x001fff) == Bus::AccessSpeed::Slow);
+	REQUIRE(bus.accessSpeed(0x002100) == Bus::AccessSpeed::Fast);
+	REQUIRE(bus.accessSpeed(0x804016) == Bus::AccessSpeed::ExtraSlow);
+	REQUIRE(bus.accessSpeed(0x004200) == Bus::AccessSpeed::Fast);
+	REQUIRE(bus.accessSpeed(0x006000) == Bus::AccessSpeed::Slow);
+	REQUIRE(bus.accessSpeed(0x008000) == Bus::AccessSpeed::Slow);
+	REQUIRE(bus.accessSpeed(0x808000) == Bus::AccessSpeed::Slow);
+	REQUIRE(bus.accessSpeed(0xc00000) == Bus::AccessSpeed::Slow);
+
+	SECTION("each access adds its speed to the CPU's cycle counter") {
+		auto before = bus.cpu.cycleCounter;
+		bus.read8(0x7e0000);
+		bus.write(static_cast<Address>(0x002100), static_cast<Byte>(0x80));
+		bus.read16(0x804016);
+
+		REQUIRE(bus.cpu.cycleCounter - before == 8 + 6 + 12 + 12);
+	}
+
+	SECTION("MEMSEL only speeds up ROM in banks $80 and up") {
+		bus.write(static_cast<Address>(0x00420d), static_cast<Byte>(Bus::MEMSEL_FASTROM));
+
+		REQUIRE(bus.fastROM());
+		REQUIRE(bus.accessSpeed(0x808000) == Bus::AccessSpeed::Fast);
+		REQUIRE(bus.accessSpeed(0xc00000) == Bus::AccessSpeed::Fast);
+		REQUIRE(bus.accessSpeed(0xffffff) == Bus::AccessSpeed::Fast);
+		REQUIRE(bus.accessSpeed(0x008000) == Bus::AccessSpeed::Slow);
+		REQUIRE(bus.accessSpeed(0x400000) == Bus::AccessSpeed::Slow);
+		REQUIRE(bus.accessSpeed(0x800000) == Bus::AccessSpeed::Slow);
+		REQUIRE(bus.accessSpeed(0x806000) == Bus::AccessSpeed::Slow);
+
+		// multi-byte accesses wrap around within the bank (instead of going on to the slow RAM in bank $00)
+		auto before = bus.cpu.cycleCounter;
+		bus.read16(0xffffff);
+		bus.read24(0xfffffe);
+		REQUIRE(bus.cpu.cycleCounter - before == 5 * Bus::AccessSpeed::Fast);
+		REQUIRE(bus.accessSpeed(0x7fffff, 2) == 2 * Bus::AccessSpeed::Slow);
+
+		bus.write(static_cast<Address>(0x7effff), static_cast<Word>(0x1234));
+		REQUIRE(bus.read8(0x7effff) == 0x34);
+		REQUIRE(bus.read8(0x7e0000) == 0x12);
+		REQUIRE(bus.read8(0x7f0000) == 0x00);
+
+		// forks keep the speed
+		auto child = bus.fork();
+		REQUIRE(child->accessSpeed(0x808000) == Bus::AccessSpeed::Fast);
+
+		bus.write(static_cast<Address>(0x80420d), static_cast<Byte>(0));
+
+		REQUIRE_FALSE(bus.fastROM());
+		REQUIRE(bus.accessSpeed(0x808000) == Bus::AccessSpeed::Slow);
+	}
+}
+
+TEST_CASE("MMIO registers", "[memory][mmio]") {
+	Bus bus;
+
+	SECTION("multiplication and division") {
+		bus.write(static_cast<Address>(0x004202), static_cast<Byte>(12));
+		bus.write(static_cast<Address>(0x804203), static_cast<Byte>(34));
+
+		REQUIRE(bus.read16(0x004216) == 12 * 34);
+
+		bus.write(static_cast<Address>(0x004204), static_cast<Word>(1000));
+		bus.write(static_cast<Address>(0x004206), static_cast<Byte>(7));
+
+		REQUIRE(bus.read16(0x004214) == 1000 / 7);
+		REQUIRE(bus.read16(0x804216) == 1000 % 7);
+	}
+
+	SECTION("DMA registers") {
+		bus.write(static_cast<Address>(0x00420c), static_cast<Byte>(0x81));
+		bus.write(static_cast<Address>(0x004372), static_cast<Word>(0x1234));
+
+		REQUIRE(bus.read8(0x00420c) == 0x81);
+		REQUIRE(bus.read16(0x804372) == 0x1234);
+		REQUIRE(bus.read8(0x004302) == 0xff);
+	}
+
+	SECTION("registers only show up in the system banks") {
+		bus.write(static_cast<Address>(0x004202), static_cast<Byte>(0x56));
+
+		REQUIRE(bus.read8(0x004202) == 0x56);
+		REQUIRE(bus.read8(0x404202) == 0x00);
+	}
+}
+
+TEST_CASE("Dirty block tracking", "[memory][dirty]") {
+	Bus bus;
+
+	REQUIRE(bus.ram.dirtyBlocks().blockCount() == MemRam::MEM_SIZE / 256);
+	REQUIRE_FALSE(bus.ram.dirtyBlocks().any());
+
+	SECTION("CPU writes mark the block they hit") {
+		bus.write(static_cast<Address>(0x7e0100), static_cast<Byte>(0x12));
+		bus.write(static_cast<Address>(0x7f01ff), static_cast<Byte>(0x34));
+
+		std::vector<size_t> dirty;
+		bus.ram.dirtyBlocks().forEachDirty([&](size_t block) {
+			dirty.push_back(block);
+		});
+
+		REQUIRE(dirty == std::vector<size_t> { 0x001, 0x101 });
+
+		bus.ram.dirtyBlocks().clear();
+		REQUIRE_FALSE(bus.ram.dirtyBlocks().any());
+	}
+
+	SECTION("DMA writes mark every block they cover") {
+		// B-bus -> A-bus, single byte, increment; from $2100 into $7e:2080, $0200 bytes
+		bus.write(static_cast<Address>(0x4300), static_cast<Byte>(0x80));
+		bus.write(static_cast<Address>(0x4301), static_cast<Byte>(0x00));
+		bus.write(static_cast<Address>(0x4302), static_cast<Byte>(0x80));
+		bus.write(static_cast<Address>(0x4303), static_cast<Byte>(0x20));
+		bus.write(static_cast<Address>(0x4304), static_cast<Byte>(0x7e));
+		bus.write(static_cast<Address>(0x4305), static_cast<Byte>(0x00));
+		bus.write(static_cast<Address>(0x4306), static_cast<Byte>(0x02));
+		bus.write(static_cast<Address>(0x420b), static_cast<Byte>(0x01));
+
+		auto& dirty = bus.ram.dirtyBlocks();
+		REQUIRE_FALSE(dirty.test(0x1f));
+		REQUIRE(dirty.test(0x20));
+		REQUIRE(dirty.test(0x21));
+		REQUIRE(dirty.test(0x22));
+		REQUIRE_FALSE(dirty.test(0x23));
+	}
+
+	SECTION("SRAM writes are tracked separately") {
+		SRAM sram;
+		sram.setSize(2048);
+
+		REQUIRE(sram.dirtyBlocks().blockCount() == 8);
+
+		sram.write(0x0700, 8, 0x56);
+		REQUIRE(sram.dirtyBlocks().test(7));
+
+		sram.dirtyBlocks().clear(7);
+		REQUIRE_FALSE(sram.dirtyBlocks().any());
+	}
+}
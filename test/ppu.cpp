@@ -0,0 +1,300 @@
+#include <blaze/Bus.hpp>
+#include <blaze/PPU.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <random>
+#include <thread>
+
+using namespace Blaze;
+
+namespace {
+	constexpr uint32_t BLACK = 0x000000ff;
+	constexpr uint32_t RED = 0xff0000ff;
+
+	using Row = std::array<uint32_t, PPU::LINE_WIDTH>;
+
+	struct Machine {
+		Bus bus;
+		PPU ppu;
+
+		Machine() {
+			bus.ppu = &ppu;
+			bus.reset();
+
+			// the PPU starts out with a blank frame ready to present; we only want the ones we render
+			ppu.latestFrame();
+		};
+
+		void write(Address address, Byte value) {
+			bus.write(address, value);
+		};
+
+		// writes a register that takes two writes (low byte first), e.g. the scroll and mode 7 registers
+		void writeTwice(Address address, Word value) {
+			bus.write(address, static_cast<Byte>(value & 0xff));
+			bus.write(address, static_cast<Byte>(value >> 8));
+		};
+
+		// writes a pair of registers (low byte first), e.g. VMADD or VMDATA
+		void writePair(Address address, Word value) {
+			bus.write(address, static_cast<Byte>(value & 0xff));
+			bus.write(address + 1, static_cast<Byte>(value >> 8));
+		};
+
+		// emulates a whole frame; `beforeLine` is called right before each visible line is reached (e.g. for mid-frame writes)
+		PPU::Frame runFrame(const std::function<void(size_t line)>& beforeLine = nullptr) {
+			ppu.endVBlank();
+
+			for (size_t line = 0; line < PPU::FRAME_HEIGHT; ++line) {
+				if (beforeLine) {
+					beforeLine(line);
+				}
+				ppu.beginScanline(line);
+			}
+
+			ppu.beginVBlank();
+
+			// with asynchronous rendering, the frame only shows up once the render thread is done with it
+			const PPU::Frame* frame = nullptr;
+			while ((frame = ppu.latestFrame()) == nullptr) {
+				std::this_thread::yield();
+			}
+
+			return *frame;
+		};
+	};
+
+	Row row(const PPU::Frame& frame, size_t line) {
+		Row result;
+		std::copy_n(frame.begin() + (line * PPU::LINE_WIDTH), PPU::LINE_WIDTH, result.begin());
+		return result;
+	};
+
+	// the index of the first pixel that differs between two frames (or the number of pixels, if they're the same)
+	size_t firstDifference(const PPU::Frame& frame, const PPU::Frame& expected) {
+		return std::mismatch(frame.begin(), frame.end(), expected.begin()).first - frame.begin();
+	};
+
+	// a row of black pixels with [begin, end) in red
+	Row redSpan(size_t begin, size_t end) {
+		Row result;
+		result.fill(BLACK);
+		std::fill(result.begin() + begin, result.begin() + end, RED);
+		return result;
+	};
+
+	// fills VRAM, CGRAM, and OAM with noise and enables every layer (along with color math and windows)
+	void randomScene(Machine& machine, uint32_t seed) {
+		std::mt19937 random(seed);
+
+		machine.write(0x2100, 0x0f);
+		machine.write(0x2115, 0x80);
+		machine.writePair(0x2116, 0x0000);
+		for (size_t i = 0; i < PPU::VRAM_WORDS; ++i) {
+			machine.writePair(0x2118, static_cast<Word>(random()));
+		}
+
+		machine.write(0x2121, 0x00);
+		for (size_t i = 0; i < 512; ++i) {
+			machine.write(0x2122, static_cast<Byte>(random()));
+		}
+
+		machine.writePair(0x2102, 0x0000);
+		for (size_t i = 0; i < 544; ++i) {
+			machine.write(0x2104, static_cast<Byte>(random()));
+		}
+
+		machine.write(0x2107, 0x10);
+		machine.write(0x2108, 0x20);
+		machine.write(0x210b, 0x42);
+		machine.write(0x212c, 0x1f);
+		machine.write(0x212d, 0x13);
+		machine.write(0x2126, 0x20);
+		machine.write(0x2127, 0xc0);
+		machine.write(0x2123, 0x22);
+		machine.write(0x2130, 0x02);
+		machine.write(0x2131, 0x23);
+	};
+
+	// changes the scroll, the mode 7 matrix and the window every few lines
+	void randomLineWrites(Machine& machine, std::mt19937& random, size_t line) {
+		if (line % 40 != 20) {
+			return;
+		}
+
+		machine.writeTwice(0x210d, static_cast<Word>(random() & 0x3ff));
+		machine.writeTwice(0x210e, static_cast<Word>(random() & 0x3ff));
+		machine.writeTwice(0x211b, static_cast<Word>(random()));
+		machine.writeTwice(0x211c, static_cast<Word>(random()));
+		machine.write(0x2126, static_cast<Byte>(random()));
+		machine.write(0x2127, static_cast<Byte>(random()));
+	};
+}
+
+TEST_CASE("PPU rendering", "[ppu]") {
+	Machine machine;
+
+	machine.write(0x2100, 0x0f);
+
+	// CGRAM color 1 is red (and the backdrop is black)
+	machine.write(0x2121, 0x01);
+	machine.write(0x2122, 0x1f);
+	machine.write(0x2122, 0x00);
+
+	SECTION("BG1 wraps around the edges of its tilemap") {
+		// mode 0, with BG1's 32x32 tilemap at word $0400 and its tiles at word $0000
+		machine.write(0x2105, 0x00);
+		machine.write(0x2107, 0x04);
+		machine.write(0x210b, 0x00);
+		machine.write(0x212c, 0x01);
+
+		// tile 1 is solid color 1 (bitplane 0 set everywhere)
+		machine.write(0x2115, 0x80);
+		machine.writePair(0x2116, 1 * 8);
+		for (size_t i = 0; i < 8; ++i) {
+			machine.writePair(0x2118, 0x00ff);
+		}
+
+		// the only non-empty tile is in the bottom right corner of the tilemap
+		machine.writePair(0x2116, 0x0400 + (31 * 32) + 31);
+		machine.writePair(0x2118, 0x0001);
+
+		// scrolled so that the corner tile is in the top left corner of the screen
+		machine.writeTwice(0x210d, 248);
+		machine.writeTwice(0x210e, 248);
+
+		auto frame = machine.runFrame();
+
+		REQUIRE(row(frame, 2) == redSpan(0, 8));
+		REQUIRE(row(frame, 10) == redSpan(0, 0));
+	}
+
+	SECTION("the screen brightness is applied after color math") {
+		// the backdrop is white, and so is the fixed color that's added to it
+		machine.write(0x2121, 0x00);
+		machine.write(0x2122, 0xff);
+		machine.write(0x2122, 0x7f);
+		machine.write(0x2132, 0xff);
+		machine.write(0x2130, 0x00);
+		machine.write(0x2131, 0x20);
+
+		machine.write(0x2100, 0x08);
+
+		auto frame = machine.runFrame();
+
+		// white (saturated) at brightness 8/15, not the sum of two dimmed whites (which would saturate again)
+		Row expected;
+		expected.fill(0x888888ff);
+		REQUIRE(row(frame, 2) == expected);
+	}
+
+	SECTION("Mode 7") {
+		machine.write(0x2105, 0x07);
+		machine.write(0x212c, 0x01);
+
+		// the top left tile of the playfield is tile 1; every pixel of tile 1 is color 1
+		machine.write(0x2115, 0x00);
+		machine.writePair(0x2116, 0x0000);
+		machine.write(0x2118, 0x01);
+
+		machine.write(0x2115, 0x80);
+		machine.writePair(0x2116, 1 * 64);
+		for (size_t i = 0; i < 64; ++i) {
+			machine.write(0x2119, 0x01);
+		}
+
+		// identity matrix, centered on the top left corner
+		machine.writeTwice(0x211b, 0x0100);
+		machine.writeTwice(0x211c, 0x0000);
+		machine.writeTwice(0x211d, 0x0000);
+		machine.writeTwice(0x211e, 0x0100);
+		machine.writeTwice(0x211f, 0x0000);
+		machine.writeTwice(0x2120, 0x0000);
+		machine.writeTwice(0x210e, 0x0000);
+
+		SECTION("the playfield wraps around at 1024 pixels") {
+			machine.writeTwice(0x210d, 1020);
+
+			auto frame = machine.runFrame();
+
+			REQUIRE(row(frame, 2) == redSpan(4, 12));
+			REQUIRE(row(frame, 10) == redSpan(0, 0));
+		}
+
+		SECTION("the matrix scales the playfield") {
+			machine.writeTwice(0x210d, 0);
+			machine.writeTwice(0x211b, 0x0200);
+
+			auto frame = machine.runFrame();
+
+			REQUIRE(row(frame, 2) == redSpan(0, 4));
+			REQUIRE(row(frame, 10) == redSpan(0, 0));
+		}
+
+		SECTION("the playfield can be transparent outside of it") {
+			// M7SEL: screen over = 2 (transparent)
+			machine.write(0x211a, 0x80);
+			machine.writeTwice(0x210d, 1020);
+
+			auto frame = machine.runFrame();
+
+			REQUIRE(row(frame, 2) == redSpan(0, 0));
+		}
+	}
+}
+
+TEST_CASE("PPU rendering is the same no matter how it's split up", "[ppu]") {
+	Machine reference;
+	Machine machine;
+
+	randomScene(reference, 1234);
+	randomScene(machine, 1234);
+
+	SECTION("rendering whole bands of lines at once matches rendering one line at a time") {
+		for (Byte mode: { 0, 1, 7 }) {
+			std::mt19937 referenceRandom(mode);
+			std::mt19937 random(mode);
+
+			reference.write(0x2105, mode);
+			machine.write(0x2105, mode);
+
+			auto expected = reference.runFrame([&](size_t line) {
+				randomLineWrites(reference, referenceRandom, line);
+
+				// any write makes the PPU render the lines it's reached so far, so this renders every line on its own
+				reference.write(0x2133, 0x00);
+			});
+			auto frame = machine.runFrame([&](size_t line) {
+				randomLineWrites(machine, random, line);
+			});
+
+			REQUIRE(firstDifference(frame, expected) == frame.size());
+		}
+	}
+
+	SECTION("asynchronous rendering matches synchronous rendering") {
+		machine.ppu.setAsyncRendering(true);
+
+		for (Byte mode: { 0, 1, 7 }) {
+			std::mt19937 referenceRandom(mode);
+			std::mt19937 random(mode);
+
+			reference.write(0x2105, mode);
+			machine.write(0x2105, mode);
+
+			auto expected = reference.runFrame([&](size_t line) {
+				randomLineWrites(reference, referenceRandom, line);
+			});
+			auto frame = machine.runFrame([&](size_t line) {
+				randomLineWrites(machine, random, line);
+			});
+
+			REQUIRE(firstDifference(frame, expected) == frame.size());
+		}
+
+		machine.ppu.setAsyncRendering(false);
+	}
+}
@@ -0,0 +1,139 @@
+#include <blaze/SPC700.hpp>
+#include <blaze/SPCSnapshot.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Blaze;
+
+// runs the SPC700 until the given port (as seen by the CPU) reads the given value
+static bool waitForPort(SPC700& spc, size_t port, Byte value) {
+	for (size_t i = 0; i < 100000; ++i) {
+		if (spc.portsToCPU[port] == value) {
+			return true;
+		}
+		spc.step();
+	}
+	return false;
+};
+
+// uploads a program through the IPL ROM's transfer protocol (just like the CPU would) and jumps to it
+static void uploadAndExecute(SPC700& spc, Word address, const std::vector<Byte>& program) {
+	REQUIRE(waitForPort(spc, 0, 0xaa));
+	REQUIRE(waitForPort(spc, 1, 0xbb));
+
+	spc.portsFromCPU[2] = address & 0xff;
+	spc.portsFromCPU[3] = address >> 8;
+	spc.portsFromCPU[1] = 1;
+	spc.portsFromCPU[0] = 0xcc;
+	REQUIRE(waitForPort(spc, 0, 0xcc));
+
+	Byte counter = 0;
+	for (Byte value: program) {
+		spc.portsFromCPU[1] = value;
+		spc.portsFromCPU[0] = counter;
+		REQUIRE(waitForPort(spc, 0, counter));
+		++counter;
+	}
+
+	// a zero in port 1 ends the transfer and jumps to the address in ports 2 and 3
+	counter += 2;
+	spc.portsFromCPU[2] = address & 0xff;
+	spc.portsFromCPU[3] = address >> 8;
+	spc.portsFromCPU[1] = 0;
+	spc.portsFromCPU[0] = counter;
+	REQUIRE(waitForPort(spc, 0, counter));
+};
+
+TEST_CASE("SPC700", "[spc700]") {
+	SPC700 spc;
+
+	SECTION("IPL ROM boot protocol") {
+		std::vector<Byte> program = {
+			0xe8, 0x34,       // MOV A,#$34
+			0x8d, 0x12,       // MOV Y,#$12
+			0xcd, 0x56,       // MOV X,#$56
+			0x9e,             // DIV YA,X
+			0xc4, 0xf5,       // MOV $F5,A
+			0xcb, 0xf6,       // MOV $F6,Y
+			0x8f, 0x5a, 0xf4, // MOV $F4,#$5A
+			0x2f, 0xfe,       // BRA *
+		};
+
+		uploadAndExecute(spc, 0x0200, program);
+
+		REQUIRE(std::equal(program.begin(), program.end(), spc.aram.begin() + 0x200));
+		REQUIRE(waitForPort(spc, 0, 0x5a));
+		REQUIRE(spc.portsToCPU[1] == 0x1234 / 0x56);
+		REQUIRE(spc.portsToCPU[2] == 0x1234 % 0x56);
+	}
+
+	SECTION("The IPL ROM can be unmapped") {
+		REQUIRE(spc.read(0xffc0) == 0xcd);
+		spc.write(0xffc0, 0x12);
+		REQUIRE(spc.read(0xffc0) == 0xcd);
+		spc.write(0xf1, 0x00);
+		REQUIRE(spc.read(0xffc0) == 0x12);
+	}
+
+	SECTION("Timers") {
+		// timer 2 ticks every 16 cycles; with a target of 4, its counter goes up every 64 cycles
+		spc.write(0xfc, 4);
+		spc.write(0xf1, 0x84);
+		spc.runUntil(64 * 3);
+
+		REQUIRE(spc.read(0xff) == 3);
+
+		// reading the counter clears it
+		REQUIRE(spc.read(0xff) == 0);
+	}
+}
+
+TEST_CASE("SPC snapshots", "[spc700]") {
+	SPCSnapshot snapshot;
+	SPC700 spc;
+
+	SECTION("Restoring a snapshot restores the registers, ARAM, and the DSP") {
+		snapshot.PC = 0x0400;
+		snapshot.A = 0x12;
+		snapshot.SP = 0xcf;
+		snapshot.aram[0x0400] = 0x2f; // BRA *
+		snapshot.aram[0x0401] = 0xfe;
+
+		// timer 0 enabled with a target of 8 and a count of 5, and the IPL ROM unmapped
+		snapshot.aram[0xf1] = 0x01;
+		snapshot.aram[0xf2] = 0x4c;
+		snapshot.aram[0xf4] = 0xaa;
+		snapshot.aram[0xfa] = 8;
+		snapshot.aram[0xfd] = 5;
+		snapshot.aram[0xffc0] = 0x34;
+
+		snapshot.dspRegisters[0x0c] = 0x7f; // MVOLL
+		snapshot.dspRegisters[0x5d] = 0x02; // DIR
+
+		snapshot.restore(spc);
+
+		REQUIRE(spc.PC == 0x0400);
+		REQUIRE(spc.A == 0x12);
+		REQUIRE(spc.SP == 0xcf);
+		REQUIRE(!spc.iplRomEnabled());
+		REQUIRE(spc.read(0xffc0) == 0x34);
+		REQUIRE(spc.portsFromCPU[0] == 0xaa);
+		REQUIRE(spc.timers[0].enabled);
+		REQUIRE(spc.timers[0].target == 8);
+		REQUIRE(spc.read(0xfd) == 5);
+
+		REQUIRE(spc.read(0xf2) == 0x4c);
+		REQUIRE(spc.dsp.readRegister(0x0c) == 0x7f);
+		REQUIRE(spc.dsp.readRegister(0x5d) == 0x02);
+
+		spc.runUntil(SPC700::CLOCK_RATE / 100);
+		REQUIRE(spc.PC == 0x0400);
+		REQUIRE(spc.dsp.bufferedSamples() == SPC700::CLOCK_RATE / 100 / DSP::CYCLES_PER_SAMPLE);
+	}
+
+	SECTION("Loading something that isn't an SPC file fails") {
+		REQUIRE_THROWS(snapshot.load("this-file-does-not-exist.spc"));
+	}
+}
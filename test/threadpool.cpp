@@ -0,0 +1,80 @@
+#include <blaze/ThreadPool.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Blaze;
+
+TEST_CASE("Thread pool", "[threads]") {
+	SECTION("Every task runs exactly once on a valid worker") {
+		ThreadPool pool(3);
+		REQUIRE(pool.workerCount() == 4);
+
+		constexpr size_t TASK_COUNT = 239;
+		std::vector<std::atomic<size_t>> runs(TASK_COUNT);
+		std::atomic<size_t> badWorkers {0};
+
+		// the same pool is reused for several jobs, like the PPU does for every frame
+		for (size_t round = 0; round < 16; ++round) {
+			pool.run(TASK_COUNT, [&](size_t task, size_t worker) {
+				++runs[task];
+				if (worker >= pool.workerCount()) {
+					++badWorkers;
+				}
+			});
+
+			for (size_t task = 0; task < TASK_COUNT; ++task) {
+				REQUIRE(runs[task] == round + 1);
+			}
+		}
+
+		REQUIRE(badWorkers == 0);
+	}
+
+	SECTION("Running a job waits for all of its tasks to finish") {
+		ThreadPool pool(4);
+		std::atomic<size_t> finished {0};
+
+		pool.run(8, [&](size_t task, size_t worker) {
+			// make the tasks finish out of order (and well after the calling thread runs out of tasks to take)
+			std::this_thread::sleep_for(std::chrono::milliseconds(2 * (task % 3)));
+			++finished;
+		});
+
+		REQUIRE(finished == 8);
+	}
+
+	SECTION("A pool without threads runs everything inline") {
+		ThreadPool pool(0);
+		std::vector<size_t> order;
+
+		pool.run(4, [&](size_t task, size_t worker) {
+			REQUIRE(worker == 0);
+			order.push_back(task);
+		});
+
+		REQUIRE(order == std::vector<size_t> { 0, 1, 2, 3 });
+	}
+
+	SECTION("Shutting down stops every worker") {
+		// right after starting (when the workers might not even be waiting for work yet)
+		for (size_t i = 0; i < 8; ++i) {
+			ThreadPool pool(4);
+		}
+
+		// and right after a job
+		std::atomic<size_t> finished {0};
+		auto pool = std::make_unique<ThreadPool>(4);
+
+		pool->run(64, [&](size_t task, size_t worker) {
+			++finished;
+		});
+		pool.reset();
+
+		REQUIRE(finished == 64);
+	}
+}
@@ -0,0 +1,151 @@
+#include <blaze/VideoCapture.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+	#include <sys/stat.h>
+#endif
+
+using namespace Blaze;
+
+static std::string temporaryPath(const std::string& name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+};
+
+static std::string readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+};
+
+TEST_CASE("Video capture", "[capture]") {
+	SECTION("The format is picked from the extension") {
+		REQUIRE(VideoCapture::formatForPath("capture.y4m") == VideoCapture::Format::Y4M);
+		REQUIRE(VideoCapture::formatForPath("capture.rgba") == VideoCapture::Format::RawRGBA);
+		REQUIRE(VideoCapture::formatForPath("y4m") == VideoCapture::Format::RawRGBA);
+		REQUIRE(VideoCapture::formatForPath("-") == VideoCapture::Format::RawRGBA);
+	}
+
+	SECTION("Y4M has a stream header and then one planar 4:4:4 frame after another") {
+		auto path = temporaryPath("blaze-test-capture.y4m");
+
+		// white, black, red, and blue
+		std::vector<uint32_t> pixels { 0xffffffff, 0x000000ff, 0xff0000ff, 0x0000ffff };
+
+		{
+			VideoCapture capture(path, VideoCapture::Format::Y4M, 2, 2);
+			capture.submit(pixels.data());
+			capture.submit(pixels.data());
+			capture.finish();
+
+			REQUIRE(capture.framesWritten() == 2);
+			REQUIRE_FALSE(capture.writeFailed());
+		}
+
+		std::string header = "YUV4MPEG2 W2 H2 F60099:1000 Ip A1:1 C444\n";
+		std::string frame = "FRAME\n" + std::string {
+			// Y
+			'\xeb', '\x10', '\x52', '\x29',
+			// U
+			'\x80', '\x80', '\x5a', '\xf0',
+			// V
+			'\x80', '\x80', '\xf0', '\x6e',
+		};
+
+		REQUIRE(readFile(path) == header + frame + frame);
+		std::filesystem::remove(path);
+	}
+
+	SECTION("Raw RGBA is written byte by byte, with recycled buffers keeping every frame intact") {
+		auto path = temporaryPath("blaze-test-capture.rgba");
+		constexpr size_t FRAME_COUNT = 20;
+
+		{
+			// far fewer buffers than frames, so every buffer gets reused several times
+			VideoCapture capture(path, VideoCapture::Format::RawRGBA, 3, 1, 2);
+
+			for (uint32_t i = 0; i < FRAME_COUNT; ++i) {
+				std::vector<uint32_t> pixels { 0x01020300 | i, 0x11121300 | i, 0x21222300 | i };
+				capture.submit(pixels.data());
+			}
+
+			capture.finish();
+			REQUIRE(capture.framesWritten() == FRAME_COUNT);
+		}
+
+		std::string expected;
+		for (uint32_t i = 0; i < FRAME_COUNT; ++i) {
+			expected += std::string { '\x01', '\x02', '\x03', static_cast<char>(i) };
+			expected += std::string { '\x11', '\x12', '\x13', static_cast<char>(i) };
+			expected += std::string { '\x21', '\x22', '\x23', static_cast<char>(i) };
+		}
+
+		REQUIRE(readFile(path) == expected);
+		std::filesystem::remove(path);
+	}
+
+#if !defined(_WIN32)
+	SECTION("Submitting while every buffer is still waiting to be written counts an overflow") {
+		// a FIFO lets the test decide when the writer is allowed to make progress
+		auto path = temporaryPath("blaze-test-capture.fifo");
+		std::filesystem::remove(path);
+		REQUIRE(mkfifo(path.c_str(), 0600) == 0);
+
+		// bigger than a pipe's buffer, so writing a single frame blocks until the reader catches up
+		constexpr size_t WIDTH = 256;
+		constexpr size_t HEIGHT = 256;
+		std::vector<uint32_t> pixels(WIDTH * HEIGHT, 0x12345678);
+
+		VideoCapture* capturePointer = nullptr;
+		std::atomic<bool> started {false};
+		size_t bytesRead = 0;
+
+		// opening either end of a FIFO waits for the other one, so the reader has to be on its own thread
+		std::thread reader([&]() {
+			std::FILE* file = std::fopen(path.c_str(), "rb");
+
+			// don't read anything until the capture has had to wait for a buffer
+			while (!started || capturePointer->overflowCount() == 0) {
+				std::this_thread::yield();
+			}
+
+			std::vector<char> chunk(4096);
+			size_t count = 0;
+			while ((count = std::fread(chunk.data(), 1, chunk.size(), file)) > 0) {
+				bytesRead += count;
+			}
+
+			std::fclose(file);
+		});
+
+		{
+			// a single buffer: the first frame is stuck being written, so the writer can't free up a buffer
+			// for the third one (and maybe not even for the second one) until the reader starts reading
+			VideoCapture capture(path, VideoCapture::Format::RawRGBA, WIDTH, HEIGHT, 1);
+			capturePointer = &capture;
+			started = true;
+
+			for (size_t i = 0; i < 3; ++i) {
+				capture.submit(pixels.data());
+			}
+
+			REQUIRE(capture.overflowCount() >= 1);
+			REQUIRE(capture.overflowCount() <= 2);
+
+			capture.finish();
+			REQUIRE(capture.framesWritten() == 3);
+		}
+
+		reader.join();
+		REQUIRE(bytesRead == 3 * WIDTH * HEIGHT * 4);
+		std::filesystem::remove(path);
+	}
+#endif
+}
@@ -0,0 +1,50 @@
+#include <blaze/WindowMask.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+using namespace Blaze;
+
+TEST_CASE("Window masks", "[window]") {
+	SECTION("Ranges are inclusive and can span words") {
+		auto mask = WindowMask::range(60, 130);
+
+		REQUIRE_FALSE(mask.test(59));
+		REQUIRE(mask.test(60));
+		REQUIRE(mask.test(64));
+		REQUIRE(mask.test(128));
+		REQUIRE(mask.test(130));
+		REQUIRE_FALSE(mask.test(131));
+	}
+
+	SECTION("A left edge past the right edge is an empty window") {
+		REQUIRE_FALSE(WindowMask::range(100, 99).any());
+		REQUIRE(WindowMask::range(0, 255) == ~WindowMask());
+		REQUIRE(WindowMask::range(7, 7).test(7));
+	}
+
+	SECTION("Combining windows") {
+		auto first = WindowMask::range(10, 20);
+		auto second = WindowMask::range(15, 30);
+
+		auto combinedOr = WindowMask::combine(first, second, WindowMask::Logic::OR);
+		auto combinedAnd = WindowMask::combine(first, second, WindowMask::Logic::AND);
+		auto combinedXor = WindowMask::combine(first, second, WindowMask::Logic::XOR);
+		auto combinedXnor = WindowMask::combine(first, second, WindowMask::Logic::XNOR);
+
+		REQUIRE(combinedOr == WindowMask::range(10, 30));
+		REQUIRE(combinedAnd == WindowMask::range(15, 20));
+		REQUIRE(combinedXor == (WindowMask::range(10, 14) | WindowMask::range(21, 30)));
+		REQUIRE(combinedXnor == ~combinedXor);
+	}
+
+	SECTION("Expanding a mask gives one full pixel mask per pixel") {
+		std::array<uint32_t, WindowMask::WIDTH> pixels {};
+		(WindowMask::range(60, 130) | WindowMask::range(255, 255)).expand(pixels.data());
+
+		for (size_t x = 0; x < WindowMask::WIDTH; ++x) {
+			bool inside = (x >= 60 && x <= 130) || x == 255;
+			REQUIRE(pixels[x] == (inside ? 0xffffffff : 0));
+		}
+	}
+}